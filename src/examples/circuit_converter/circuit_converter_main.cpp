@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Converts circuits in the Bristol, Bristol Fashion, or ABY format to the binary circuit format,
+// which can be memory-mapped via MappedCircuit or loaded via CircuitLoader with
+// CircuitFormat::kBinary. By default, all .bristol files in the circuits/ directory are converted
+// and the binary circuits are written next to them.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <fmt/format.h>
+#include <boost/program_options.hpp>
+
+#include "algorithm/algorithm_description.h"
+#include "algorithm/binary_circuit.h"
+#include "utility/config.h"
+
+namespace program_options = boost::program_options;
+
+namespace {
+
+// the third line of a Bristol Fashion file contains the output wire counts, whereas it is empty in
+// the Bristol format
+bool IsBristolFashion(const std::filesystem::path& path) {
+  std::ifstream stream(path);
+  std::string line;
+  for (auto i = 0; i < 3 && std::getline(stream, line); ++i) continue;
+  return line.find_first_not_of(" \t\r") != std::string::npos;
+}
+
+encrypto::motion::AlgorithmDescription Read(const std::filesystem::path& path,
+                                            const std::string& format) {
+  if (format == "bristol-fashion" || (format == "auto" && IsBristolFashion(path))) {
+    return encrypto::motion::AlgorithmDescription::FromBristolFashion(path.string());
+  } else if (format == "bristol" || format == "auto") {
+    return encrypto::motion::AlgorithmDescription::FromBristol(path.string());
+  } else if (format == "aby") {
+    return encrypto::motion::AlgorithmDescription::FromAby(path.string());
+  } else {
+    throw std::invalid_argument(fmt::format("Unknown circuit format {}", format));
+  }
+}
+
+bool Convert(const std::filesystem::path& input, const std::string& format) {
+  auto output{input};
+  output.replace_extension(encrypto::motion::kBinaryCircuitExtension);
+  try {
+    const auto algorithm{Read(input, format)};
+    encrypto::motion::WriteBinaryCircuit(algorithm, output.string());
+    std::cout << fmt::format("{} -> {}\n", input.string(), output.string());
+    return true;
+  } catch (const std::exception& e) {
+    std::cerr << fmt::format("Skipping {}: {}\n", input.string(), e.what());
+    return false;
+  }
+}
+
+}  // namespace
+
+int main(int ac, char* av[]) {
+  std::string input, format;
+  bool help;
+  program_options::options_description description("Allowed options");
+  // clang-format off
+  description.add_options()
+      ("help,h", program_options::bool_switch(&help)->default_value(false), "produce help message")
+      ("input,i", program_options::value<std::string>(&input)->default_value(std::string(encrypto::motion::kRootDir) + "/circuits"), "circuit file or directory, which is searched recursively for .bristol files")
+      ("format", program_options::value<std::string>(&format)->default_value("auto"), "input format: auto, bristol, bristol-fashion, or aby");
+  // clang-format on
+
+  program_options::variables_map user_options;
+  try {
+    program_options::store(program_options::parse_command_line(ac, av, description), user_options);
+    program_options::notify(user_options);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << "\n" << description << "\n";
+    return EXIT_FAILURE;
+  }
+  if (help) {
+    std::cout << description << "\n";
+    return EXIT_SUCCESS;
+  }
+
+  bool success{true};
+  if (std::filesystem::is_directory(input)) {
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(input)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".bristol") {
+        success &= Convert(entry.path(), format);
+      }
+    }
+  } else {
+    success = Convert(input, format);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
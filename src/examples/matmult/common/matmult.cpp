@@ -31,6 +31,20 @@
 #include "statistics/run_time_statistics.h"
 #include "utility/config.h"
 
+// Arithmetic GMW multiplies the matrices with a dedicated gate, which expects each matrix in
+// row-major order in the SIMD values of a single share. Hence, there is one pair of inputs for
+// each of the number_of_simd independent multiplications.
+template <typename T>
+void CreateArithmeticMatrixMultiplications(
+        encrypto::motion::PartyPointer& party, std::size_t number_of_simd, std::size_t dim) {
+    const std::vector<T> temporary_arithmetic(dim*dim);
+    for (std::size_t i=0; i<number_of_simd; i++) {
+        auto m1 = party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0);
+        auto m2 = party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0);
+        m1.MatMul(m2, dim, dim, dim);
+    }
+}
+
 encrypto::motion::RunTimeStatistics EvaluateProtocol(
         encrypto::motion::PartyPointer& party, std::size_t number_of_simd, std::size_t bit_size,
         std::size_t dim, encrypto::motion::MpcProtocol protocol) {
@@ -61,37 +75,21 @@ encrypto::motion::RunTimeStatistics EvaluateProtocol(
         case encrypto::motion::MpcProtocol::kArithmeticGmw: {
             switch (bit_size) {
                 case 8: {
-                    std::vector<std::uint8_t> temporary_arithmetic(number_of_simd);
-                    for (int i=0; i<dim*dim; i++) {
-                        v1.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                        v2.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                    }
+                    CreateArithmeticMatrixMultiplications<std::uint8_t>(party, number_of_simd, dim);
                     break;
                 }
                 case 16: {
-                    std::vector<std::uint16_t> temporary_arithmetic(number_of_simd);
-                    for (int i=0; i<dim*dim; i++) {
-                        v1.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                        v2.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                    }
+                    CreateArithmeticMatrixMultiplications<std::uint16_t>(party, number_of_simd, dim);
                     break;
                 }
                 case 32: {
-                    std::vector<std::uint32_t> temporary_arithmetic(number_of_simd);
-                    for (int i=0; i<dim*dim; i++) {
-                        v1.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                        v2.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                    }
+                    CreateArithmeticMatrixMultiplications<std::uint32_t>(party, number_of_simd, dim);
                     break;
                 }
                 case 64: {
-                    std::vector<std::uint64_t> temporary_arithmetic(number_of_simd);
-                    for (int i=0; i<dim*dim; i++) {
-                        v1.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                        v2.push_back(party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(temporary_arithmetic, 0));
-                    }
+                    CreateArithmeticMatrixMultiplications<std::uint64_t>(party, number_of_simd, dim);
                     break;
-                }   
+                }
                 default:
                     throw std::invalid_argument("Unknown bit size");
             }
@@ -102,7 +100,8 @@ encrypto::motion::RunTimeStatistics EvaluateProtocol(
         }
     }
 
-    for (int i=0; i<dim; i++) {
+    // the arithmetic matrix multiplications were already created above
+    for (int i=0; protocol != encrypto::motion::MpcProtocol::kArithmeticGmw && i<dim; i++) {
         for (int j=0; j<dim; j++) {
             for (int k=0; k<dim; k++) {
                 // tmp <- m1[i][k]*m2[k][j] = v1[i*dim+k]*v2[k*dim+j]
@@ -119,7 +118,7 @@ encrypto::motion::RunTimeStatistics EvaluateProtocol(
                 throw std::invalid_argument("Vector tmp not zero");
         }
     }
-    if (v.size()!=dim*dim) 
+    if (protocol != encrypto::motion::MpcProtocol::kArithmeticGmw && v.size()!=dim*dim) 
         throw std::invalid_argument("Vector v size not correct");
 
     party->Run();
@@ -32,6 +32,8 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "binary_circuit.h"
+
 namespace encrypto::motion {
 
 AlgorithmDescription AlgorithmDescription::FromBristol(const std::string& path) {
@@ -418,4 +420,8 @@ AlgorithmDescription AlgorithmDescription::FromAby(std::ifstream& stream) {
   return algorithm_description;
 }
 
+AlgorithmDescription AlgorithmDescription::FromBinary(const std::string& path) {
+  return MappedCircuit(path).ToAlgorithmDescription();
+}
+
 }  // namespace encrypto::motion
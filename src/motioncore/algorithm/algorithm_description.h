@@ -61,6 +61,10 @@ struct AlgorithmDescription {
 
   static AlgorithmDescription FromAby(std::ifstream& stream);
 
+  /// \brief reads a circuit in the binary circuit format (see binary_circuit.h) via mmap.
+  /// \throws runtime_error if the file cannot be mapped or is not a valid binary circuit.
+  static AlgorithmDescription FromBinary(const std::string& path);
+
   std::size_t number_of_output_wires{0}, number_of_input_wires_parent_a{0}, number_of_wires{0},
       number_of_gates{0};
   std::optional<std::size_t> number_of_input_wires_parent_b{std::nullopt};
@@ -0,0 +1,317 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "binary_circuit.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "algorithm_description.h"
+#include "layered_circuit.h"
+
+namespace encrypto::motion {
+
+static_assert(std::endian::native == std::endian::little,
+              "the binary circuit format is only supported on little-endian platforms");
+
+namespace {
+
+constexpr std::size_t PaddedSize(std::size_t size) { return (size + 7) / 8 * 8; }
+
+bool IsInteractive(PrimitiveOperationType type) {
+  return type == PrimitiveOperationType::kAnd || type == PrimitiveOperationType::kOr;
+}
+
+// Checks that the sections describe a circuit that LayeredCircuit would produce, such that
+// evaluating it never accesses a wire out of range, reads a wire before it is computed, or
+// releases a wire before its last use. Returns the first inconsistency, or an empty view.
+std::string_view FindInconsistency(const BinaryCircuitHeader& header,
+                                   std::span<const BinaryGateRecord> gates,
+                                   std::span<const std::uint64_t> batch_offsets,
+                                   std::span<const std::uint64_t> layer_offsets,
+                                   std::span<const std::uint32_t> last_use) {
+  if (header.number_of_wires >= LayeredCircuit::kPinned) return "too many wires";
+  if (header.has_input_wires_parent_b > 1 ||
+      (!header.has_input_wires_parent_b && header.number_of_input_wires_parent_b != 0)) {
+    return "inconsistent input wires of parent b";
+  }
+  if (header.number_of_input_wires_parent_a > header.number_of_wires ||
+      header.number_of_input_wires_parent_b >
+          header.number_of_wires - header.number_of_input_wires_parent_a ||
+      header.number_of_output_wires > header.number_of_wires) {
+    return "more input or output wires than wires";
+  }
+  const std::uint64_t number_of_input_wires{header.number_of_input_wires_parent_a +
+                                            header.number_of_input_wires_parent_b};
+  if (header.number_of_layers == 0 || header.and_depth != header.number_of_layers - 1) {
+    return "inconsistent AND depth";
+  }
+
+  if (layer_offsets.front() != 0 || layer_offsets.back() != header.number_of_batches ||
+      !std::is_sorted(layer_offsets.begin(), layer_offsets.end())) {
+    return "inconsistent layer offsets";
+  }
+  // batches are never empty
+  if (batch_offsets.front() != 0 || batch_offsets.back() != header.number_of_gates ||
+      std::adjacent_find(batch_offsets.begin(), batch_offsets.end(),
+                         std::greater_equal<>()) != batch_offsets.end()) {
+    return "inconsistent batch offsets";
+  }
+
+  // the input wires are ready before the first batch and the output wire of a gate in batch i
+  // before batch i + 1
+  constexpr std::uint64_t kNotReady{std::numeric_limits<std::uint64_t>::max()};
+  std::vector<std::uint64_t> ready_batch(header.number_of_wires, kNotReady);
+  std::fill_n(ready_batch.begin(), number_of_input_wires, 0);
+  std::vector<std::uint64_t> last_read(header.number_of_wires, 0);
+  std::uint64_t number_of_and_gates{0};
+  for (std::uint64_t batch_i = 0; batch_i < header.number_of_batches; ++batch_i) {
+    const auto begin{batch_offsets[batch_i]}, end{batch_offsets[batch_i + 1]};
+    const auto batch_type{static_cast<PrimitiveOperationType>(gates[begin].type)};
+    for (auto gate_i = begin; gate_i < end; ++gate_i) {
+      const auto& gate{gates[gate_i]};
+      const auto type{static_cast<PrimitiveOperationType>(gate.type)};
+      switch (type) {
+        case PrimitiveOperationType::kXor:
+        case PrimitiveOperationType::kAnd:
+        case PrimitiveOperationType::kOr:
+        case PrimitiveOperationType::kInv:
+          break;
+        default:
+          return "unsupported gate type";
+      }
+      if (IsInteractive(type) ? !IsInteractive(batch_type) : type != batch_type) {
+        return "mixed gate types in a batch";
+      }
+      if (type == PrimitiveOperationType::kInv && gate.parent_b != gate.parent_a) {
+        return "INV gate with two parents";
+      }
+      if (gate.parent_a >= header.number_of_wires || gate.parent_b >= header.number_of_wires ||
+          gate.output_wire >= header.number_of_wires) {
+        return "wire id out of range";
+      }
+      if (ready_batch[gate.parent_a] > batch_i || ready_batch[gate.parent_b] > batch_i) {
+        return "gate reads a wire before it is computed";
+      }
+      last_read[gate.parent_a] = last_read[gate.parent_b] = batch_i;
+      if (IsInteractive(type)) ++number_of_and_gates;
+    }
+    for (auto gate_i = begin; gate_i < end; ++gate_i) {
+      auto& ready{ready_batch[gates[gate_i].output_wire]};
+      if (ready != kNotReady) return "wire is written twice";
+      ready = batch_i + 1;
+    }
+  }
+  if (number_of_and_gates != header.number_of_and_gates) return "inconsistent number of AND gates";
+
+  const auto first_output_wire{header.number_of_wires - header.number_of_output_wires};
+  for (std::uint64_t wire_i = 0; wire_i < header.number_of_wires; ++wire_i) {
+    if (last_use[wire_i] == LayeredCircuit::kPinned) continue;
+    if (wire_i >= first_output_wire) return "output wire is not pinned";
+    if (last_use[wire_i] >= header.number_of_batches || last_use[wire_i] < last_read[wire_i]) {
+      return "wire is released before its last use";
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+void WriteBinaryCircuit(const AlgorithmDescription& algorithm, const std::string& path) {
+  const auto circuit{LayeredCircuit::FromAlgorithmDescription(algorithm)};
+
+  BinaryCircuitHeader header;
+  header.magic = kBinaryCircuitMagic;
+  header.version = kBinaryCircuitVersion;
+  header.has_input_wires_parent_b = algorithm.number_of_input_wires_parent_b.has_value();
+  header.number_of_input_wires_parent_a = algorithm.number_of_input_wires_parent_a;
+  header.number_of_input_wires_parent_b = algorithm.number_of_input_wires_parent_b.value_or(0);
+  header.number_of_output_wires = circuit.number_of_output_wires;
+  header.number_of_wires = circuit.number_of_wires;
+  header.number_of_gates = circuit.number_of_gates;
+  header.number_of_and_gates = circuit.number_of_and_gates;
+  header.and_depth = circuit.and_depth;
+  header.number_of_batches = circuit.GetNumberOfBatches();
+  header.number_of_layers = circuit.GetNumberOfLayers();
+
+  std::vector<BinaryGateRecord> gates(circuit.number_of_gates);
+  for (std::size_t i = 0; i < gates.size(); ++i) {
+    gates[i].parent_a = circuit.parents_a[i];
+    gates[i].parent_b = circuit.parents_b[i];
+    gates[i].output_wire = circuit.output_wires[i];
+    gates[i].type = static_cast<std::uint8_t>(circuit.types[i]);
+    gates[i].padding = {0, 0, 0};
+  }
+  const std::vector<std::uint64_t> batch_offsets(circuit.batch_offsets.begin(),
+                                                 circuit.batch_offsets.end());
+  const std::vector<std::uint64_t> layer_offsets(circuit.layer_offsets.begin(),
+                                                 circuit.layer_offsets.end());
+  const std::size_t last_use_size{circuit.last_use.size() * sizeof(std::uint32_t)};
+  const std::array<char, 8> padding{};
+
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  if (!stream.is_open()) {
+    throw std::runtime_error(fmt::format("Could not open {} for writing", path));
+  }
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  stream.write(reinterpret_cast<const char*>(gates.data()),
+               gates.size() * sizeof(BinaryGateRecord));
+  stream.write(reinterpret_cast<const char*>(batch_offsets.data()),
+               batch_offsets.size() * sizeof(std::uint64_t));
+  stream.write(reinterpret_cast<const char*>(layer_offsets.data()),
+               layer_offsets.size() * sizeof(std::uint64_t));
+  stream.write(reinterpret_cast<const char*>(circuit.last_use.data()), last_use_size);
+  stream.write(padding.data(), PaddedSize(last_use_size) - last_use_size);
+  if (!stream.good()) {
+    throw std::runtime_error(fmt::format("Could not write binary circuit to {}", path));
+  }
+}
+
+MappedCircuit::MappedCircuit(const std::string& path) {
+  const int file_descriptor{::open(path.c_str(), O_RDONLY)};
+  if (file_descriptor < 0) {
+    throw std::runtime_error(fmt::format("Could not open circuit file {}", path));
+  }
+  struct stat file_status;
+  if (::fstat(file_descriptor, &file_status) != 0 ||
+      static_cast<std::size_t>(file_status.st_size) < sizeof(BinaryCircuitHeader)) {
+    ::close(file_descriptor);
+    throw std::runtime_error(fmt::format("{} is not a binary circuit file", path));
+  }
+  size_ = file_status.st_size;
+  data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  ::close(file_descriptor);
+  if (data_ == MAP_FAILED) {
+    data_ = nullptr;
+    throw std::runtime_error(fmt::format("Could not map circuit file {}", path));
+  }
+
+  const auto* bytes{static_cast<const std::uint8_t*>(data_)};
+  header_ = reinterpret_cast<const BinaryCircuitHeader*>(bytes);
+  const auto& header{*header_};
+  const auto invalid = [this, &path](std::string_view reason) {
+    ::munmap(data_, size_);
+    data_ = nullptr;
+    return std::runtime_error(fmt::format("Invalid binary circuit file {}: {}", path, reason));
+  };
+  if (header.magic != kBinaryCircuitMagic) throw invalid("wrong magic number");
+  if (header.version != kBinaryCircuitVersion) {
+    throw invalid(fmt::format("unsupported version {}", header.version));
+  }
+  // bound all counts by the file size before computing the section sizes to prevent overflows
+  if (header.number_of_gates > size_ || header.number_of_batches >= size_ ||
+      header.number_of_layers >= size_ || header.number_of_wires > size_) {
+    throw invalid("inconsistent header");
+  }
+  const std::size_t gates_size{header.number_of_gates * sizeof(BinaryGateRecord)};
+  const std::size_t batch_offsets_size{(header.number_of_batches + 1) * sizeof(std::uint64_t)};
+  const std::size_t layer_offsets_size{(header.number_of_layers + 1) * sizeof(std::uint64_t)};
+  const std::size_t last_use_size{header.number_of_wires * sizeof(std::uint32_t)};
+  if (size_ != sizeof(BinaryCircuitHeader) + gates_size + batch_offsets_size + layer_offsets_size +
+                   PaddedSize(last_use_size)) {
+    throw invalid("file size does not match the header");
+  }
+
+  bytes += sizeof(BinaryCircuitHeader);
+  gates_ = {reinterpret_cast<const BinaryGateRecord*>(bytes), header.number_of_gates};
+  bytes += gates_size;
+  batch_offsets_ = {reinterpret_cast<const std::uint64_t*>(bytes), header.number_of_batches + 1};
+  bytes += batch_offsets_size;
+  layer_offsets_ = {reinterpret_cast<const std::uint64_t*>(bytes), header.number_of_layers + 1};
+  bytes += layer_offsets_size;
+  last_use_ = {reinterpret_cast<const std::uint32_t*>(bytes), header.number_of_wires};
+
+  if (const auto reason{
+          FindInconsistency(header, gates_, batch_offsets_, layer_offsets_, last_use_)};
+      !reason.empty()) {
+    throw invalid(reason);
+  }
+}
+
+MappedCircuit::~MappedCircuit() {
+  if (data_) ::munmap(data_, size_);
+}
+
+LayeredCircuit MappedCircuit::ToLayeredCircuit() const {
+  LayeredCircuit circuit;
+  circuit.number_of_input_wires =
+      header_->number_of_input_wires_parent_a + header_->number_of_input_wires_parent_b;
+  circuit.number_of_output_wires = header_->number_of_output_wires;
+  circuit.number_of_wires = header_->number_of_wires;
+  circuit.number_of_gates = header_->number_of_gates;
+  circuit.number_of_and_gates = header_->number_of_and_gates;
+  circuit.and_depth = header_->and_depth;
+
+  circuit.types.reserve(gates_.size());
+  circuit.parents_a.reserve(gates_.size());
+  circuit.parents_b.reserve(gates_.size());
+  circuit.output_wires.reserve(gates_.size());
+  for (const auto& gate : gates_) {
+    circuit.types.emplace_back(static_cast<PrimitiveOperationType>(gate.type));
+    circuit.parents_a.emplace_back(gate.parent_a);
+    circuit.parents_b.emplace_back(gate.parent_b);
+    circuit.output_wires.emplace_back(gate.output_wire);
+  }
+  circuit.batch_offsets.assign(batch_offsets_.begin(), batch_offsets_.end());
+  circuit.layer_offsets.assign(layer_offsets_.begin(), layer_offsets_.end());
+  circuit.last_use.assign(last_use_.begin(), last_use_.end());
+  return circuit;
+}
+
+AlgorithmDescription MappedCircuit::ToAlgorithmDescription() const {
+  AlgorithmDescription algorithm_description;
+  algorithm_description.number_of_input_wires_parent_a = header_->number_of_input_wires_parent_a;
+  if (header_->has_input_wires_parent_b) {
+    algorithm_description.number_of_input_wires_parent_b = header_->number_of_input_wires_parent_b;
+  }
+  algorithm_description.number_of_output_wires = header_->number_of_output_wires;
+  algorithm_description.number_of_wires = header_->number_of_wires;
+  algorithm_description.number_of_gates = header_->number_of_gates;
+
+  algorithm_description.gates.reserve(gates_.size());
+  for (const auto& gate : gates_) {
+    PrimitiveOperation operation;
+    operation.type = static_cast<PrimitiveOperationType>(gate.type);
+    operation.parent_a = gate.parent_a;
+    if (operation.type != PrimitiveOperationType::kInv) operation.parent_b = gate.parent_b;
+    operation.output_wire = gate.output_wire;
+    algorithm_description.gates.emplace_back(operation);
+  }
+  return algorithm_description;
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace encrypto::motion {
+
+struct AlgorithmDescription;
+struct LayeredCircuit;
+
+// Binary circuit format, all values are little-endian and all sections are 8-byte aligned:
+// BinaryCircuitHeader
+// BinaryGateRecord[number_of_gates]         *** gates in the evaluation order of LayeredCircuit
+// std::uint64_t[number_of_batches + 1]      *** batch offsets
+// std::uint64_t[number_of_layers + 1]       *** layer offsets
+// std::uint32_t[number_of_wires]            *** last use of each wire
+// std::uint32_t padding to 8 bytes
+
+constexpr std::array<char, 8> kBinaryCircuitMagic{'M', 'O', 'T', 'I', 'O', 'N', 'B', 'C'};
+constexpr std::uint32_t kBinaryCircuitVersion{1};
+constexpr std::string_view kBinaryCircuitExtension{".mbc"};
+
+struct BinaryCircuitHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t has_input_wires_parent_b;
+  std::uint64_t number_of_input_wires_parent_a;
+  std::uint64_t number_of_input_wires_parent_b;
+  std::uint64_t number_of_output_wires;
+  std::uint64_t number_of_wires;
+  std::uint64_t number_of_gates;
+  std::uint64_t number_of_and_gates;
+  std::uint64_t and_depth;
+  std::uint64_t number_of_batches;
+  std::uint64_t number_of_layers;
+};
+
+static_assert(sizeof(BinaryCircuitHeader) == 88);
+
+struct BinaryGateRecord {
+  std::uint32_t parent_a;
+  std::uint32_t parent_b;  // equals parent_a for INV gates
+  std::uint32_t output_wire;
+  std::uint8_t type;  // PrimitiveOperationType
+  std::array<std::uint8_t, 3> padding;
+};
+
+static_assert(sizeof(BinaryGateRecord) == 16);
+
+/// \brief serializes algorithm in the binary circuit format to the file at path.
+/// \throws runtime_error if the file cannot be written.
+/// \throws invalid_argument if algorithm cannot be converted to a LayeredCircuit.
+void WriteBinaryCircuit(const AlgorithmDescription& algorithm, const std::string& path);
+
+/// \brief Read-only view of a circuit file in the binary circuit format, which is memory-mapped.
+/// The sections are accessed as spans into the mapping without copying or parsing.
+class MappedCircuit {
+ public:
+  /// \brief maps the file at path into memory and validates all of its sections, such that
+  /// evaluating the circuit never accesses a wire out of range or before it is computed.
+  /// \throws runtime_error if the file cannot be mapped or is not a valid binary circuit.
+  explicit MappedCircuit(const std::string& path);
+
+  ~MappedCircuit();
+
+  MappedCircuit(const MappedCircuit&) = delete;
+
+  MappedCircuit& operator=(const MappedCircuit&) = delete;
+
+  const BinaryCircuitHeader& GetHeader() const { return *header_; }
+
+  std::span<const BinaryGateRecord> GetGates() const { return gates_; }
+
+  std::span<const std::uint64_t> GetBatchOffsets() const { return batch_offsets_; }
+
+  std::span<const std::uint64_t> GetLayerOffsets() const { return layer_offsets_; }
+
+  std::span<const std::uint32_t> GetLastUse() const { return last_use_; }
+
+  /// \brief copies the sections into a LayeredCircuit, which does not depend on the mapping.
+  LayeredCircuit ToLayeredCircuit() const;
+
+  /// \brief copies the gates into an AlgorithmDescription, which does not depend on the mapping.
+  AlgorithmDescription ToAlgorithmDescription() const;
+
+ private:
+  void* data_{nullptr};
+  std::size_t size_{0};
+
+  const BinaryCircuitHeader* header_{nullptr};
+  std::span<const BinaryGateRecord> gates_;
+  std::span<const std::uint64_t> batch_offsets_;
+  std::span<const std::uint64_t> layer_offsets_;
+  std::span<const std::uint32_t> last_use_;
+};
+
+}  // namespace encrypto::motion
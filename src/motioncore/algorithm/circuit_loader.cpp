@@ -0,0 +1,132 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "circuit_loader.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "algorithm_description.h"
+#include "binary_circuit.h"
+#include "layered_circuit.h"
+
+namespace encrypto::motion {
+
+CircuitLoader& CircuitLoader::GetInstance() {
+  static CircuitLoader circuit_loader;
+  return circuit_loader;
+}
+
+std::shared_ptr<const AlgorithmDescription> CircuitLoader::GetAlgorithmDescription(
+    const std::string& path, CircuitFormat format) {
+  std::scoped_lock lock(mutex_);
+  return LoadAlgorithmDescription({path, format}).algorithm_description;
+}
+
+std::shared_ptr<const LayeredCircuit> CircuitLoader::GetLayeredCircuit(const std::string& path,
+                                                                       CircuitFormat format) {
+  std::scoped_lock lock(mutex_);
+  const Key key{path, format};
+  if (format == CircuitFormat::kBinary) {
+    // binary circuits are already layered, so they are copied out of the mapping instead of
+    // being parsed and layered
+    auto& entry{circuits_[key]};
+    if (!entry.layered_circuit) {
+      try {
+        entry.layered_circuit =
+            std::make_shared<const LayeredCircuit>(MappedCircuit(path).ToLayeredCircuit());
+      } catch (...) {
+        if (!entry.algorithm_description) circuits_.erase(key);
+        throw;
+      }
+    }
+    return entry.layered_circuit;
+  }
+  auto& entry{LoadAlgorithmDescription(key)};
+  if (!entry.layered_circuit) {
+    entry.layered_circuit = std::make_shared<const LayeredCircuit>(
+        LayeredCircuit::FromAlgorithmDescription(*entry.algorithm_description));
+  }
+  return entry.layered_circuit;
+}
+
+std::size_t CircuitLoader::GetNumberOfCachedCircuits() {
+  std::scoped_lock lock(mutex_);
+  return circuits_.size();
+}
+
+void CircuitLoader::Clear() {
+  std::scoped_lock lock(mutex_);
+  circuits_.clear();
+}
+
+CircuitLoader::Entry& CircuitLoader::LoadAlgorithmDescription(const Key& key) {
+  const auto& [path, format]{key};
+  auto& entry{circuits_[key]};
+  if (entry.algorithm_description) return entry;
+
+  if (format == CircuitFormat::kBinary) {
+    try {
+      entry.algorithm_description =
+          std::make_shared<const AlgorithmDescription>(AlgorithmDescription::FromBinary(path));
+    } catch (...) {
+      if (!entry.layered_circuit) circuits_.erase(key);
+      throw;
+    }
+    return entry;
+  }
+
+  std::ifstream stream(path);
+  if (!stream.is_open()) {
+    circuits_.erase(key);
+    throw std::runtime_error(fmt::format("Could not open circuit file {}", path));
+  }
+  switch (format) {
+    case CircuitFormat::kBristol: {
+      entry.algorithm_description =
+          std::make_shared<const AlgorithmDescription>(AlgorithmDescription::FromBristol(stream));
+      break;
+    }
+    case CircuitFormat::kBristolFashion: {
+      entry.algorithm_description = std::make_shared<const AlgorithmDescription>(
+          AlgorithmDescription::FromBristolFashion(stream));
+      break;
+    }
+    case CircuitFormat::kAby: {
+      entry.algorithm_description =
+          std::make_shared<const AlgorithmDescription>(AlgorithmDescription::FromAby(stream));
+      break;
+    }
+    default: {
+      circuits_.erase(key);
+      throw std::invalid_argument(
+          fmt::format("Invalid CircuitFormat with id {}", static_cast<unsigned>(format)));
+    }
+  }
+  return entry;
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace encrypto::motion {
+
+struct AlgorithmDescription;
+struct LayeredCircuit;
+
+enum class CircuitFormat : unsigned int { kBristol, kBristolFashion, kAby, kBinary, kInvalid };
+
+/// \brief Process-wide repository of circuits read from files. Each circuit is parsed and
+/// preprocessed into a LayeredCircuit at most once per process and format. The circuits are
+/// handed out as shared immutable handles, which can be used concurrently by all Backends and
+/// Registers.
+class CircuitLoader {
+ public:
+  CircuitLoader(const CircuitLoader&) = delete;
+
+  CircuitLoader& operator=(const CircuitLoader&) = delete;
+
+  static CircuitLoader& GetInstance();
+
+  /// \brief gets the AlgorithmDescription for the circuit file at path and parses it on the first
+  /// call.
+  /// \throws runtime_error if the file cannot be opened.
+  /// \throws invalid_argument if format is invalid.
+  std::shared_ptr<const AlgorithmDescription> GetAlgorithmDescription(
+      const std::string& path, CircuitFormat format = CircuitFormat::kBristol);
+
+  /// \brief gets the LayeredCircuit for the circuit file at path and parses and preprocesses it on
+  /// the first call.
+  /// \throws runtime_error if the file cannot be opened.
+  /// \throws invalid_argument if format is invalid or the circuit cannot be layered.
+  std::shared_ptr<const LayeredCircuit> GetLayeredCircuit(
+      const std::string& path, CircuitFormat format = CircuitFormat::kBristol);
+
+  std::size_t GetNumberOfCachedCircuits();
+
+  /// \brief removes all circuits from the repository. Handles that were handed out stay valid.
+  void Clear();
+
+ private:
+  CircuitLoader() = default;
+
+  struct Entry {
+    std::shared_ptr<const AlgorithmDescription> algorithm_description;
+    std::shared_ptr<const LayeredCircuit> layered_circuit;
+  };
+
+  // the same file may be read in different formats, e.g., kBristol and kBristolFashion
+  using Key = std::pair<std::string, CircuitFormat>;
+
+  // requires mutex_ to be locked
+  Entry& LoadAlgorithmDescription(const Key& key);
+
+  std::mutex mutex_;
+  std::map<Key, Entry> circuits_;
+};
+
+}  // namespace encrypto::motion
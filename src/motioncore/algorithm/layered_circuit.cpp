@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "layered_circuit.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "algorithm_description.h"
+
+namespace encrypto::motion {
+
+LayeredCircuit LayeredCircuit::FromAlgorithmDescription(const AlgorithmDescription& algorithm) {
+  if (algorithm.number_of_wires >= kPinned) {
+    throw std::invalid_argument(
+        fmt::format("Circuit with {} wires is too large", algorithm.number_of_wires));
+  }
+
+  // A layer consists of the interactive gates (AND, OR) of one AND depth followed by the
+  // non-interactive gates (XOR, INV) that depend on them. The latter are further split into
+  // sublayers by their depth within the layer, such that each sublayer only depends on the
+  // previous ones.
+  struct Sublayer {
+    std::vector<std::size_t> xor_gates, inv_gates;
+  };
+  struct Layer {
+    std::vector<std::size_t> and_gates, or_gates;
+    std::vector<Sublayer> sublayers;
+  };
+
+  std::vector<std::size_t> and_depth(algorithm.number_of_wires, 0);
+  std::vector<std::size_t> sublayer_depth(algorithm.number_of_wires, 0);
+  std::vector<Layer> layers(1);
+
+  LayeredCircuit circuit;
+  circuit.number_of_input_wires = algorithm.number_of_input_wires_parent_a;
+  if (algorithm.number_of_input_wires_parent_b) {
+    circuit.number_of_input_wires += *algorithm.number_of_input_wires_parent_b;
+  }
+  circuit.number_of_output_wires = algorithm.number_of_output_wires;
+  circuit.number_of_wires = algorithm.number_of_wires;
+  circuit.number_of_gates = algorithm.gates.size();
+
+  for (std::size_t gate_i = 0; gate_i < algorithm.gates.size(); ++gate_i) {
+    const auto& gate = algorithm.gates[gate_i];
+    const std::size_t parent_b = gate.parent_b ? *gate.parent_b : gate.parent_a;
+    const std::size_t depth = std::max(and_depth.at(gate.parent_a), and_depth.at(parent_b));
+    switch (gate.type) {
+      case PrimitiveOperationType::kAnd:
+      case PrimitiveOperationType::kOr: {
+        assert(gate.parent_b);
+        and_depth.at(gate.output_wire) = depth + 1;
+        if (layers.size() < depth + 2) layers.resize(depth + 2);
+        auto& layer{layers[depth + 1]};
+        if (gate.type == PrimitiveOperationType::kAnd) {
+          layer.and_gates.emplace_back(gate_i);
+        } else {
+          layer.or_gates.emplace_back(gate_i);
+        }
+        break;
+      }
+      case PrimitiveOperationType::kXor:
+      case PrimitiveOperationType::kInv: {
+        assert(gate.type == PrimitiveOperationType::kInv || gate.parent_b);
+        std::size_t sublayer{0};
+        if (and_depth[gate.parent_a] == depth) sublayer = sublayer_depth[gate.parent_a];
+        if (and_depth[parent_b] == depth) sublayer = std::max(sublayer, sublayer_depth[parent_b]);
+        and_depth.at(gate.output_wire) = depth;
+        sublayer_depth.at(gate.output_wire) = sublayer + 1;
+        auto& sublayers{layers[depth].sublayers};
+        if (sublayers.size() < sublayer + 1) sublayers.resize(sublayer + 1);
+        if (gate.type == PrimitiveOperationType::kXor) {
+          sublayers[sublayer].xor_gates.emplace_back(gate_i);
+        } else {
+          sublayers[sublayer].inv_gates.emplace_back(gate_i);
+        }
+        break;
+      }
+      default:
+        throw std::invalid_argument(
+            fmt::format("Unsupported PrimitiveOperationType {} in layered circuit",
+                        to_string(gate.type)));
+    }
+  }
+
+  circuit.types.reserve(circuit.number_of_gates);
+  circuit.parents_a.reserve(circuit.number_of_gates);
+  circuit.parents_b.reserve(circuit.number_of_gates);
+  circuit.output_wires.reserve(circuit.number_of_gates);
+
+  const auto append_batch = [&algorithm, &circuit](const std::vector<std::size_t>& first,
+                                                   const std::vector<std::size_t>& second = {}) {
+    if (first.empty() && second.empty()) return;
+    circuit.batch_offsets.emplace_back(circuit.types.size());
+    for (const auto& gates : {std::cref(first), std::cref(second)}) {
+      for (const auto gate_i : gates.get()) {
+        const auto& gate = algorithm.gates[gate_i];
+        circuit.types.emplace_back(gate.type);
+        circuit.parents_a.emplace_back(gate.parent_a);
+        circuit.parents_b.emplace_back(gate.parent_b ? *gate.parent_b : gate.parent_a);
+        circuit.output_wires.emplace_back(gate.output_wire);
+      }
+    }
+  };
+
+  for (const auto& layer : layers) {
+    circuit.layer_offsets.emplace_back(circuit.batch_offsets.size());
+    append_batch(layer.and_gates, layer.or_gates);
+    circuit.number_of_and_gates += layer.and_gates.size() + layer.or_gates.size();
+    for (const auto& sublayer : layer.sublayers) {
+      append_batch(sublayer.xor_gates);
+      append_batch(sublayer.inv_gates);
+    }
+  }
+  circuit.layer_offsets.emplace_back(circuit.batch_offsets.size());
+  circuit.batch_offsets.emplace_back(circuit.types.size());
+  circuit.and_depth = layers.size() - 1;
+
+  circuit.last_use.resize(circuit.number_of_wires, kPinned);
+  for (std::uint32_t batch_i = 0; batch_i < circuit.GetNumberOfBatches(); ++batch_i) {
+    for (auto gate_i = circuit.batch_offsets[batch_i]; gate_i < circuit.batch_offsets[batch_i + 1];
+         ++gate_i) {
+      circuit.last_use[circuit.parents_a[gate_i]] = batch_i;
+      circuit.last_use[circuit.parents_b[gate_i]] = batch_i;
+    }
+  }
+  std::fill(circuit.last_use.end() - circuit.number_of_output_wires, circuit.last_use.end(),
+            kPinned);
+
+  return circuit;
+}
+
+}  // namespace encrypto::motion
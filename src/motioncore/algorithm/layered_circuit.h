@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "utility/typedefs.h"
+
+namespace encrypto::motion {
+
+struct AlgorithmDescription;
+
+/// \brief Preprocessed representation of an AlgorithmDescription for the layer-batched circuit
+/// evaluation in ShareWrapper::Evaluate. The gates are stored in structure-of-arrays form and
+/// sorted into batches, such that each batch can be evaluated as one multi-wire gate:
+/// each layer starts with a batch of all interactive gates (AND, OR) of one AND depth, which is
+/// followed by alternating batches of XOR and INV gates depending on them. Inside of an interactive
+/// batch, all AND gates precede all OR gates.
+struct LayeredCircuit {
+  static constexpr std::uint32_t kPinned{std::numeric_limits<std::uint32_t>::max()};
+
+  /// \brief sorts the gates of algorithm into layers and batches.
+  /// \pre the gates in algorithm are in topological order, which holds for all supported formats.
+  /// \throws invalid_argument if algorithm contains gates other than XOR, AND, OR, and INV or is
+  /// too large for 32-bit wire ids.
+  static LayeredCircuit FromAlgorithmDescription(const AlgorithmDescription& algorithm);
+
+  std::size_t GetNumberOfBatches() const { return batch_offsets.size() - 1; }
+
+  std::size_t GetNumberOfLayers() const { return layer_offsets.size() - 1; }
+
+  /// \brief checks whether batch #i consists of AND and OR gates.
+  bool IsInteractiveBatch(std::size_t i) const {
+    const auto type{types[batch_offsets[i]]};
+    return type == PrimitiveOperationType::kAnd || type == PrimitiveOperationType::kOr;
+  }
+
+  std::size_t number_of_input_wires{0}, number_of_output_wires{0}, number_of_wires{0},
+      number_of_gates{0}, number_of_and_gates{0}, and_depth{0};
+
+  // gates in evaluation order, parent_b equals parent_a for INV gates
+  std::vector<PrimitiveOperationType> types;
+  std::vector<std::uint32_t> parents_a, parents_b, output_wires;
+
+  // batch i consists of the gates [batch_offsets[i], batch_offsets[i + 1])
+  std::vector<std::size_t> batch_offsets;
+  // layer i consists of the batches [layer_offsets[i], layer_offsets[i + 1]), where layer 0
+  // contains only non-interactive gates operating on the input wires
+  std::vector<std::size_t> layer_offsets;
+
+  // index of the last batch reading from a wire, kPinned for output wires and unread wires
+  std::vector<std::uint32_t> last_use;
+};
+
+}  // namespace encrypto::motion
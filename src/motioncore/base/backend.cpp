@@ -25,21 +25,27 @@
 #include "backend.h"
 #include "motion_base_provider.h"
 
+#include <algorithm>
 #include <boost/log/trivial.hpp>
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <future>
 #include <iterator>
+#include <stdexcept>
 
 #include <fmt/format.h>
 #include <boost/asio/thread_pool.hpp>
 
 #include "communication/communication_layer.h"
 #include "communication/message.h"
+#include "communication/message_handler.h"
 #include "configuration.h"
 #include "data_storage/base_ot_data.h"
 #include "executor/gate_executor.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/preprocessing_service.h"
+#include "multiplication_triple/preprocessing_store.h"
 #include "multiplication_triple/sb_provider.h"
 #include "multiplication_triple/sp_provider.h"
 #include "oblivious_transfer/base_ots/base_ot_provider.h"
@@ -52,11 +58,19 @@
 #include "register.h"
 #include "statistics/run_time_statistics.h"
 #include "utility/constants.h"
+#include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
+#include "utility/helpers.h"
 
 using namespace std::chrono_literals;
 
 namespace encrypto::motion {
 
+namespace {
+
+constexpr std::size_t kNumberOfMaterials{static_cast<std::size_t>(PreprocessingMaterial::kInvalid)};
+
+}  // namespace
+
 Backend::Backend(communication::CommunicationLayer& communication_layer,
                  ConfigurationPointer& configuration, std::shared_ptr<Logger> logger)
     : run_time_statistics_(1),
@@ -65,7 +79,8 @@ Backend::Backend(communication::CommunicationLayer& communication_layer,
       configuration_(configuration),
       register_(std::make_shared<Register>(logger_)),
       gate_executor_(std::make_unique<GateExecutor>(
-          *register_, [this] { RunPreprocessing(); }, logger_)) {
+          *register_, [this] { RunPreprocessing(); },
+          [this]() -> FiberThreadPool& { return GetFiberThreadPool(); }, logger_)) {
   motion_base_provider_ = std::make_unique<BaseProvider>(communication_layer_, logger_);
   base_ot_provider_ = std::make_unique<BaseOtProvider>(communication_layer, logger_);
 
@@ -82,10 +97,21 @@ Backend::Backend(communication::CommunicationLayer& communication_layer,
   sb_provider_ = std::make_shared<SbProviderFromSps>(communication_layer_, sp_provider_, *logger_,
                                                      run_time_statistics_.back());
   bmr_provider_ = std::make_unique<proto::bmr::Provider>(communication_layer_);
+
+  preprocessing_store_state_handlers_.resize(communication_layer_.GetNumberOfParties());
+  for (auto& handler : preprocessing_store_state_handlers_) {
+    handler = std::make_shared<communication::QueueHandler>();
+  }
+  communication_layer_.RegisterMessageHandler(
+      [this](std::size_t party_id) { return preprocessing_store_state_handlers_.at(party_id); },
+      {communication::MessageType::kPreprocessingStoreState});
   communication_layer_.Start();
 }
 
-Backend::~Backend() = default;
+Backend::~Backend() {
+  communication_layer_.DeregisterMessageHandler(
+      {communication::MessageType::kPreprocessingStoreState});
+}
 
 const LoggerPointer& Backend::GetLogger() const noexcept { return logger_; }
 
@@ -139,6 +165,19 @@ void Backend::RunPreprocessing() {
     sp_provider_->PreSetup();
   }
 
+  // the store providers only hand out records in Setup, and after PreSetup, the services of all
+  // parties finished the generation jobs that assigned the generation IDs
+  if (preprocessing_store_ && (needs_mts || needs_sbs || needs_sps)) {
+    // no record is handed out unless all parties continue at the same position of the same files
+    std::vector<std::uint64_t> states;
+    for (std::size_t i = 0; i < kNumberOfMaterials; ++i) {
+      const auto state{preprocessing_store_->GetState(static_cast<PreprocessingMaterial>(i))};
+      states.push_back(state.generation_id);
+      states.push_back(state.number_of_consumed_records);
+    }
+    CheckPreprocessingStoreStates(states, ExchangePreprocessingStoreStates(states));
+  }
+
   if (NeedOts()) {
     OtExtensionSetup();
   }
@@ -153,10 +192,16 @@ void Backend::RunPreprocessing() {
 }
 
 void Backend::EvaluateSequential() {
+  gate_executor_->SetReclaimWireStorage(configuration_->GetReclaimWireStorage());
+  gate_executor_->SetProfiling(configuration_->GetProfiling());
   gate_executor_->EvaluateSetupOnline(run_time_statistics_.back());
 }
 
-void Backend::EvaluateParallel() { gate_executor_->Evaluate(run_time_statistics_.back()); }
+void Backend::EvaluateParallel() {
+  gate_executor_->SetReclaimWireStorage(configuration_->GetReclaimWireStorage());
+  gate_executor_->SetProfiling(configuration_->GetProfiling());
+  gate_executor_->Evaluate(run_time_statistics_.back());
+}
 
 const GatePointer& Backend::GetGate(std::size_t gate_id) const {
   return register_->GetGate(gate_id);
@@ -166,7 +211,22 @@ const std::vector<GatePointer>& Backend::GetInputGates() const {
   return register_->GetInputGates();
 }
 
-void Backend::Reset() { register_->Reset(); }
+FiberThreadPool& Backend::GetFiberThreadPool() {
+  if (!fiber_thread_pool_) {
+    fiber_thread_pool_ = std::make_unique<FiberThreadPool>(
+        configuration_->GetNumberOfFiberPoolWorkers(), 0, true,
+        configuration_->GetFiberPoolCpuAffinity());
+  }
+  return *fiber_thread_pool_;
+}
+
+void Backend::Reset() {
+  register_->Reset();
+  // the providers hand out the material of a single circuit
+  if (preprocessing_store_) {
+    SetStoreProviders(preprocessing_store_, preprocessing_service_);
+  }
+}
 
 void Backend::Clear() { register_->Clear(); }
 
@@ -183,7 +243,8 @@ SharePointer Backend::BooleanGmwInput(std::size_t party_id, BitVector<>&& input)
 }
 
 SharePointer Backend::BooleanGmwInput(std::size_t party_id, const std::vector<BitVector<>>& input) {
-  const auto input_gate = std::make_shared<proto::boolean_gmw::InputGate>(input, party_id, *this);
+  const auto input_gate =
+      register_->MakeShared<proto::boolean_gmw::InputGate>(input, party_id, *this);
   const auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
   RegisterInputGate(input_gate_cast);
   return std::static_pointer_cast<Share>(input_gate->GetOutputAsGmwShare());
@@ -191,7 +252,7 @@ SharePointer Backend::BooleanGmwInput(std::size_t party_id, const std::vector<Bi
 
 SharePointer Backend::BooleanGmwInput(std::size_t party_id, std::vector<BitVector<>>&& input) {
   const auto input_gate =
-      std::make_shared<proto::boolean_gmw::InputGate>(std::move(input), party_id, *this);
+      register_->MakeShared<proto::boolean_gmw::InputGate>(std::move(input), party_id, *this);
   const auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
   RegisterInputGate(input_gate_cast);
   return std::static_pointer_cast<Share>(input_gate->GetOutputAsGmwShare());
@@ -201,7 +262,7 @@ SharePointer Backend::BooleanGmwXor(const proto::boolean_gmw::SharePointer& a,
                                     const proto::boolean_gmw::SharePointer& b) {
   assert(a);
   assert(b);
-  const auto xor_gate = std::make_shared<proto::boolean_gmw::XorGate>(a, b);
+  const auto xor_gate = register_->MakeShared<proto::boolean_gmw::XorGate>(a, b);
   RegisterGate(xor_gate);
   return xor_gate->GetOutputAsShare();
 }
@@ -220,7 +281,7 @@ SharePointer Backend::BooleanGmwAnd(const proto::boolean_gmw::SharePointer& a,
                                     const proto::boolean_gmw::SharePointer& b) {
   assert(a);
   assert(b);
-  const auto and_gate = std::make_shared<proto::boolean_gmw::AndGate>(a, b);
+  const auto and_gate = register_->MakeShared<proto::boolean_gmw::AndGate>(a, b);
   RegisterGate(and_gate);
   return and_gate->GetOutputAsShare();
 }
@@ -241,7 +302,7 @@ SharePointer Backend::BooleanGmwMux(const proto::boolean_gmw::SharePointer& a,
   assert(a);
   assert(b);
   assert(selection);
-  const auto mux_gate = std::make_shared<proto::boolean_gmw::MuxGate>(a, b, selection);
+  const auto mux_gate = register_->MakeShared<proto::boolean_gmw::MuxGate>(a, b, selection);
   RegisterGate(mux_gate);
   return mux_gate->GetOutputAsShare();
 }
@@ -262,7 +323,12 @@ SharePointer Backend::BooleanGmwMux(const SharePointer& a, const SharePointer& b
 
 SharePointer Backend::BooleanGmwOutput(const SharePointer& parent, std::size_t output_owner) {
   assert(parent);
-  const auto output_gate = std::make_shared<proto::boolean_gmw::OutputGate>(parent, output_owner);
+  const auto output_gate =
+      register_->MakeShared<proto::boolean_gmw::OutputGate>(parent, output_owner);
+  // the outputs are read after the evaluation, so they are never released
+  for (auto& wire : output_gate->GetOutputWires()) {
+    wire->Pin();
+  }
   const auto ouput_gate_cast = std::static_pointer_cast<Gate>(output_gate);
   RegisterGate(ouput_gate_cast);
   return std::static_pointer_cast<Share>(output_gate->GetOutputAsShare());
@@ -281,7 +347,7 @@ SharePointer Backend::BmrInput(std::size_t party_id, BitVector<>&& input) {
 }
 
 SharePointer Backend::BmrInput(std::size_t party_id, const std::vector<BitVector<>>& input) {
-  const auto input_gate = std::make_shared<proto::bmr::InputGate>(input, party_id, *this);
+  const auto input_gate = register_->MakeShared<proto::bmr::InputGate>(input, party_id, *this);
   const auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
   RegisterInputGate(input_gate_cast);
   return std::static_pointer_cast<Share>(input_gate->GetOutputAsBmrShare());
@@ -289,7 +355,7 @@ SharePointer Backend::BmrInput(std::size_t party_id, const std::vector<BitVector
 
 SharePointer Backend::BmrInput(std::size_t party_id, std::vector<BitVector<>>&& input) {
   const auto input_gate =
-      std::make_shared<proto::bmr::InputGate>(std::move(input), party_id, *this);
+      register_->MakeShared<proto::bmr::InputGate>(std::move(input), party_id, *this);
   const auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
   RegisterInputGate(input_gate_cast);
   return std::static_pointer_cast<Share>(input_gate->GetOutputAsBmrShare());
@@ -297,7 +363,11 @@ SharePointer Backend::BmrInput(std::size_t party_id, std::vector<BitVector<>>&&
 
 SharePointer Backend::BmrOutput(const SharePointer& parent, std::size_t output_owner) {
   assert(parent);
-  const auto output_gate = std::make_shared<proto::bmr::OutputGate>(parent, output_owner);
+  const auto output_gate = register_->MakeShared<proto::bmr::OutputGate>(parent, output_owner);
+  // the outputs are read after the evaluation, so they are never released
+  for (auto& wire : output_gate->GetOutputWires()) {
+    wire->Pin();
+  }
   const auto ouput_gate_cast = std::static_pointer_cast<Gate>(output_gate);
   RegisterGate(ouput_gate_cast);
   return std::static_pointer_cast<Share>(output_gate->GetOutputAsShare());
@@ -345,13 +415,21 @@ void Backend::OtExtensionSetup() {
 
   run_time_statistics_.back().RecordStart<RunTimeStatistics::StatisticsId::kOtExtensionSetup>();
 
+  const std::size_t number_of_setups{2 * (communication_layer_.GetNumberOfParties() - 1)};
+  std::size_t number_of_workers{configuration_->GetNumberOfOtExtensionWorkers()};
+  if (number_of_workers == 0) {
+    number_of_workers =
+        std::max<std::size_t>(configuration_->GetNumOfThreads() / number_of_setups, 1);
+  }
+
   std::vector<std::future<void>> task_futures;
-  task_futures.reserve(2 * (communication_layer_.GetNumberOfParties() - 1));
+  task_futures.reserve(number_of_setups);
 
   for (auto i = 0ull; i < communication_layer_.GetNumberOfParties(); ++i) {
     if (i == communication_layer_.GetMyId()) {
       continue;
     }
+    ot_provider_manager_->GetProvider(i).SetNumberOfWorkers(number_of_workers);
     task_futures.emplace_back(std::async(
         std::launch::async, [this, i] { ot_provider_manager_->GetProvider(i).SendSetup(); }));
     task_futures.emplace_back(std::async(
@@ -368,6 +446,166 @@ void Backend::OtExtensionSetup() {
   }
 }
 
+void Backend::SetOtBackend(OtBackend ot_backend) { ot_provider_manager_->SetOtBackend(ot_backend); }
+
+void Backend::GeneratePreprocessing(PreprocessingStore& store,
+                                    const PreprocessingAmounts& amounts) {
+  if (mt_provider_->NeedMts() || sp_provider_->NeedSps() || sb_provider_->NeedSbs()) {
+    throw std::logic_error("Cannot generate preprocessing material after gates requested some");
+  }
+  // the parties compare their stores before computing anything, such that the material of this
+  // job is appended at the same position of the same files, and files that were never filled
+  // before get the generation ID proposed by party 0
+  std::uint64_t generation_id{0};
+  while (generation_id == 0) {
+    generation_id = RandomVector<std::uint64_t>(1).at(0);
+  }
+  std::vector<std::uint64_t> states;
+  for (std::size_t i = 0; i < kNumberOfMaterials; ++i) {
+    const auto state{store.GetState(static_cast<PreprocessingMaterial>(i))};
+    states.push_back(state.generation_id);
+    states.push_back(state.number_of_records);
+  }
+  states.push_back(generation_id);
+  auto their_states{ExchangePreprocessingStoreStates(states)};
+  if (communication_layer_.GetMyId() != 0 && !their_states.at(0).empty()) {
+    generation_id = their_states.at(0).back();
+  }
+  states.pop_back();
+  for (auto& party_states : their_states) {
+    if (!party_states.empty()) party_states.pop_back();
+  }
+  CheckPreprocessingStoreStates(states, their_states);
+  for (std::size_t i = 0; i < kNumberOfMaterials; ++i) {
+    if (states.at(2 * i) == 0) {
+      store.SetGenerationId(static_cast<PreprocessingMaterial>(i), generation_id);
+    }
+  }
+
+  // all offsets are 0, since nothing was requested before
+  mt_provider_->RequestBinaryMts(amounts.number_of_binary_mts);
+  mt_provider_->RequestArithmeticMts<std::uint8_t>(amounts.number_of_mts_8);
+  mt_provider_->RequestArithmeticMts<std::uint16_t>(amounts.number_of_mts_16);
+  mt_provider_->RequestArithmeticMts<std::uint32_t>(amounts.number_of_mts_32);
+  mt_provider_->RequestArithmeticMts<std::uint64_t>(amounts.number_of_mts_64);
+  sp_provider_->RequestSps<std::uint8_t>(amounts.number_of_sps_8);
+  sp_provider_->RequestSps<std::uint16_t>(amounts.number_of_sps_16);
+  sp_provider_->RequestSps<std::uint32_t>(amounts.number_of_sps_32);
+  sp_provider_->RequestSps<std::uint64_t>(amounts.number_of_sps_64);
+  sp_provider_->RequestSps<__uint128_t>(amounts.number_of_sps_128);
+  sb_provider_->RequestSbs<std::uint8_t>(amounts.number_of_sbs_8);
+  sb_provider_->RequestSbs<std::uint16_t>(amounts.number_of_sbs_16);
+  sb_provider_->RequestSbs<std::uint32_t>(amounts.number_of_sbs_32);
+  sb_provider_->RequestSbs<std::uint64_t>(amounts.number_of_sbs_64);
+
+  RunPreprocessing();
+
+  // the SB provider requests additional SPs for its own use, which are not stored
+  if (mt_provider_->NeedMts()) {
+    store.AppendBinaryMts(mt_provider_->GetBinaryAll(), amounts.number_of_binary_mts);
+    store.AppendMts(mt_provider_->GetIntegerAll<std::uint8_t>(), amounts.number_of_mts_8);
+    store.AppendMts(mt_provider_->GetIntegerAll<std::uint16_t>(), amounts.number_of_mts_16);
+    store.AppendMts(mt_provider_->GetIntegerAll<std::uint32_t>(), amounts.number_of_mts_32);
+    store.AppendMts(mt_provider_->GetIntegerAll<std::uint64_t>(), amounts.number_of_mts_64);
+  }
+  if (sp_provider_->NeedSps()) {
+    store.AppendSps(sp_provider_->GetSpsAll<std::uint8_t>(), amounts.number_of_sps_8);
+    store.AppendSps(sp_provider_->GetSpsAll<std::uint16_t>(), amounts.number_of_sps_16);
+    store.AppendSps(sp_provider_->GetSpsAll<std::uint32_t>(), amounts.number_of_sps_32);
+    store.AppendSps(sp_provider_->GetSpsAll<std::uint64_t>(), amounts.number_of_sps_64);
+    store.AppendSps(sp_provider_->GetSpsAll<__uint128_t>(), amounts.number_of_sps_128);
+  }
+  if (sb_provider_->NeedSbs()) {
+    store.AppendSbs(sb_provider_->GetSbsAll<std::uint8_t>(), amounts.number_of_sbs_8);
+    store.AppendSbs(sb_provider_->GetSbsAll<std::uint16_t>(), amounts.number_of_sbs_16);
+    store.AppendSbs(sb_provider_->GetSbsAll<std::uint32_t>(), amounts.number_of_sbs_32);
+    store.AppendSbs(sb_provider_->GetSbsAll<std::uint64_t>(), amounts.number_of_sbs_64);
+  }
+}
+
+void Backend::SetPreprocessingStore(std::shared_ptr<PreprocessingStore> store) {
+  if (mt_provider_->NeedMts() || sp_provider_->NeedSps() || sb_provider_->NeedSbs()) {
+    throw std::logic_error("Cannot change the preprocessing after gates requested material");
+  }
+  SetStoreProviders(std::move(store), nullptr);
+}
+
+void Backend::SetPreprocessingService(std::shared_ptr<PreprocessingService> service) {
+  if (mt_provider_->NeedMts() || sp_provider_->NeedSps() || sb_provider_->NeedSbs()) {
+    throw std::logic_error("Cannot change the preprocessing after gates requested material");
+  }
+  SetStoreProviders(service->GetStore(), service);
+}
+
+bool Backend::NeedsOtExtension() {
+  if (NeedOts()) {
+    return true;
+  }
+  return !preprocessing_store_ &&
+         (mt_provider_->NeedMts() || sp_provider_->NeedSps() || sb_provider_->NeedSbs());
+}
+
+std::vector<std::vector<std::uint64_t>> Backend::ExchangePreprocessingStoreStates(
+    const std::vector<std::uint64_t>& states) {
+  const auto my_id{communication_layer_.GetMyId()};
+  const auto number_of_parties{communication_layer_.GetNumberOfParties()};
+  std::vector<std::uint8_t> payload(states.size() * sizeof(std::uint64_t));
+  std::memcpy(payload.data(), states.data(), payload.size());
+  for (std::size_t party_id = 0; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id) continue;
+    auto message{communication::BuildMessage(communication::MessageType::kPreprocessingStoreState,
+                                             &payload)};
+    communication_layer_.SendMessage(party_id, std::move(message));
+  }
+
+  std::vector<std::vector<std::uint64_t>> their_states(number_of_parties);
+  for (std::size_t party_id = 0; party_id < number_of_parties; ++party_id) {
+    if (party_id == my_id) continue;
+    const auto raw_message{
+        preprocessing_store_state_handlers_.at(party_id)->GetQueue().dequeue()};
+    if (!raw_message) {
+      throw std::runtime_error(
+          fmt::format("Lost the connection to party {} while comparing the preprocessing stores",
+                      party_id));
+    }
+    const auto* their_payload{communication::GetMessage(raw_message->data())->payload()};
+    // a different size can only stem from a different version, which the comparison rejects
+    their_states.at(party_id).resize(their_payload->size() / sizeof(std::uint64_t));
+    std::memcpy(their_states.at(party_id).data(), their_payload->data(),
+                their_states.at(party_id).size() * sizeof(std::uint64_t));
+  }
+  return their_states;
+}
+
+void Backend::CheckPreprocessingStoreStates(
+    const std::vector<std::uint64_t>& states,
+    const std::vector<std::vector<std::uint64_t>>& their_states) {
+  const auto my_id{communication_layer_.GetMyId()};
+  for (std::size_t party_id = 0; party_id < their_states.size(); ++party_id) {
+    if (party_id == my_id) continue;
+    if (their_states.at(party_id) != states) {
+      throw std::runtime_error(fmt::format(
+          "The preprocessing stores of parties {} and {} were not filled by the same generation "
+          "jobs or not consumed in lockstep",
+          my_id, party_id));
+    }
+  }
+}
+
+void Backend::SetStoreProviders(std::shared_ptr<PreprocessingStore> store,
+                                std::shared_ptr<PreprocessingService> service) {
+  preprocessing_store_ = store;
+  preprocessing_service_ = service;
+  auto my_id = communication_layer_.GetMyId();
+  mt_provider_ = std::make_shared<MtProviderFromStore>(store, service, my_id,
+                                                       communication_layer_.GetNumberOfParties(),
+                                                       *logger_, run_time_statistics_.back());
+  sp_provider_ = std::make_shared<SpProviderFromStore>(store, service, my_id, *logger_,
+                                                       run_time_statistics_.back());
+  sb_provider_ = std::make_shared<SbProviderFromStore>(store, service, my_id, *logger_,
+                                                       run_time_statistics_.back());
+}
+
 OtProvider& Backend::GetOtProvider(std::size_t party_id) {
   return ot_provider_manager_->GetProvider(party_id);
 }
@@ -36,6 +36,7 @@ static_assert(FLATBUFFERS_LITTLEENDIAN);
 namespace encrypto::motion::communication {
 
 class CommunicationLayer;
+class QueueHandler;
 
 }  // namespace encrypto::motion::communication
 
@@ -67,6 +68,9 @@ using InputGatePointer = std::shared_ptr<InputGate>;
 class MtProvider;
 class SpProvider;
 class SbProvider;
+class PreprocessingStore;
+class PreprocessingService;
+struct PreprocessingAmounts;
 
 struct RunTimeStatistics;
 
@@ -83,6 +87,7 @@ class Register;
 using RegisterPointer = std::shared_ptr<Register>;
 
 class GateExecutor;
+class FiberThreadPool;
 
 class Backend : public std::enable_shared_from_this<Backend> {
  public:
@@ -117,6 +122,9 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   const std::vector<GatePointer>& GetInputGates() const;
 
+  /// \brief Destroys all gates and wires. If a PreprocessingStore is set, the MT, SP and SB
+  /// providers are replaced by fresh ones, such that the next circuit consumes its own material
+  /// from the store.
   void Reset();
 
   void Clear();
@@ -169,15 +177,16 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   SharePointer ConstantArithmeticGmwInput(const std::vector<T>& input_vector) {
-    auto input_gate = std::make_shared<proto::ConstantArithmeticInputGate<T>>(input_vector, *this);
+    auto input_gate =
+        register_->MakeShared<proto::ConstantArithmeticInputGate<T>>(input_vector, *this);
     RegisterGate(input_gate);
     return std::static_pointer_cast<Share>(input_gate->GetOutputAsShare());
   }
 
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   SharePointer ConstantArithmeticGmwInput(std::vector<T>&& input_vector) {
-    auto input_gate =
-        std::make_shared<proto::ConstantArithmeticInputGate<T>>(std::move(input_vector), *this);
+    auto input_gate = register_->MakeShared<proto::ConstantArithmeticInputGate<T>>(
+        std::move(input_vector), *this);
     RegisterGate(input_gate);
     return std::static_pointer_cast<Share>(input_gate->GetOutputAsShare());
   }
@@ -191,7 +200,7 @@ class Backend : public std::enable_shared_from_this<Backend> {
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   SharePointer ArithmeticGmwInput(std::size_t party_id, const std::vector<T>& input_vector) {
     auto input_gate =
-        std::make_shared<proto::arithmetic_gmw::InputGate<T>>(input_vector, party_id, *this);
+        register_->MakeShared<proto::arithmetic_gmw::InputGate<T>>(input_vector, party_id, *this);
     auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
     RegisterInputGate(input_gate_cast);
     return std::static_pointer_cast<Share>(input_gate->GetOutputAsArithmeticShare());
@@ -199,8 +208,8 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
   SharePointer ArithmeticGmwInput(std::size_t party_id, std::vector<T>&& input_vector) {
-    auto input_gate = std::make_shared<proto::arithmetic_gmw::InputGate<T>>(std::move(input_vector),
-                                                                            party_id, *this);
+    auto input_gate = register_->MakeShared<proto::arithmetic_gmw::InputGate<T>>(
+        std::move(input_vector), party_id, *this);
     auto input_gate_cast = std::static_pointer_cast<InputGate>(input_gate);
     RegisterInputGate(input_gate_cast);
     return std::static_pointer_cast<Share>(input_gate->GetOutputAsArithmeticShare());
@@ -210,7 +219,12 @@ class Backend : public std::enable_shared_from_this<Backend> {
   SharePointer ArithmeticGmwOutput(const proto::arithmetic_gmw::SharePointer<T>& parent,
                                    std::size_t output_owner) {
     assert(parent);
-    auto output_gate = std::make_shared<proto::arithmetic_gmw::OutputGate<T>>(parent, output_owner);
+    auto output_gate =
+        register_->MakeShared<proto::arithmetic_gmw::OutputGate<T>>(parent, output_owner);
+    // the outputs are read after the evaluation, so they are never released
+    for (auto& wire : output_gate->GetOutputWires()) {
+      wire->Pin();
+    }
     auto out_gate_cast = std::static_pointer_cast<Gate>(output_gate);
     RegisterGate(out_gate_cast);
     return std::static_pointer_cast<Share>(output_gate->GetOutputAsArithmeticShare());
@@ -231,7 +245,8 @@ class Backend : public std::enable_shared_from_this<Backend> {
     assert(b);
     auto wire_a = a->GetArithmeticWire();
     auto wire_b = b->GetArithmeticWire();
-    auto addition_gate = std::make_shared<proto::arithmetic_gmw::AdditionGate<T>>(wire_a, wire_b);
+    auto addition_gate =
+        register_->MakeShared<proto::arithmetic_gmw::AdditionGate<T>>(wire_a, wire_b);
     auto addition_gate_cast = std::static_pointer_cast<Gate>(addition_gate);
     RegisterGate(addition_gate_cast);
     return std::static_pointer_cast<Share>(addition_gate->GetOutputAsArithmeticShare());
@@ -255,7 +270,8 @@ class Backend : public std::enable_shared_from_this<Backend> {
     assert(b);
     auto wire_a = a->GetArithmeticWire();
     auto wire_b = b->GetArithmeticWire();
-    auto sub_gate = std::make_shared<proto::arithmetic_gmw::SubtractionGate<T>>(wire_a, wire_b);
+    auto sub_gate =
+        register_->MakeShared<proto::arithmetic_gmw::SubtractionGate<T>>(wire_a, wire_b);
     auto sub_gate_cast = std::static_pointer_cast<Gate>(sub_gate);
     RegisterGate(sub_gate_cast);
     return std::static_pointer_cast<Share>(sub_gate->GetOutputAsArithmeticShare());
@@ -272,6 +288,41 @@ class Backend : public std::enable_shared_from_this<Backend> {
     return ArithmeticGmwSubtraction(casted_parent_a_ptr, casted_parent_b_ptr);
   }
 
+  /// \brief Multiplies the row-major \p rows x \p inner matrix a by the row-major \p inner x
+  ///        \p columns matrix b using a single matrix Beaver triple.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  SharePointer ArithmeticGmwMatrixMultiplication(const proto::arithmetic_gmw::SharePointer<T>& a,
+                                                 const proto::arithmetic_gmw::SharePointer<T>& b,
+                                                 std::size_t rows, std::size_t inner,
+                                                 std::size_t columns) {
+    assert(a);
+    assert(b);
+    auto wire_a = a->GetArithmeticWire();
+    auto wire_b = b->GetArithmeticWire();
+    auto matrix_multiplication_gate =
+        register_->MakeShared<proto::arithmetic_gmw::MatrixMultiplicationGate<T>>(
+            wire_a, wire_b, rows, inner, columns);
+    auto matrix_multiplication_gate_cast =
+        std::static_pointer_cast<Gate>(matrix_multiplication_gate);
+    RegisterGate(matrix_multiplication_gate_cast);
+    return std::static_pointer_cast<Share>(
+        matrix_multiplication_gate->GetOutputAsArithmeticShare());
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  SharePointer ArithmeticGmwMatrixMultiplication(const SharePointer& a, const SharePointer& b,
+                                                 std::size_t rows, std::size_t inner,
+                                                 std::size_t columns) {
+    assert(a);
+    assert(b);
+    auto casted_parent_a_ptr = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(a);
+    auto casted_parent_b_ptr = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(b);
+    assert(casted_parent_a_ptr);
+    assert(casted_parent_b_ptr);
+    return ArithmeticGmwMatrixMultiplication(casted_parent_a_ptr, casted_parent_b_ptr, rows, inner,
+                                             columns);
+  }
+
   /// \brief Blocking wait for synchronizing between parties. Called in Clear() and Reset()
   void Synchronize();
 
@@ -285,6 +336,37 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   void OtExtensionSetup();
 
+  /// \brief Selects the generator of the OTs that all correlated randomness is derived from.
+  /// \throws std::logic_error if OTs were already registered, i.e., this needs to be called before
+  /// constructing any gates.
+  void SetOtBackend(OtBackend ot_backend);
+
+  /// \brief Computes the given amounts of MTs, SPs and SBs and appends them to store. All parties
+  /// need to call this with the same amounts. Since the providers compute their material only
+  /// once, the Backend cannot evaluate any gates afterwards. Files that were never filled before
+  /// get a random generation ID that all parties agree on.
+  /// \throws std::logic_error if gates already requested preprocessed material.
+  /// \throws std::runtime_error if the stores of the parties hold different generations or
+  /// amounts of material.
+  void GeneratePreprocessing(PreprocessingStore& store, const PreprocessingAmounts& amounts);
+
+  /// \brief Takes all MTs, SPs and SBs from store instead of computing them during the
+  /// preprocessing. The store needs to be filled by GeneratePreprocessing beforehand. Each
+  /// preprocessing phase compares the generation IDs and consumption offsets of the parties'
+  /// stores and throws std::runtime_error if they differ.
+  /// \throws std::logic_error if gates already requested preprocessed material.
+  void SetPreprocessingStore(std::shared_ptr<PreprocessingStore> store);
+
+  /// \brief Takes all MTs, SPs and SBs from the store of service, which refills it in the
+  /// background. The parties' services need to be used by the same sequence of circuits.
+  /// \throws std::logic_error if gates already requested preprocessed material.
+  void SetPreprocessingService(std::shared_ptr<PreprocessingService> service);
+
+  /// \brief Checks whether the constructed gates need correlated randomness computed via OT
+  /// extension, which the Backend can only run once. This is the case if they registered OTs
+  /// directly or requested MTs, SPs or SBs without a PreprocessingStore being set.
+  bool NeedsOtExtension();
+
   communication::CommunicationLayer& GetCommunicationLayer() { return communication_layer_; };
 
   BaseProvider& GetBaseProvider() { return *motion_base_provider_; };
@@ -301,6 +383,12 @@ class Backend : public std::enable_shared_from_this<Backend> {
 
   auto& GetSbProvider() { return sb_provider_; };
 
+  /// \brief Returns the pool of worker threads evaluating the gates. It is created on first use
+  /// as specified by the configuration and reused for all further evaluations.
+  FiberThreadPool& GetFiberThreadPool();
+
+  GateExecutor& GetGateExecutor() { return *gate_executor_; }
+
   const auto& GetRunTimeStatistics() const { return run_time_statistics_; }
 
   auto& GetMutableRunTimeStatistics() { return run_time_statistics_; }
@@ -312,6 +400,7 @@ class Backend : public std::enable_shared_from_this<Backend> {
   std::shared_ptr<Logger> logger_;
   ConfigurationPointer configuration_;
   RegisterPointer register_;
+  std::unique_ptr<FiberThreadPool> fiber_thread_pool_;
   std::unique_ptr<GateExecutor> gate_executor_;
 
   std::unique_ptr<BaseProvider> motion_base_provider_;
@@ -322,12 +411,28 @@ class Backend : public std::enable_shared_from_this<Backend> {
   std::shared_ptr<SbProvider> sb_provider_;
   std::unique_ptr<proto::bmr::Provider> bmr_provider_;
 
+  std::shared_ptr<PreprocessingStore> preprocessing_store_;
+  std::shared_ptr<PreprocessingService> preprocessing_service_;
+  std::vector<std::shared_ptr<communication::QueueHandler>> preprocessing_store_state_handlers_;
+
   bool share_inputs_{true};
   bool require_base_ots_{false};
   bool base_ots_finished_{false};
   bool ot_extension_finished_{false};
 
   bool NeedOts();
+
+  // sends states to all other parties and returns the ones they sent
+  std::vector<std::vector<std::uint64_t>> ExchangePreprocessingStoreStates(
+      const std::vector<std::uint64_t>& states);
+
+  // throws if the states of the other parties' stores differ from mine
+  void CheckPreprocessingStoreStates(const std::vector<std::uint64_t>& states,
+                                     const std::vector<std::vector<std::uint64_t>>& their_states);
+
+  // replaces the MT, SP and SB providers by providers that consume from store
+  void SetStoreProviders(std::shared_ptr<PreprocessingStore> store,
+                         std::shared_ptr<PreprocessingService> service);
 };
 
 using BackendPointer = std::shared_ptr<Backend>;
@@ -26,6 +26,7 @@
 
 #include <boost/log/trivial.hpp>
 #include <memory>
+#include <vector>
 
 namespace encrypto::motion {
 
@@ -39,6 +40,33 @@ class Configuration {
 
   void SetNumOfThreads(std::size_t n) { number_of_threads_ = n; }
 
+  /// \brief Number of worker threads of the fiber pool evaluating the gates. 0 means
+  ///        std::thread::hardware_concurrency(). Takes effect when the pool is created, i.e., at
+  ///        the first evaluation.
+  std::size_t GetNumberOfFiberPoolWorkers() const noexcept { return number_of_fiber_pool_workers_; }
+
+  void SetNumberOfFiberPoolWorkers(std::size_t n) { number_of_fiber_pool_workers_ = n; }
+
+  /// \brief CPUs the fiber pool workers are pinned to, worker i runs on
+  ///        cpu_affinity[i % cpu_affinity.size()]. Empty means no pinning.
+  const std::vector<std::size_t>& GetFiberPoolCpuAffinity() const noexcept {
+    return fiber_pool_cpu_affinity_;
+  }
+
+  void SetFiberPoolCpuAffinity(std::vector<std::size_t> cpu_affinity) {
+    fiber_pool_cpu_affinity_ = std::move(cpu_affinity);
+  }
+
+  /// \brief Number of threads that each OT extension setup, i.e., the sender and the receiver
+  ///        side for each other party, uses to expand and transpose its bit matrix. 0 means that
+  ///        the GetNumOfThreads() threads are divided among the 2 * (number_of_parties - 1)
+  ///        setups, which run concurrently.
+  std::size_t GetNumberOfOtExtensionWorkers() const noexcept {
+    return number_of_ot_extension_workers_;
+  }
+
+  void SetNumberOfOtExtensionWorkers(std::size_t n) { number_of_ot_extension_workers_ = n; }
+
   void SetLoggingSeverityLevel(boost::log::trivial::severity_level severity_level) {
     severity_level_ = severity_level;
   }
@@ -47,6 +75,31 @@ class Configuration {
 
   void SetOnlineAfterSetup(bool value);
 
+  /// \brief If set, BMR AND gates use row reduction (GRR3): the first row of every garbled table
+  ///        is zero and not sent, which saves a quarter of the garbled rows. The output keys are
+  ///        then derived from the garbled tables, so garbling an AND gate waits for the setup of
+  ///        its parents, i.e., the setup needs one round per AND layer. All parties must use the
+  ///        same setting.
+  bool GetBmrRowReduction() const noexcept { return bmr_row_reduction_; }
+
+  void SetBmrRowReduction(bool value) { bmr_row_reduction_ = value; }
+
+  /// \brief If set, the values of an intermediate wire are freed as soon as all gates waiting for
+  ///        it finished their online phase, such that the peak memory is bounded by the live wires
+  ///        instead of all wires of the circuit. Output wires are kept. The freed values are not
+  ///        restored by Party::Clear(), so Party::Run(repetitions) throws std::logic_error for
+  ///        more than one repetition.
+  bool GetReclaimWireStorage() const noexcept { return reclaim_wire_storage_; }
+
+  void SetReclaimWireStorage(bool value) { reclaim_wire_storage_ = value; }
+
+  /// \brief If set, the setup and online time of every gate is measured and aggregated per gate
+  ///        type and per layer into the RunTimeStatistics, see PrintJson and PrintChromeTrace.
+  ///        This adds two clock reads per gate and phase.
+  bool GetProfiling() const noexcept { return profiling_; }
+
+  void SetProfiling(bool value) { profiling_ = value; }
+
   void SetLoggingEnabled(bool value = true) { logging_enabled_ = value; }
 
   bool GetLoggingEnabled() const noexcept { return logging_enabled_; }
@@ -71,11 +124,21 @@ class Configuration {
   /// until proceeding to the online phase
   bool online_after_setup_ = false;
 
-  // determines how many worker threads are used in openmp, but not in
-  // communication handlers! the latter always use at least 2 threads for each
+  bool bmr_row_reduction_ = false;
+
+  bool reclaim_wire_storage_ = false;
+
+  bool profiling_ = false;
+
+  // determines how many worker threads are used in openmp, e.g., by the OT extension setup, but
+  // not in communication handlers! the latter always use at least 2 threads for each
   // communication channel to send and receive data to prevent the communication
   // becoming a bottleneck, e.g., in 10 Gbps networks.
   std::size_t number_of_threads_;
+
+  std::size_t number_of_fiber_pool_workers_ = 0;
+  std::size_t number_of_ot_extension_workers_ = 0;
+  std::vector<std::size_t> fiber_pool_cpu_affinity_;
 };
 
 using ConfigurationPointer = std::shared_ptr<Configuration>;
@@ -182,9 +182,9 @@ void BaseProvider::Setup() {
 
 void BaseProvider::WaitForSetup() const { setup_ready_cond_->Wait(); }
 
-std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> BaseProvider::RegisterForOutputMessages(
-    std::size_t gate_id) {
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> futures(number_of_parties_);
+std::vector<ReusableFiberFuture<communication::MessageView>>
+BaseProvider::RegisterForOutputMessages(std::size_t gate_id) {
+  std::vector<ReusableFiberFuture<communication::MessageView>> futures(number_of_parties_);
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
     if (party_id == my_id_) {
       continue;
@@ -24,6 +24,7 @@
 
 #include <atomic>
 #include <memory>
+#include "communication/message_view.h"
 #include "utility/reusable_future.h"
 
 namespace encrypto::motion::communication {
@@ -61,7 +62,7 @@ class BaseProvider {
     return *their_randomness_generators_.at(party_id);
   }
 
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> RegisterForOutputMessages(
+  std::vector<ReusableFiberFuture<communication::MessageView>> RegisterForOutputMessages(
       std::size_t gate_id);
 
  private:
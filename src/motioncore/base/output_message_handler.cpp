@@ -34,9 +34,9 @@ namespace encrypto::motion {
 OutputMessageHandler::OutputMessageHandler(std::size_t party_id, std::shared_ptr<Logger> logger)
     : party_id_(party_id), logger_(std::move(logger)) {}
 
-ReusableFiberFuture<std::vector<std::uint8_t>> OutputMessageHandler::register_for_output_message(
-    std::size_t gate_id) {
-  ReusableFiberPromise<std::vector<std::uint8_t>> promise;
+ReusableFiberFuture<communication::MessageView>
+OutputMessageHandler::register_for_output_message(std::size_t gate_id) {
+  ReusableFiberPromise<communication::MessageView> promise;
   auto future = promise.get_future();
   std::unique_lock<std::mutex> lock(output_message_promises_mutex_);
   auto [_, success] = output_message_promises_.insert({gate_id, std::move(promise)});
@@ -58,10 +58,15 @@ ReusableFiberFuture<std::vector<std::uint8_t>> OutputMessageHandler::register_fo
   return future;
 }
 
-void OutputMessageHandler::ReceivedMessage(std::size_t,
+void OutputMessageHandler::ReceivedMessage(std::size_t party_id,
                                            std::vector<std::uint8_t>&& output_message) {
+  ReceivedMessageView(party_id, communication::MessageView(std::move(output_message)));
+}
+
+void OutputMessageHandler::ReceivedMessageView(std::size_t,
+                                               communication::MessageView&& output_message) {
   assert(!output_message.empty());
-  auto message = communication::GetMessage(reinterpret_cast<std::uint8_t*>(output_message.data()));
+  auto message = communication::GetMessage(output_message.data());
   auto output_message_pointer = communication::GetOutputMessage(message->payload()->data());
   auto gate_id = output_message_pointer->gate_id();
 
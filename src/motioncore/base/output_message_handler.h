@@ -37,16 +37,19 @@ class OutputMessageHandler : public communication::MessageHandler {
 
   // Register for an OutputMessage.
   // Returns a future which can be used to wait for and retrieve the message.
-  ReusableFiberFuture<std::vector<std::uint8_t>> register_for_output_message(std::size_t gate_id);
+  ReusableFiberFuture<communication::MessageView> register_for_output_message(std::size_t gate_id);
 
   // Method which is called on received messages.
   void ReceivedMessage(std::size_t, std::vector<std::uint8_t>&& message) override;
 
+  // Keeps the received view in the promise without copying.
+  void ReceivedMessageView(std::size_t, communication::MessageView&& message) override;
+
  private:
   std::size_t party_id_;
   std::shared_ptr<Logger> logger_;
 
-  std::unordered_map<std::size_t, ReusableFiberPromise<std::vector<std::uint8_t>>>
+  std::unordered_map<std::size_t, ReusableFiberPromise<communication::MessageView>>
       output_message_promises_;
   // synchronizes access to above map
   std::mutex output_message_promises_mutex_;
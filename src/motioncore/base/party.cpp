@@ -165,6 +165,10 @@ SharePointer Party::And(const SharePointer& a, const SharePointer& b) {
 
 void Party::Run(std::size_t repetitions) {
   logger_->LogDebug("Party run");
+  if (repetitions > 1 && configuration_->GetReclaimWireStorage()) {
+    throw std::logic_error(
+        "Reclaiming the wire storage cannot be combined with more than one repetition");
+  }
 
   // TODO: fix check if work exists s.t. it does not require knowledge about OT
   // internals etc.
@@ -191,6 +195,28 @@ void Party::Run(std::size_t repetitions) {
   }
 }
 
+void Party::RunStreaming(
+    std::size_t number_of_chunks,
+    const std::function<std::function<void()>(std::size_t)>& construct_chunk) {
+  for (auto chunk_id = 0ull; chunk_id < number_of_chunks; ++chunk_id) {
+    auto consume_outputs = construct_chunk(chunk_id);
+    if (backend_->NeedsOtExtension()) {
+      throw std::logic_error(fmt::format(
+          "Chunk #{} needs OT extension, set a PreprocessingStore for streaming evaluation",
+          chunk_id));
+    }
+
+    logger_->LogDebug(fmt::format("Streaming evaluation of chunk #{}", chunk_id));
+    Run();
+    if (consume_outputs) {
+      consume_outputs();
+    }
+    // drop the output shares before destroying the gates, so that their wires are freed
+    consume_outputs = nullptr;
+    Reset();
+  }
+}
+
 void Party::Reset() {
   backend_->Synchronize();
   logger_->LogDebug("Party reset");
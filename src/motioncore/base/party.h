@@ -25,6 +25,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -236,6 +237,18 @@ class Party {
   /// @param repetitions Number of iterations.
   void Run(std::size_t repetitions = 1);
 
+  /// \brief Evaluates a circuit over number_of_chunks successive input chunks, such that only the
+  /// gates, wires and preprocessed material of a single chunk are held in memory at a time.
+  /// construct_chunk(i) constructs the gates of chunk i including its outputs and returns a
+  /// function that consumes these outputs after chunk i was evaluated. Afterwards, the gates and
+  /// wires of chunk i are destroyed via Party::Reset(). All parties need to construct the same
+  /// sequence of chunks.
+  /// If the chunks need MTs, SPs or SBs, each chunk consumes them from the PreprocessingStore set
+  /// at the Backend.
+  /// \throws std::logic_error if a chunk needs OT extension, which can be run only once.
+  void RunStreaming(std::size_t number_of_chunks,
+                    const std::function<std::function<void()>(std::size_t)>& construct_chunk);
+
   /// \brief Destroys all the gates and wires that were constructed until now.
   void Reset();
 
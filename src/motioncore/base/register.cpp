@@ -26,8 +26,6 @@
 
 #include <iostream>
 
-#include <fmt/format.h>
-
 #include "configuration.h"
 #include "protocols/gate.h"
 #include "protocols/wire.h"
@@ -37,7 +35,8 @@
 
 namespace encrypto::motion {
 
-Register::Register(std::shared_ptr<Logger> logger) : logger_(std::move(logger)) {
+Register::Register(std::shared_ptr<Logger> logger)
+    : logger_(std::move(logger)), arena_(std::make_shared<Arena>()) {
   gates_setup_done_condition_ =
       std::make_shared<FiberCondition>([this]() { return gates_setup_done_flag_; });
   gates_online_done_condition_ =
@@ -85,32 +84,6 @@ void Register::RegisterNextInputGate(GatePointer gate) {
   input_gates_.push_back(gate);
 }
 
-void Register::AddToActiveQueue(std::size_t gate_id) {
-  std::scoped_lock lock(active_queue_mutex_);
-  active_gates_.push(gate_id);
-  if constexpr (kVerboseDebug) {
-    logger_->LogTrace(fmt::format("Added gate #{} to the active queue", gate_id));
-  }
-}
-
-void Register::ClearActiveQueue() {
-  logger_->LogDebug("Clearing active queue");
-  std::scoped_lock lock(active_queue_mutex_);
-  active_gates_ = {};
-}
-
-std::int64_t Register::GetNextGateFromActiveQueue() {
-  std::scoped_lock lock(active_queue_mutex_);
-  if (active_gates_.empty()) {
-    return -1;
-  } else {
-    const auto gate_id = active_gates_.front();
-    assert(gate_id < static_cast<std::size_t>(std::numeric_limits<std::int64_t>::max()));
-    active_gates_.pop();
-    return static_cast<std::int64_t>(gate_id);
-  }
-}
-
 void Register::IncrementEvaluatedGatesSetupCounter() {
   auto number_of_evaluated_gates_setup = ++evaluated_gates_setup_;
   if (number_of_evaluated_gates_setup == gates_.size()) {
@@ -138,7 +111,6 @@ void Register::Reset() {
     throw(std::runtime_error("Register::Reset evaluated_gates_ != gates_.size()"));
   }
 
-  assert(active_gates_.empty());
   assert(evaluated_gates_online_ == gates_.size());
   if (!gates_.empty()) {
     gate_id_offset_ = global_gate_id_;
@@ -151,6 +123,7 @@ void Register::Reset() {
   wires_.clear();
   gates_.clear();
   input_gates_.clear();
+  arena_ = std::make_shared<Arena>();
 
   evaluated_gates_setup_ = 0;
   evaluated_gates_online_ = 0;
@@ -162,7 +135,6 @@ void Register::Clear() {
   if (evaluated_gates_online_ != gates_.size()) {
     throw(std::runtime_error("Register::Reset evaluated_gates_ != gates_.size()"));
   }
-  assert(active_gates_.empty());
   assert(evaluated_gates_online_ == gates_.size());
   for (auto& gate : gates_) {
     gate->Clear();
@@ -178,22 +150,4 @@ void Register::Clear() {
   gates_online_done_flag_ = false;
 }
 
-bool Register::AddCachedAlgorithmDescription(
-    std::string path, const std::shared_ptr<AlgorithmDescription>& algorithm_description) {
-  std::scoped_lock lock(cached_algos_mutex_);
-  const auto [iterator, success] = cached_algos_.try_emplace(path, algorithm_description);
-  return success;
-}
-
-std::shared_ptr<AlgorithmDescription> Register::GetCachedAlgorithmDescription(
-    const std::string& path) {
-  std::scoped_lock lock(cached_algos_mutex_);
-  const auto iterator = cached_algos_.find(path);
-  if (iterator == cached_algos_.end()) {
-    return nullptr;
-  } else {
-    return iterator->second;
-  }
-}
-
 }  // namespace encrypto::motion
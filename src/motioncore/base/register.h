@@ -26,13 +26,12 @@
 
 #include <atomic>
 #include <memory>
-#include <mutex>
-#include <queue>
-#include <unordered_map>
+#include <vector>
+
+#include "utility/arena.h"
 
 namespace encrypto::motion {
 
-struct AlgorithmDescription;
 class FiberCondition;
 class Gate;
 using GatePointer = std::shared_ptr<Gate>;
@@ -53,6 +52,13 @@ class Register {
 
   std::shared_ptr<Logger> GetLogger() { return logger_; }
 
+  /// \brief Constructs a gate, wire or share of the current circuit in the Arena of this
+  /// Register instead of allocating it separately on the heap.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> MakeShared(Args&&... args) {
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena_), std::forward<Args>(args)...);
+  }
+
   std::size_t NextGateId() noexcept;
 
   std::size_t NextWireId() noexcept;
@@ -79,13 +85,9 @@ class Register {
 
   WirePointer GetWire(std::size_t wire_id) const { return wires_.at(wire_id - wire_id_offset_); }
 
-  void UnregisterWire(std::size_t wire_id) { wires_.at(wire_id) = nullptr; }
+  const auto& GetWires() const { return wires_; }
 
-  void AddToActiveQueue(std::size_t gate_id);
-
-  void ClearActiveQueue();
-
-  std::int64_t GetNextGateFromActiveQueue();
+  void UnregisterWire(std::size_t wire_id) { wires_.at(wire_id) = nullptr; }
 
   void IncrementEvaluatedGatesSetupCounter();
 
@@ -97,6 +99,9 @@ class Register {
 
   std::size_t GetTotalNumberOfGates() const { return global_gate_id_ - gate_id_offset_; }
 
+  // id of the first gate of the current circuit, the ids are consecutive
+  std::size_t GetGateIdOffset() const { return gate_id_offset_; }
+
   void Reset();
 
   void Clear();
@@ -109,20 +114,12 @@ class Register {
     return gates_online_done_condition_;
   };
 
-  /// \brief Tries to insert an AlgorithmDescription object read from a file into cached_algos_
-  /// \param path absolute path to the corresponding file
-  /// \param algorithm_description AlgorithmDescription object corresponding to the parsed file
-  /// \returns true if the insertion was successful and false if the object is already in the cache
-  bool AddCachedAlgorithmDescription(
-      std::string path, const std::shared_ptr<AlgorithmDescription>& algorithm_description);
-
-  /// \brief Gets cached AlgorithmDescription object read from a file and placed into cached_algos_
-  /// \return shared_ptr to the algorithm description or to nullptr if not in the hash table
-  std::shared_ptr<AlgorithmDescription> GetCachedAlgorithmDescription(const std::string& path);
-
  private:
   std::shared_ptr<Logger> logger_;
 
+  // replaced by a new one in Reset(), the old one is released with its last object
+  std::shared_ptr<Arena> arena_;
+
   // don't need atomic here, since only the master thread has access to these
   std::size_t global_gate_id_ = 0, global_wire_id_ = 0;
   std::size_t global_arithmetic_gmw_sharing_id_ = 0, global_boolean_gmw_sharing_id_ = 0;
@@ -138,16 +135,10 @@ class Register {
   std::shared_ptr<FiberCondition> gates_setup_done_condition_;
   std::shared_ptr<FiberCondition> gates_online_done_condition_;
 
-  std::queue<std::size_t> active_gates_;
-  std::mutex active_queue_mutex_;
-
   std::vector<GatePointer> input_gates_;
   std::vector<GatePointer> gates_;
 
   std::vector<WirePointer> wires_;
-
-  std::unordered_map<std::string, std::shared_ptr<AlgorithmDescription>> cached_algos_;
-  std::mutex cached_algos_mutex_;
 };
 
 using RegisterPointer = std::shared_ptr<Register>;
@@ -22,9 +22,11 @@
 
 #include "communication_layer.h"
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <optional>
 #include <shared_mutex>
 #include <stdexcept>
 #include <thread>
@@ -56,6 +58,8 @@ struct CommunicationLayer::CommunicationLayerImplementation {
 
   // setup threads and data structures
   void initialize(std::size_t my_id, std::size_t number_of_parties);
+  // adds a message of the given size to the message_type_statistics_ of party_id
+  void CountMessage(std::size_t party_id, MessageType message_type, std::size_t size, bool sent);
   void SendTerminationMessages();
   void Shutdown();
 
@@ -72,7 +76,27 @@ struct CommunicationLayer::CommunicationLayerImplementation {
   using message_t =
       std::variant<std::vector<std::uint8_t>, std::shared_ptr<const std::vector<std::uint8_t>>>;
 
-  std::vector<SynchronizedFiberQueue<message_t>> send_queues_;
+  struct OutgoingMessage {
+    message_t message;
+    // passed by the sender, messages without a type are not counted per type
+    std::optional<MessageType> message_type;
+  };
+
+  std::vector<SynchronizedFiberQueue<OutgoingMessage>> send_queues_;
+
+  struct AtomicMessageTypeStatistics {
+    std::atomic<std::size_t> number_of_messages_sent{0}, number_of_messages_received{0},
+        number_of_bytes_sent{0}, number_of_bytes_received{0};
+  };
+
+  // parties X message types, written by the send and receive thread of the respective party and
+  // read by GetTransportStatistics
+  std::vector<std::vector<AtomicMessageTypeStatistics>> message_type_statistics_;
+
+  // queued messages are coalesced into one write; if less than flush_threshold_ bytes are
+  // pending, the send threads wait up to flush_deadline_ for further messages
+  std::size_t flush_threshold_ = kDefaultFlushThreshold;
+  std::chrono::microseconds flush_deadline_{0};
   std::vector<std::thread> receive_threads_;
   std::vector<std::thread> send_threads_;
 
@@ -94,10 +118,15 @@ CommunicationLayer::CommunicationLayerImplementation::CommunicationLayerImplemen
       start_sfuture_(start_promise_.get_future().share()),
       transports_(std::move(transports)),
       send_queues_(number_of_parties_),
+      message_type_statistics_(number_of_parties_),
       message_handlers_(number_of_parties_),
       fallback_message_handlers_(number_of_parties_),
       sync_handler_(std::make_shared<SynchronizationHandler>(my_id_, number_of_parties_, logger)),
       logger_(std::move(logger)) {
+  for (auto& message_types : message_type_statistics_) {
+    message_types = std::vector<AtomicMessageTypeStatistics>(
+        static_cast<std::size_t>(MessageType::MAX) + 1);
+  }
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
     if (party_id == my_id) {
       receive_threads_.emplace_back();
@@ -119,26 +148,66 @@ void CommunicationLayer::CommunicationLayerImplementation::SendTask(std::size_t
   auto my_start_sfuture = start_sfuture_;
   my_start_sfuture.get();
 
+  auto message_size = [](const OutgoingMessage& outgoing_message) {
+    const auto& message = outgoing_message.message;
+    if (message.index() == 0) {
+      // std::vector<std::uint8_t>
+      return std::get<0>(message).size();
+    } else {
+      // std::shared_ptr<const std::vector<std::uint8_t>>
+      return std::get<1>(message)->size();
+    }
+  };
+
+  std::vector<OutgoingMessage> batch;
+  std::vector<const std::vector<std::uint8_t>*> batch_pointers;
   while (!queue.IsClosedAndEmpty()) {
     auto tmp_queue = queue.BatchDequeue();
     if (!tmp_queue.has_value()) {
       assert(queue.IsClosed());
       break;
     }
-    while (!tmp_queue->empty()) {
-      auto& message = tmp_queue->front();
+    std::size_t number_of_bytes = 0;
+    auto append_to_batch = [&batch, &number_of_bytes, &message_size](auto& messages) {
+      while (!messages.empty()) {
+        number_of_bytes += message_size(messages.front());
+        batch.emplace_back(std::move(messages.front()));
+        messages.pop();
+      }
+    };
+    append_to_batch(*tmp_queue);
+
+    // Nagle-style: give the other gates the chance to add messages to this write
+    if (flush_deadline_.count() > 0 && number_of_bytes < flush_threshold_) {
+      const auto flush_time = std::chrono::steady_clock::now() + flush_deadline_;
+      while (number_of_bytes < flush_threshold_) {
+        auto more_messages = queue.BatchDequeueUntil(flush_time);
+        if (!more_messages.has_value() || more_messages->empty()) {
+          break;
+        }
+        append_to_batch(*more_messages);
+      }
+    }
+
+    batch_pointers.clear();
+    for (const auto& [message, message_type] : batch) {
       if (message.index() == 0) {
-        // std::vector<std::uint8_t>
-        transport.SendMessage(std::get<0>(message));
-      } else if (message.index() == 1) {
-        // std::shared_ptr<const std::vector<std::uint8_t>>
-        transport.SendMessage(*std::get<1>(message));
+        batch_pointers.emplace_back(&std::get<0>(message));
+      } else {
+        batch_pointers.emplace_back(std::get<1>(message).get());
       }
-      tmp_queue->pop();
-      if (logger_) {
-        logger_->LogDebug(fmt::format("Sent message to party {}", party_id));
+    }
+    transport.SendMessages(batch_pointers);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      if (batch[i].message_type) {
+        CountMessage(party_id, *batch[i].message_type, batch_pointers[i]->size(), true);
       }
     }
+    if (logger_) {
+      logger_->LogDebug(fmt::format("Sent {} messages ({} B) to party {}", batch.size(),
+                                    number_of_bytes, party_id));
+    }
+    batch.clear();
   }
 
   transport.ShutdownSend();
@@ -148,6 +217,26 @@ void CommunicationLayer::CommunicationLayerImplementation::SendTask(std::size_t
   }
 }
 
+void CommunicationLayer::CommunicationLayerImplementation::CountMessage(std::size_t party_id,
+                                                                      MessageType message_type,
+                                                                      std::size_t size, bool sent) {
+  auto& message_types = message_type_statistics_.at(party_id);
+  const auto index = static_cast<std::size_t>(message_type);
+  // unknown types, e.g., of a newer version of the other party, are not counted
+  if (index >= message_types.size()) {
+    return;
+  }
+  // the counters are independent, so they need no ordering
+  auto& statistics = message_types[index];
+  if (sent) {
+    statistics.number_of_messages_sent.fetch_add(1, std::memory_order_relaxed);
+    statistics.number_of_bytes_sent.fetch_add(size, std::memory_order_relaxed);
+  } else {
+    statistics.number_of_messages_received.fetch_add(1, std::memory_order_relaxed);
+    statistics.number_of_bytes_received.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
 void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size_t party_id) {
   auto& transport = *transports_.at(party_id);
   auto& handler_map = message_handlers_.at(party_id);
@@ -156,9 +245,9 @@ void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size
   my_start_sfuture.get();
 
   while (continue_communication_) {
-    std::optional<std::vector<std::uint8_t>> raw_message_opt;
+    std::optional<MessageView> raw_message_opt;
     try {
-      raw_message_opt = transport.ReceiveMessage();
+      raw_message_opt = transport.ReceiveMessageView();
     } catch (std::runtime_error& e) {
       if (logger_) {
         logger_->LogError(
@@ -176,15 +265,14 @@ void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size
     }
     auto raw_message = std::move(*raw_message_opt);
 
-    flatbuffers::Verifier verifier(reinterpret_cast<std::uint8_t*>(raw_message.data()),
-                                   raw_message.size());
+    flatbuffers::Verifier verifier(raw_message.data(), raw_message.size());
     if (!VerifyMessageBuffer(verifier)) {
       if (logger_) {
         logger_->LogError(fmt::format("received corrupt message from party {}", party_id));
       }
       auto fallback_handler = fallback_message_handlers_.at(party_id);
       if (fallback_handler) {
-        fallback_handler->ReceivedMessage(party_id, std::move(raw_message));
+        fallback_handler->ReceivedMessageView(party_id, std::move(raw_message));
       }
       continue;
     }
@@ -193,6 +281,7 @@ void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size
     auto message = GetMessage(raw_message.data());
 
     auto message_type = message->message_type();
+    CountMessage(party_id, message_type, raw_message.size(), false);
     if constexpr (kDebug) {
       if (logger_) {
         logger_->LogDebug(fmt::format("received message of type {} from party {}",
@@ -210,11 +299,11 @@ void CommunicationLayer::CommunicationLayerImplementation::ReceiveTask(std::size
     std::shared_lock lock(message_handlers_mutex_);
     auto iterator = handler_map.find(message_type);
     if (iterator != handler_map.end()) {
-      iterator->second->ReceivedMessage(party_id, std::move(raw_message));
+      iterator->second->ReceivedMessageView(party_id, std::move(raw_message));
     } else {
       auto fallback_handler = fallback_message_handlers_.at(party_id);
       if (fallback_handler) {
-        fallback_handler->ReceivedMessage(party_id, std::move(raw_message));
+        fallback_handler->ReceivedMessageView(party_id, std::move(raw_message));
       }
       if (logger_) {
         logger_->LogError(fmt::format("dropping message of type {} from party {}",
@@ -328,66 +417,78 @@ void CommunicationLayer::Synchronize() {
   }
 }
 
-void CommunicationLayer::SendMessage(std::size_t party_id, std::vector<std::uint8_t>&& message) {
-  implementation_->send_queues_.at(party_id).enqueue(std::move(message));
+void CommunicationLayer::SendMessage(std::size_t party_id, std::vector<std::uint8_t>&& message,
+                                     std::optional<MessageType> message_type) {
+  implementation_->send_queues_.at(party_id).enqueue({std::move(message), message_type});
 }
 
 void CommunicationLayer::SendMessage(std::size_t party_id,
-                                     const std::vector<std::uint8_t>& message) {
-  implementation_->send_queues_.at(party_id).enqueue(message);
+                                     const std::vector<std::uint8_t>& message,
+                                     std::optional<MessageType> message_type) {
+  implementation_->send_queues_.at(party_id).enqueue({message, message_type});
 }
 
 void CommunicationLayer::SendMessage(std::size_t party_id,
-                                     std::shared_ptr<const std::vector<std::uint8_t>> message) {
-  implementation_->send_queues_.at(party_id).enqueue(std::move(message));
+                                     std::shared_ptr<const std::vector<std::uint8_t>> message,
+                                     std::optional<MessageType> message_type) {
+  implementation_->send_queues_.at(party_id).enqueue({std::move(message), message_type});
 }
 
 void CommunicationLayer::SendMessage(std::size_t party_id,
                                      flatbuffers::FlatBufferBuilder&& message_builder) {
   auto message_detached = message_builder.Release();
   auto message_buffer = message_detached.data();
+  // the builder was finished by BuildMessage, so its root is a Message that needs no verification
+  const auto message_type{GetMessage(message_buffer)->message_type()};
   SendMessage(party_id,
-              std::vector<std::uint8_t>(message_buffer, message_buffer + message_detached.size()));
+              std::vector<std::uint8_t>(message_buffer, message_buffer + message_detached.size()),
+              message_type);
 }
 
-void CommunicationLayer::BroadcastMessage(std::vector<std::uint8_t>&& message) {
+void CommunicationLayer::BroadcastMessage(std::vector<std::uint8_t>&& message,
+                                          std::optional<MessageType> message_type) {
   if (number_of_parties_ == 2) {
-    SendMessage(1 - my_id_, std::move(message));
+    SendMessage(1 - my_id_, std::move(message), message_type);
     return;
   }
-  BroadcastMessage(std::make_shared<std::vector<std::uint8_t>>(std::move(message)));
+  BroadcastMessage(std::make_shared<std::vector<std::uint8_t>>(std::move(message)), message_type);
 }
 
 // TODO: prevent unnecessary copies
-void CommunicationLayer::BroadcastMessage(const std::vector<std::uint8_t>& message) {
+void CommunicationLayer::BroadcastMessage(const std::vector<std::uint8_t>& message,
+                                          std::optional<MessageType> message_type) {
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
     if (party_id == my_id_) {
       continue;
     }
-    implementation_->send_queues_.at(party_id).enqueue(message);
+    implementation_->send_queues_.at(party_id).enqueue({message, message_type});
   }
 }
 
-void CommunicationLayer::BroadcastMessage(
-    std::shared_ptr<const std::vector<std::uint8_t>> message) {
+void CommunicationLayer::BroadcastMessage(std::shared_ptr<const std::vector<std::uint8_t>> message,
+                                          std::optional<MessageType> message_type) {
   for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
     if (party_id == my_id_) {
       continue;
     }
-    implementation_->send_queues_.at(party_id).enqueue(message);
+    implementation_->send_queues_.at(party_id).enqueue({message, message_type});
   }
 }
 
 void CommunicationLayer::BroadcastMessage(flatbuffers::FlatBufferBuilder&& message_builder) {
   auto message_detached = message_builder.Release();
   auto message_buffer = message_detached.data();
+  // the builder was finished by BuildMessage, so its root is a Message that needs no verification
+  const auto message_type{GetMessage(message_buffer)->message_type()};
   if (number_of_parties_ == 2) {
-    SendMessage(1 - my_id_, std::vector<std::uint8_t>(message_buffer,
-                                                      message_buffer + message_detached.size()));
+    SendMessage(1 - my_id_,
+                std::vector<std::uint8_t>(message_buffer, message_buffer + message_detached.size()),
+                message_type);
     return;
   }
   BroadcastMessage(std::make_shared<std::vector<std::uint8_t>>(
-      message_buffer, message_buffer + message_detached.size()));
+                       message_buffer, message_buffer + message_detached.size()),
+                   message_type);
 }
 
 void CommunicationLayer::RegisterMessageHandler(MessageHandlerFunction handler_factory,
@@ -487,10 +588,28 @@ std::vector<TransportStatistics> CommunicationLayer::GetTransportStatistics() co
       continue;
     }
     statistics.emplace_back(implementation_->transports_.at(party_id)->GetStatistics());
+    auto& message_types{statistics.back().message_types};
+    for (const auto& counters : implementation_->message_type_statistics_.at(party_id)) {
+      message_types.push_back({counters.number_of_messages_sent.load(std::memory_order_relaxed),
+                               counters.number_of_messages_received.load(std::memory_order_relaxed),
+                               counters.number_of_bytes_sent.load(std::memory_order_relaxed),
+                               counters.number_of_bytes_received.load(std::memory_order_relaxed)});
+    }
   }
   return statistics;
 }
 
+void CommunicationLayer::SetSendCoalescing(std::size_t flush_threshold,
+                                           std::chrono::microseconds flush_deadline) {
+  if (is_started_) {
+    throw std::logic_error(
+        "changing the send coalescing is not allowed after the CommunicationLayer has been "
+        "started");
+  }
+  implementation_->flush_threshold_ = flush_threshold;
+  implementation_->flush_deadline_ = flush_deadline;
+}
+
 void CommunicationLayer::SetLogger(std::shared_ptr<Logger> logger) {
   if (is_started_) {
     throw std::logic_error(
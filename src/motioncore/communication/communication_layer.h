@@ -23,9 +23,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "fbs_headers/message_generated.h"
@@ -42,6 +44,9 @@ namespace encrypto::motion::communication {
 class MessageHandler;
 struct TransportStatistics;
 
+// default number of bytes after which coalesced messages are flushed
+constexpr std::size_t kDefaultFlushThreshold = 64 * 1024;
+
 // Central interface for all communication related functionality
 //
 // Allows to send messages to other parties and to register handlers for
@@ -60,16 +65,24 @@ class CommunicationLayer {
   void Start();
   void Synchronize();
 
-  // Send a message to a specified party
-  void SendMessage(std::size_t party_id, std::vector<std::uint8_t>&& message);
-  void SendMessage(std::size_t party_id, const std::vector<std::uint8_t>& message);
-  void SendMessage(std::size_t party_id, std::shared_ptr<const std::vector<std::uint8_t>> message);
+  // Send a message to a specified party.  Serialized messages are counted in
+  // the statistics of message_type if it is given, messages built with
+  // BuildMessage are always counted in the statistics of their type.
+  void SendMessage(std::size_t party_id, std::vector<std::uint8_t>&& message,
+                   std::optional<MessageType> message_type = std::nullopt);
+  void SendMessage(std::size_t party_id, const std::vector<std::uint8_t>& message,
+                   std::optional<MessageType> message_type = std::nullopt);
+  void SendMessage(std::size_t party_id, std::shared_ptr<const std::vector<std::uint8_t>> message,
+                   std::optional<MessageType> message_type = std::nullopt);
   void SendMessage(std::size_t party_id, flatbuffers::FlatBufferBuilder&& message_builder);
 
   // Send a message to all other parties
-  void BroadcastMessage(std::vector<std::uint8_t>&& message);
-  void BroadcastMessage(const std::vector<std::uint8_t>& message);
-  void BroadcastMessage(std::shared_ptr<const std::vector<std::uint8_t>> message);
+  void BroadcastMessage(std::vector<std::uint8_t>&& message,
+                        std::optional<MessageType> message_type = std::nullopt);
+  void BroadcastMessage(const std::vector<std::uint8_t>& message,
+                        std::optional<MessageType> message_type = std::nullopt);
+  void BroadcastMessage(std::shared_ptr<const std::vector<std::uint8_t>> message,
+                        std::optional<MessageType> message_type = std::nullopt);
   void BroadcastMessage(flatbuffers::FlatBufferBuilder&& message_builder);
 
   // Factory function for creating message handlers
@@ -93,6 +106,12 @@ class CommunicationLayer {
 
   std::vector<TransportStatistics> GetTransportStatistics() const noexcept;
 
+  // All messages queued for a party are sent with a single write.  If
+  // flush_deadline is positive and less than flush_threshold bytes are queued,
+  // the sender waits up to flush_deadline for further messages before writing.
+  // Must be called before Start.
+  void SetSendCoalescing(std::size_t flush_threshold, std::chrono::microseconds flush_deadline);
+
   void SetLogger(std::shared_ptr<Logger> logger);
 
  private:
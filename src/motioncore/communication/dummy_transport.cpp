@@ -47,6 +47,7 @@ void DummyTransport::SendMessage(std::vector<std::uint8_t>&& message) {
   send_queue_->enqueue(std::move(message));
   statistics_.number_of_messages_sent += 1;
   statistics_.number_of_bytes_sent += message_size;
+  statistics_.number_of_write_operations += 1;
 }
 
 void DummyTransport::SendMessage(const std::vector<std::uint8_t>& message) {
@@ -54,6 +55,7 @@ void DummyTransport::SendMessage(const std::vector<std::uint8_t>& message) {
   send_queue_->enqueue(message);
   statistics_.number_of_messages_sent += 1;
   statistics_.number_of_bytes_sent += message_size;
+  statistics_.number_of_write_operations += 1;
 }
 
 bool DummyTransport::Available() const { return !receive_queue_->empty(); }
@@ -67,6 +69,7 @@ std::optional<std::vector<std::uint8_t>> DummyTransport::ReceiveMessage() {
   }
   statistics_.number_of_messages_received += 1;
   statistics_.number_of_bytes_received += message_opt->size();
+  statistics_.number_of_read_operations += 1;
   return message_opt;
 }
 
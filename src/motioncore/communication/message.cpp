@@ -77,6 +77,12 @@ std::string to_string(MessageType message_type) {
       return "MessageType::SharedBitsMask"s;
     case MessageType::kSharedBitsReconstruct:
       return "MessageType::SharedBitsReconstruct"s;
+    case MessageType::kSilentOtReceiverCorrections:
+      return "MessageType::SilentOtReceiverCorrections"s;
+    case MessageType::kSilentOtSender:
+      return "MessageType::SilentOtSender"s;
+    case MessageType::kPreprocessingStoreState:
+      return "MessageType::PreprocessingStoreState"s;
     default:
       return "Unknown MessageType => update to_string function"s;
   }
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "message_view.h"
 #include "utility/synchronized_queue.h"
 
 namespace encrypto::motion::communication {
@@ -46,6 +47,14 @@ class MessageHandler {
   // This method may be called concurrently with different values of party_id.
   // The client is responsible for the necessary synchronization.
   virtual void ReceivedMessage(std::size_t party_id, std::vector<std::uint8_t>&& message) = 0;
+
+  // Zero-copy variant which is called by the CommunicationLayer.  The view may
+  // point into a receive buffer shared with other messages.  Handlers which can
+  // work on the view directly override this method, the default implementation
+  // copies the message into a vector and calls ReceivedMessage.
+  virtual void ReceivedMessageView(std::size_t party_id, MessageView&& message) {
+    ReceivedMessage(party_id, std::move(message).ToVector());
+  }
 };
 
 // Example message handler which puts received messages into a queue
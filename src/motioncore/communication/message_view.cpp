@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "message_view.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace encrypto::motion::communication {
+
+MessageView::MessageView(std::vector<std::uint8_t>&& message)
+    : buffer_(std::make_shared<std::vector<std::uint8_t>>(std::move(message))),
+      data_(buffer_->data()),
+      size_(buffer_->size()) {}
+
+MessageView::MessageView(std::shared_ptr<std::vector<std::uint8_t>> buffer, std::size_t offset,
+                         std::size_t size)
+    : buffer_(std::move(buffer)), data_(buffer_->data() + offset), size_(size) {
+  assert(offset + size <= buffer_->size());
+}
+
+std::vector<std::uint8_t> MessageView::ToVector() && {
+  std::vector<std::uint8_t> result;
+  if (buffer_ && buffer_.use_count() == 1 && data_ == buffer_->data() &&
+      size_ == buffer_->size()) {
+    result = std::move(*buffer_);
+  } else {
+    result.assign(data_, data_ + size_);
+  }
+  buffer_.reset();
+  data_ = nullptr;
+  size_ = 0;
+  return result;
+}
+
+ReceiveBufferPool::ReceiveBufferPool(std::size_t slab_size, std::size_t max_number_of_free_slabs)
+    : slab_size_(slab_size),
+      max_number_of_free_slabs_(max_number_of_free_slabs),
+      free_list_(std::make_shared<FreeList>()) {}
+
+std::shared_ptr<std::vector<std::uint8_t>> ReceiveBufferPool::GetSlab(std::size_t minimum_size) {
+  const auto slab_size{std::max<std::size_t>(1, (minimum_size + slab_size_ - 1) / slab_size_) *
+                       slab_size_};
+  std::unique_ptr<std::vector<std::uint8_t>> slab;
+  {
+    std::scoped_lock lock(free_list_->mutex);
+    auto& slabs{free_list_->slabs};
+    auto iterator{std::find_if(slabs.begin(), slabs.end(),
+                               [slab_size](const auto& free_slab) {
+                                 return free_slab->size() == slab_size;
+                               })};
+    if (iterator != slabs.end()) {
+      slab = std::move(*iterator);
+      slabs.erase(iterator);
+    }
+  }
+  if (!slab) {
+    slab = std::make_unique<std::vector<std::uint8_t>>(slab_size);
+  }
+
+  // the deleter puts the slab back unless its storage has been moved out by ToVector
+  auto deleter = [free_list = free_list_, slab_size,
+                  max_number_of_free_slabs = max_number_of_free_slabs_](auto* pointer) {
+    std::unique_ptr<std::vector<std::uint8_t>> released(pointer);
+    if (released->size() != slab_size) {
+      return;
+    }
+    std::scoped_lock lock(free_list->mutex);
+    if (free_list->slabs.size() < max_number_of_free_slabs) {
+      free_list->slabs.emplace_back(std::move(released));
+    }
+  };
+  return std::shared_ptr<std::vector<std::uint8_t>>(slab.release(), std::move(deleter));
+}
+
+}  // namespace encrypto::motion::communication
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace encrypto::motion::communication {
+
+// Read-only view of a received message
+//
+// The view shares ownership of the buffer the message was received into, which
+// may be a slab holding several messages.  The buffer stays alive as long as a
+// view refers to it, so handlers can keep views or parse them without copying.
+// Transports start each message at an 8-byte aligned address.
+class MessageView {
+ public:
+  MessageView() = default;
+
+  // view of a whole message, takes ownership of it
+  explicit MessageView(std::vector<std::uint8_t>&& message);
+
+  // view of size bytes starting at offset in buffer
+  MessageView(std::shared_ptr<std::vector<std::uint8_t>> buffer, std::size_t offset,
+              std::size_t size);
+
+  const std::uint8_t* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  std::span<const std::uint8_t> GetSpan() const noexcept { return {data_, size_}; }
+
+  // Copy the message into an owning vector.  If this view is the only owner of
+  // its buffer and covers it completely, the buffer is moved out instead.
+  std::vector<std::uint8_t> ToVector() &&;
+
+ private:
+  std::shared_ptr<std::vector<std::uint8_t>> buffer_;
+  const std::uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Pool of fixed-size receive buffers (slabs)
+//
+// Slabs are handed out as shared pointers and return to the pool once the last
+// MessageView into them is destroyed.  The pool may be destroyed before its slabs.
+class ReceiveBufferPool {
+ public:
+  ReceiveBufferPool(std::size_t slab_size, std::size_t max_number_of_free_slabs);
+
+  std::size_t GetSlabSize() const noexcept { return slab_size_; }
+
+  // get a slab of the smallest multiple of GetSlabSize() bytes that holds minimum_size bytes,
+  // reusing a released one of the same size if possible
+  std::shared_ptr<std::vector<std::uint8_t>> GetSlab(std::size_t minimum_size = 0);
+
+ private:
+  struct FreeList {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<std::vector<std::uint8_t>>> slabs;
+  };
+
+  std::size_t slab_size_;
+  std::size_t max_number_of_free_slabs_;
+  std::shared_ptr<FreeList> free_list_;
+};
+
+}  // namespace encrypto::motion::communication
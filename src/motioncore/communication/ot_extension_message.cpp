@@ -64,4 +64,28 @@ flatbuffers::FlatBufferBuilder BuildOtExtensionMessageReceiverCorrections(const
                       builder.GetSize());
 }
 
+flatbuffers::FlatBufferBuilder BuildSilentOtMessageReceiverCorrections(const std::byte* buffer,
+                                                                       const std::size_t size,
+                                                                       const std::size_t i) {
+  flatbuffers::FlatBufferBuilder builder(size + 32);
+  std::vector<std::uint8_t> v_buffer(reinterpret_cast<const std::uint8_t*>(buffer),
+                                     reinterpret_cast<const std::uint8_t*>(buffer) + size);
+  auto root = CreateOtExtensionMessageDirect(builder, i, &v_buffer);
+  FinishOtExtensionMessageBuffer(builder, root);
+  return BuildMessage(MessageType::kSilentOtReceiverCorrections, builder.GetBufferPointer(),
+                      builder.GetSize());
+}
+
+flatbuffers::FlatBufferBuilder BuildSilentOtMessageSender(const std::byte* buffer,
+                                                          const std::size_t size,
+                                                          const std::size_t i) {
+  flatbuffers::FlatBufferBuilder builder(size + 32);
+  std::vector<std::uint8_t> v_buffer(reinterpret_cast<const std::uint8_t*>(buffer),
+                                     reinterpret_cast<const std::uint8_t*>(buffer) + size);
+  auto root = CreateOtExtensionMessageDirect(builder, i, &v_buffer);
+  FinishOtExtensionMessageBuffer(builder, root);
+  return BuildMessage(MessageType::kSilentOtSender, builder.GetBufferPointer(),
+                      builder.GetSize());
+}
+
 }  // namespace encrypto::motion::communication
@@ -40,4 +40,13 @@ flatbuffers::FlatBufferBuilder BuildOtExtensionMessageReceiverMasks(const std::b
 flatbuffers::FlatBufferBuilder BuildOtExtensionMessageReceiverCorrections(const std::byte* buffer,
                                                                           const std::size_t size,
                                                                           const std::size_t i);
+
+flatbuffers::FlatBufferBuilder BuildSilentOtMessageReceiverCorrections(const std::byte* buffer,
+                                                                       const std::size_t size,
+                                                                       const std::size_t i);
+
+flatbuffers::FlatBufferBuilder BuildSilentOtMessageSender(const std::byte* buffer,
+                                                          const std::size_t size,
+                                                          const std::size_t i);
+
 }  // namespace encrypto::motion::communication
@@ -22,6 +22,8 @@
 
 #include "tcp_transport.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <future>
 #include <shared_mutex>
@@ -39,17 +41,91 @@ using boost::asio::ip::tcp;
 
 namespace encrypto::motion::communication {
 
+// Each frame consists of the message size as 4 bytes and 4 reserved zero bytes, followed by the
+// message padded to a multiple of kFrameAlignment bytes.  Hence, all messages start at aligned
+// offsets in the stream and in the receive slabs, whose storage is at least as aligned.
+constexpr std::size_t kFrameAlignment = 8;
+constexpr std::size_t kFrameHeaderSize = 8;
+static_assert(kFrameHeaderSize % kFrameAlignment == 0);
+
+constexpr std::size_t PaddedFrameSize(std::size_t size) {
+  return (size + kFrameAlignment - 1) / kFrameAlignment * kFrameAlignment;
+}
+
+// size of the pooled slabs frames are received into, several frames are parsed from one read and
+// a frame larger than a slab is received into a pooled slab of a multiple of this size
+constexpr std::size_t kReceiveSlabSize = 64 * 1024;
+constexpr std::size_t kMaxNumberOfFreeReceiveSlabs = 16;
+static_assert(kReceiveSlabSize % kFrameAlignment == 0);
+
+// messages up to this size are copied into a contiguous staging buffer before sending, larger
+// messages are passed to the scatter-gather write as separate buffers
+constexpr std::size_t kSendCopyThreshold = 4 * 1024;
+
 namespace detail {
 
 struct TcpTransportImplementation {
   TcpTransportImplementation(std::shared_ptr<boost::asio::io_context> io_context,
                              tcp::socket&& socket)
-      : io_context_(io_context), socket_(std::move(socket)) {}
+      : io_context_(io_context),
+        socket_(std::move(socket)),
+        receive_buffer_pool_(kReceiveSlabSize, kMaxNumberOfFreeReceiveSlabs),
+        receive_slab_(receive_buffer_pool_.GetSlab()) {}
+
+  // Make sure that number_of_bytes bytes are buffered in receive_slab_ from receive_begin_ on.
+  // Returns false if the connection was closed before any byte.
+  bool FillReceiveSlab(std::size_t number_of_bytes, TransportStatistics& statistics);
+
   std::shared_ptr<boost::asio::io_context> io_context_;
   boost::asio::ip::tcp::socket socket_;
   std::shared_mutex socket_mutex_;
+
+  // received but not yet parsed bytes are in [receive_begin_, receive_end_) of receive_slab_,
+  // where receive_begin_ is a multiple of kFrameAlignment at the start of each frame
+  ReceiveBufferPool receive_buffer_pool_;
+  std::shared_ptr<std::vector<std::uint8_t>> receive_slab_;
+  std::size_t receive_begin_ = 0;
+  std::size_t receive_end_ = 0;
 };
 
+bool TcpTransportImplementation::FillReceiveSlab(std::size_t number_of_bytes,
+                                                 TransportStatistics& statistics) {
+  if (receive_begin_ + number_of_bytes > receive_slab_->size()) {
+    // move the partial frame to the front of a slab that holds the whole frame, which keeps it
+    // aligned and is only allowed in place if no view refers to the slab anymore
+    auto slab = receive_slab_.use_count() == 1 && number_of_bytes <= receive_slab_->size()
+                    ? receive_slab_
+                    : receive_buffer_pool_.GetSlab(number_of_bytes);
+    std::copy(receive_slab_->begin() + receive_begin_, receive_slab_->begin() + receive_end_,
+              slab->begin());
+    receive_end_ -= receive_begin_;
+    receive_begin_ = 0;
+    receive_slab_ = std::move(slab);
+  }
+  boost::system::error_code ec;
+  while (receive_end_ - receive_begin_ < number_of_bytes) {
+    socket_.wait(tcp::socket::wait_read, ec);
+    if (ec) {
+      throw std::runtime_error(
+          fmt::format("Error while wait read on socket: {} ({})", ec.message(), ec.value()));
+    }
+    auto free_buffer = boost::asio::buffer(receive_slab_->data() + receive_end_,
+                                           receive_slab_->size() - receive_end_);
+    auto number_of_bytes_read = socket_.read_some(free_buffer, ec);
+    if (ec) {
+      if (ec.value() == boost::asio::error::misc_errors::eof && receive_end_ == receive_begin_) {
+        // connection has been closed
+        return false;
+      }
+      throw std::runtime_error(fmt::format("Error while reading from socket: {} ({})",
+                                           ec.message(), ec.value()));
+    }
+    receive_end_ += number_of_bytes_read;
+    statistics.number_of_read_operations += 1;
+  }
+  return true;
+}
+
 }  // namespace detail
 
 TcpTransport::TcpTransport(std::unique_ptr<detail::TcpTransportImplementation> implementation)
@@ -62,6 +138,9 @@ TcpTransport::~TcpTransport() = default;
 
 bool TcpTransport::Available() const {
   std::scoped_lock lock(implementation_->socket_mutex_);
+  if (implementation_->receive_end_ > implementation_->receive_begin_) {
+    return true;
+  }
   auto result = implementation_->socket_.available();
   return result > 0;
 }
@@ -88,16 +167,53 @@ static void u32tou8(std::uint32_t v, std::uint8_t* result) {
 }
 
 void TcpTransport::SendMessage(const std::vector<std::uint8_t>& message) {
-  if (message.size() > std::numeric_limits<std::uint32_t>::max()) {
-    throw std::runtime_error(fmt::format("Max message size is {} B but tried to send {} B",
-                                         std::numeric_limits<std::uint32_t>::max(),
-                                         message.size()));
-  }
-  std::array<std::uint8_t, sizeof(std::uint32_t)> message_size;
-  u32tou8(message.size(), message_size.data());
+  SendMessages({&message});
+}
 
-  std::array<boost::asio::const_buffer, 2> buffers = {boost::asio::buffer(message_size),
-                                                      boost::asio::buffer(message)};
+void TcpTransport::SendMessages(const std::vector<const std::vector<std::uint8_t>*>& messages) {
+  // the staging buffer holds all size headers and the small messages, it must not be
+  // reallocated once buffers refer to it
+  std::size_t staging_size = 0;
+  std::size_t number_of_bytes = 0;
+  for (auto message : messages) {
+    if (message->size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::runtime_error(fmt::format("Max message size is {} B but tried to send {} B",
+                                           std::numeric_limits<std::uint32_t>::max(),
+                                           message->size()));
+    }
+    staging_size += kFrameHeaderSize;
+    if (message->size() <= kSendCopyThreshold) {
+      staging_size += PaddedFrameSize(message->size());
+    }
+    number_of_bytes += kFrameHeaderSize + PaddedFrameSize(message->size());
+  }
+  // zero-initialized, such that the reserved header bytes and the padding are zero
+  std::vector<std::uint8_t> staging(staging_size);
+  static constexpr std::array<std::uint8_t, kFrameAlignment> kPadding{};
+
+  // consecutive small messages end up in one contiguous buffer
+  std::vector<boost::asio::const_buffer> buffers;
+  std::size_t segment_begin = 0;
+  std::size_t segment_end = 0;
+  for (auto message : messages) {
+    u32tou8(message->size(), staging.data() + segment_end);
+    segment_end += kFrameHeaderSize;
+    const auto padding_size{PaddedFrameSize(message->size()) - message->size()};
+    if (message->size() <= kSendCopyThreshold) {
+      std::copy(message->begin(), message->end(), staging.begin() + segment_end);
+      segment_end += message->size() + padding_size;
+    } else {
+      buffers.emplace_back(staging.data() + segment_begin, segment_end - segment_begin);
+      buffers.emplace_back(boost::asio::buffer(*message));
+      if (padding_size > 0) {
+        buffers.emplace_back(kPadding.data(), padding_size);
+      }
+      segment_begin = segment_end;
+    }
+  }
+  if (segment_end > segment_begin) {
+    buffers.emplace_back(staging.data() + segment_begin, segment_end - segment_begin);
+  }
 
   boost::system::error_code ec;
   std::shared_lock lock(implementation_->socket_mutex_);
@@ -105,11 +221,12 @@ void TcpTransport::SendMessage(const std::vector<std::uint8_t>& message) {
   if (ec) {
     throw std::runtime_error(fmt::format("Error while writing to socket: {}", ec.message()));
   }
-  statistics_.number_of_bytes_sent += message.size() + sizeof(uint32_t);
-  statistics_.number_of_messages_sent += 1;
+  statistics_.number_of_bytes_sent += number_of_bytes;
+  statistics_.number_of_messages_sent += messages.size();
+  statistics_.number_of_write_operations += 1;
 }
 
-static std::uint32_t u8tou32(std::array<std::uint8_t, sizeof(std::uint32_t)>& v) {
+static std::uint32_t u8tou32(const std::uint8_t* v) {
   std::uint32_t result = 0;
   for (auto i = 0u; i < sizeof(std::uint32_t); ++i) {
     result += (v[i] << i * 8);
@@ -118,35 +235,42 @@ static std::uint32_t u8tou32(std::array<std::uint8_t, sizeof(std::uint32_t)>& v)
 }
 
 std::optional<std::vector<std::uint8_t>> TcpTransport::ReceiveMessage() {
-  std::array<std::uint8_t, sizeof(std::uint32_t)> message_size_buffer;
-  boost::system::error_code ec;
-  std::shared_lock lock(implementation_->socket_mutex_);
-  implementation_->socket_.wait(tcp::socket::wait_read, ec);
-  if (ec) {
-    throw std::runtime_error(
-        fmt::format("Error while wait read on socket: {} ({})", ec.message(), ec.value()));
+  auto message = ReceiveMessageView();
+  if (!message.has_value()) {
+    return std::nullopt;
   }
-  boost::asio::read(implementation_->socket_, boost::asio::buffer(message_size_buffer),
-                    boost::asio::transfer_exactly(message_size_buffer.size()), ec);
-  if (ec) {
-    if (ec.value() == boost::asio::error::misc_errors::eof) {
-      // connection has been closed
-      return std::nullopt;
-    }
-    throw std::runtime_error(fmt::format("Error while reading message size from socket: {} ({})",
-                                         ec.message(), ec.value()));
+  return std::move(*message).ToVector();
+}
+
+std::optional<MessageView> TcpTransport::ReceiveMessageView() {
+  auto& implementation = *implementation_;
+  std::shared_lock lock(implementation.socket_mutex_);
+
+  // a single read usually fetches several frames
+  if (!implementation.FillReceiveSlab(kFrameHeaderSize, statistics_)) {
+    return std::nullopt;
   }
-  std::uint32_t message_size = u8tou32(message_size_buffer);
-  std::vector<std::uint8_t> message_buffer(message_size);
-  boost::asio::read(implementation_->socket_, boost::asio::buffer(message_buffer),
-                    boost::asio::transfer_exactly(message_buffer.size()), ec);
-  if (ec) {
-    throw std::runtime_error(
-        fmt::format("Error while reading message size socket: {} ({})", ec.message(), ec.value()));
+  std::uint32_t message_size =
+      u8tou32(implementation.receive_slab_->data() + implementation.receive_begin_);
+  implementation.receive_begin_ += kFrameHeaderSize;
+  const auto padded_size{PaddedFrameSize(message_size)};
+
+  if (!implementation.FillReceiveSlab(padded_size, statistics_)) {
+    throw std::runtime_error("Connection closed while reading a message from socket");
+  }
+  // zero-copy: the message is a view into the slab, which returns to the pool once the transport
+  // moved on to another slab and the last view into it is released
+  std::optional<MessageView> message{std::in_place, implementation.receive_slab_,
+                                     implementation.receive_begin_, message_size};
+  implementation.receive_begin_ += padded_size;
+  if (implementation.receive_begin_ == implementation.receive_end_ &&
+      implementation.receive_slab_.use_count() == 1) {
+    // everything is parsed and no view refers to the slab, continue at its front
+    implementation.receive_begin_ = implementation.receive_end_ = 0;
   }
-  statistics_.number_of_bytes_received += message_size + sizeof(uint32_t);
+  statistics_.number_of_bytes_received += kFrameHeaderSize + padded_size;
   statistics_.number_of_messages_received += 1;
-  return message_buffer;
+  return message;
 }
 
 using namespace std::chrono_literals;
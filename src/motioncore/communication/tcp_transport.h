@@ -47,9 +47,14 @@ class TcpTransport : public Transport {
 
   void SendMessage(std::vector<std::uint8_t>&& message) override;
   void SendMessage(const std::vector<std::uint8_t>& message) override;
+  // writes all messages with a single scatter-gather write
+  void SendMessages(const std::vector<const std::vector<std::uint8_t>*>& messages) override;
 
   bool Available() const override;
   std::optional<std::vector<std::uint8_t>> ReceiveMessage() override;
+  // returns views into pooled receive slabs for messages larger than 4 KiB and up to 64 KiB,
+  // smaller messages are copied out of the slab; all messages are 8-byte aligned
+  std::optional<MessageView> ReceiveMessageView() override;
   void ShutdownSend() override;
   void Shutdown() override;
 
@@ -24,6 +24,20 @@
 
 namespace encrypto::motion::communication {
 
+void Transport::SendMessages(const std::vector<const std::vector<std::uint8_t>*>& messages) {
+  for (auto message : messages) {
+    SendMessage(*message);
+  }
+}
+
+std::optional<MessageView> Transport::ReceiveMessageView() {
+  auto message = ReceiveMessage();
+  if (!message.has_value()) {
+    return std::nullopt;
+  }
+  return MessageView(std::move(*message));
+}
+
 const TransportStatistics& Transport::GetStatistics() const { return statistics_; }
 
 void Transport::ResetStatistics() {
@@ -31,6 +45,8 @@ void Transport::ResetStatistics() {
   statistics_.number_of_messages_received = 0;
   statistics_.number_of_bytes_sent = 0;
   statistics_.number_of_bytes_received = 0;
+  statistics_.number_of_write_operations = 0;
+  statistics_.number_of_read_operations = 0;
 }
 
 }  // namespace encrypto::motion::communication
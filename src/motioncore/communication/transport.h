@@ -27,13 +27,28 @@
 #include <stdexcept>
 #include <vector>
 
+#include "message_view.h"
+
 namespace encrypto::motion::communication {
 
+struct MessageTypeStatistics {
+  std::size_t number_of_messages_sent = 0;
+  std::size_t number_of_messages_received = 0;
+  std::size_t number_of_bytes_sent = 0;
+  std::size_t number_of_bytes_received = 0;
+};
+
 struct TransportStatistics {
   std::size_t number_of_messages_sent = 0;
   std::size_t number_of_messages_received = 0;
   std::size_t number_of_bytes_sent = 0;
   std::size_t number_of_bytes_received = 0;
+  // number of write/read operations on the underlying channel, which may
+  // transfer several messages at once
+  std::size_t number_of_write_operations = 0;
+  std::size_t number_of_read_operations = 0;
+  // indexed by MessageType, only filled in by CommunicationLayer::GetTransportStatistics
+  std::vector<MessageTypeStatistics> message_types;
 };
 
 // underlying transport between two parties
@@ -51,12 +66,21 @@ class Transport {
   virtual void SendMessage(std::vector<std::uint8_t>&& message) = 0;
   virtual void SendMessage(const std::vector<std::uint8_t>& message) = 0;
 
+  // send several messages in order, which may be coalesced into fewer writes
+  // the default implementation sends them one by one
+  virtual void SendMessages(const std::vector<const std::vector<std::uint8_t>*>& messages);
+
   // check if a new message is available
   virtual bool Available() const = 0;
 
   // receive message, possibly blocking
   virtual std::optional<std::vector<std::uint8_t>> ReceiveMessage() = 0;
 
+  // receive message as a view, possibly blocking
+  // transports may return views into shared receive buffers to avoid copies,
+  // the default implementation wraps the result of ReceiveMessage
+  virtual std::optional<MessageView> ReceiveMessageView();
+
   // shutdown the outgoing part of the transport to signal end of communication
   virtual void ShutdownSend() = 0;
 
@@ -24,6 +24,7 @@
 
 #include "ot_extension_data.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "utility/block.h"
@@ -35,13 +36,23 @@ namespace encrypto::motion {
 OtExtensionReceiverData::OtExtensionReceiverData() {
   setup_finished_condition =
       std::make_unique<FiberCondition>([this]() { return setup_finished.load(); });
+  silent_ot_sender_message_future = silent_ot_sender_message_promise.get_future();
+}
+
+void OtExtensionReceiverData::WaitSetup(std::size_t number_of_ots) const {
+  setup_finished_condition->Wait(
+      [this, number_of_ots]() { return setup_finished || number_of_ready_ots >= number_of_ots; });
 }
 
 OtExtensionSenderData::OtExtensionSenderData() {
   setup_finished_condition =
       std::make_unique<FiberCondition>([this]() { return setup_finished.load(); });
+  silent_ot_corrections_future = silent_ot_corrections_promise.get_future();
+}
 
-  for (std::size_t i = 0; i < u_promises.size(); ++i) u_futures[i] = u_promises[i].get_future();
+void OtExtensionSenderData::WaitSetup(std::size_t number_of_ots) const {
+  setup_finished_condition->Wait(
+      [this, number_of_ots]() { return setup_finished || number_of_ready_ots >= number_of_ots; });
 }
 
 void OtExtensionData::MessageReceived(const std::uint8_t* message,
@@ -50,13 +61,20 @@ void OtExtensionData::MessageReceived(const std::uint8_t* message,
   switch (type) {
     case OtExtensionDataType::kReceptionMask: {
       {
-        while (sender_data.bit_size == 0) std::this_thread::yield();
-        std::scoped_lock lock(sender_data.u_mutex);
-        sender_data.u[i] = AlignedBitVector(message, sender_data.bit_size);
-        sender_data.u_promises[sender_data.number_of_received_us].set_value(i);
-
         // set to 0 after Clear()
-        sender_data.number_of_received_us++;
+        while (sender_data.bit_size == 0) std::this_thread::yield();
+        // i = chunk_id * 128 + row_id
+        const std::size_t chunk_id{i / 128};
+        const std::size_t chunk_offset{chunk_id * kOtExtensionChunkSize};
+        const std::size_t chunk_size{
+            std::min(kOtExtensionChunkSize, sender_data.bit_size - chunk_offset)};
+        AlignedBitVector u(message, chunk_size);
+        {
+          std::scoped_lock lock(sender_data.u_mutex);
+          sender_data.u.at(i) = std::move(u);
+          ++sender_data.number_of_received_us.at(chunk_id);
+        }
+        sender_data.u_condition.notify_all();
       }
 
       break;
@@ -75,18 +93,29 @@ void OtExtensionData::MessageReceived(const std::uint8_t* message,
       condition->second->NotifyAll();
       break;
     }
+    case OtExtensionDataType::kSilentOtCorrection: {
+      sender_data.silent_ot_corrections_promise.set_value(
+          BitVector<>(message, message_size * 8));
+      break;
+    }
+    case OtExtensionDataType::kSilentOtSenderMessage: {
+      assert(message_size % Block128::size() == 0);
+      receiver_data.silent_ot_sender_message_promise.set_value(
+          Block128Vector(message_size / Block128::size(), message));
+      break;
+    }
     case OtExtensionDataType::kSendMessage: {
       {
-        receiver_data.setup_finished_condition->Wait();
+        const auto batch_iterator = receiver_data.number_of_ots_in_batch.find(i);
+        assert(batch_iterator != receiver_data.number_of_ots_in_batch.end());
+        const auto batch_size = batch_iterator->second;
+
+        receiver_data.WaitSetup(i + batch_size);
 
         std::unique_lock lock(receiver_data.bitlengths_mutex);
         const auto bitlength = receiver_data.bitlengths.at(i);
         lock.unlock();
 
-        const auto batch_iterator = receiver_data.number_of_ots_in_batch.find(i);
-        assert(batch_iterator != receiver_data.number_of_ots_in_batch.end());
-        const auto batch_size = batch_iterator->second;
-
         auto message_type = receiver_data.message_type.find(i);
         if (message_type != receiver_data.message_type.end()) {
           switch (message_type->second) {
@@ -26,6 +26,7 @@
 
 #include <array>
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -48,15 +49,25 @@ enum OtExtensionDataType : uint {
   kReceptionMask = 0,
   kReceptionCorrection = 1,
   kSendMessage = 2,
-  kOtExtensionInvalidDataType = 3
+  kSilentOtCorrection = 3,
+  kSilentOtSenderMessage = 4,
+  kOtExtensionInvalidDataType = 5
 };
 
+// number of OTs, i.e., columns of the bit matrix, that are extended at once. The OT extension
+// processes the matrix in chunks of this width to bound the memory needed for the matrix and to
+// release the OTs chunk by chunk. Must be a multiple of 128.
+constexpr std::size_t kOtExtensionChunkSize{1 << 16};
+
 enum class OtMessageType { kBit, kBlock128, kUint8, kUint16, kUint32, kUint64, kUint128 };
 
 struct OtExtensionReceiverData {
   OtExtensionReceiverData();
   ~OtExtensionReceiverData() = default;
 
+  /// \brief Blocks until the setup computed the outputs of the first \p number_of_ots OTs.
+  void WaitSetup(std::size_t number_of_ots) const;
+
   [[nodiscard]] ReusableFiberFuture<Block128Vector> RegisterForBlock128SenderMessage(
       std::size_t ot_id, std::size_t size);
   [[nodiscard]] ReusableFiberFuture<BitVector<>> RegisterForBitSenderMessage(std::size_t ot_id,
@@ -123,6 +134,12 @@ struct OtExtensionReceiverData {
   // flag and condition variable: is setup is done?
   std::unique_ptr<FiberCondition> setup_finished_condition;
   std::atomic<bool> setup_finished{false};
+  // number of OTs whose outputs were already computed by the setup, grows chunk by chunk
+  std::atomic<std::size_t> number_of_ready_ots{0};
+
+  // silent OT: masked GGM level sums and leaf corrections from the sender, one per iteration
+  ReusablePromise<Block128Vector> silent_ot_sender_message_promise;
+  ReusableFuture<Block128Vector> silent_ot_sender_message_future;
 
   // XXX: unused
   std::atomic<std::size_t> consumed_offset{0};
@@ -132,16 +149,20 @@ struct OtExtensionSenderData {
   OtExtensionSenderData();
   ~OtExtensionSenderData() = default;
 
+  /// \brief Blocks until the setup computed the outputs of the first \p number_of_ots OTs.
+  void WaitSetup(std::size_t number_of_ots) const;
+
   // width of the bit matrix
   std::atomic<std::size_t> bit_size{0};
 
-  /// receiver's mask that are needed to construct matrix @param V
-  std::array<AlignedBitVector, 128> u;
+  /// receiver's masks that are needed to construct matrix @param V, indexed by
+  /// chunk_id * 128 + row_id. The masks of a chunk are deleted after the chunk was processed.
+  std::vector<AlignedBitVector> u;
 
-  std::array<ReusablePromise<std::size_t>, 128> u_promises;
-  std::array<ReusableFuture<std::size_t>, 128> u_futures;
+  // number of received masks in each chunk
+  std::vector<std::size_t> number_of_received_us;
   std::mutex u_mutex;
-  std::size_t number_of_received_us{0};
+  std::condition_variable u_condition;
   // matrix of the OT extension scheme
   // XXX: can't we delete this after setup?
   std::shared_ptr<BitMatrix> V;
@@ -167,6 +188,12 @@ struct OtExtensionSenderData {
   // flag and condition variable: is setup is done?
   std::unique_ptr<FiberCondition> setup_finished_condition;
   std::atomic<bool> setup_finished{false};
+  // number of OTs whose outputs were already computed by the setup, grows chunk by chunk
+  std::atomic<std::size_t> number_of_ready_ots{0};
+
+  // silent OT: receiver's choice bit corrections for the single-point COTs, one per iteration
+  ReusablePromise<BitVector<>> silent_ot_corrections_promise;
+  ReusableFuture<BitVector<>> silent_ot_corrections_future;
 
   // XXX: unused
   std::atomic<std::size_t> consumed_offset{0};
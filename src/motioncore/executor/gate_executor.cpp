@@ -22,18 +22,29 @@
 
 #include "gate_executor.h"
 
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+
+#include <boost/core/demangle.hpp>
+
 #include "base/register.h"
 #include "protocols/gate.h"
+#include "protocols/wire.h"
 #include "statistics/run_time_statistics.h"
+#include "utility/fiber_condition.h"
 #include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 #include "utility/logger.h"
+#include "utility/typedefs.h"
 
 namespace encrypto::motion {
 
 GateExecutor::GateExecutor(Register& reg, std::function<void(void)> preprocessing_function,
+                           std::function<FiberThreadPool&()> fiber_pool_function,
                            std::shared_ptr<Logger> logger)
     : register_(reg),
       preprocessing_function_(std::move(preprocessing_function)),
+      fiber_pool_function_(std::move(fiber_pool_function)),
       logger_(std::move(logger)) {}
 
 void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
@@ -46,16 +57,23 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
         "Start evaluating the circuit gates sequentially (online after all finished setup)");
   }
 
-  // create a pool with std::thread::hardware_concurrency() no. of threads
-  // to execute fibers
-  FiberThreadPool fiber_pool(0, 2 * register_.GetTotalNumberOfGates());
+  // the long-lived pool of the backend executes the fibers
+  fiber_pool_ = &fiber_pool_function_();
+  setup_on_schedule_ = false;
+  if (profiling_) {
+    gate_profiles_.assign(register_.GetTotalNumberOfGates(), GateProfile{});
+  }
 
   // ------------------------------ setup phase ------------------------------
   statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesSetup>();
 
-  // Evaluate the setup phase of all the gates
+  // Evaluate the setup phase of all the gates, only the interactive ones need a fiber
   for (auto& gate : register_.GetGates()) {
-    fiber_pool.post([&] { gate->EvaluateSetup(); });
+    if (gate->GetGateType() == GateType::kNonInteractive) {
+      EvaluateSetup(*gate);
+    } else {
+      fiber_pool_->post([&] { EvaluateSetup(*gate); });
+    }
   }
   register_.GetGatesSetupDoneCondition()->Wait();
   assert(register_.GetNumberOfEvaluatedGateSetups() == register_.GetTotalNumberOfGates());
@@ -65,10 +83,8 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
   // ------------------------------ online phase ------------------------------
   statistics.RecordStart<RunTimeStatistics::StatisticsId::kGatesOnline>();
 
-  // Evaluate the online phase of all the gates
-  for (auto& gate : register_.GetGates()) {
-    fiber_pool.post([&] { gate->EvaluateOnline(); });
-  }
+  // Evaluate the online phase of the gates as soon as their parent wires are ready
+  ScheduleInitialGates();
   register_.GetGatesOnlineDoneCondition()->Wait();
   assert(register_.GetNumberOfEvaluatedGates() == register_.GetTotalNumberOfGates());
 
@@ -76,14 +92,14 @@ void GateExecutor::EvaluateSetupOnline(RunTimeStatistics& statistics) {
 
   // --------------------------------------------------------------------------
 
-  fiber_pool.join();
-
-  // XXX: since we never pop elements from the active queue, clear it manually for now
-  // otherwise there will be complains that it is not empty upon repeated execution
-  // -> maybe remove the active queue in the future
-  register_.ClearActiveQueue();
+  // the gates' fibers must have returned before the gates may be cleared
+  fiber_pool_->wait_idle();
+  fiber_pool_ = nullptr;
 
   statistics.RecordEnd<RunTimeStatistics::StatisticsId::kEvaluate>();
+  if (profiling_) {
+    AggregateProfiles(statistics);
+  }
 }
 
 void GateExecutor::Evaluate(RunTimeStatistics& statistics) {
@@ -95,31 +111,180 @@ void GateExecutor::Evaluate(RunTimeStatistics& statistics) {
   // Run preprocessing setup in a separate thread
   auto preprocessing_future = std::async(std::launch::async, [this] { preprocessing_function_(); });
 
-  // create a pool with std::thread::hardware_concurrency() no. of threads
-  // to execute fibers
-  FiberThreadPool fiber_pool(0, register_.GetTotalNumberOfGates());
+  // the long-lived pool of the backend executes the fibers
+  fiber_pool_ = &fiber_pool_function_();
+  setup_on_schedule_ = true;
+  if (profiling_) {
+    gate_profiles_.assign(register_.GetTotalNumberOfGates(), GateProfile{});
+  }
 
-  // Evaluate all the gates
+  // The setup phases of interactive gates may block, so they start right away in their own
+  // fibers.  Non-interactive gates evaluate both phases once they are scheduled.
   for (auto& gate : register_.GetGates()) {
-    fiber_pool.post([&] {
-      gate->EvaluateSetup();
-      // XXX: maybe insert a 'yield' here?
-      gate->EvaluateOnline();
-    });
+    if (gate->GetGateType() != GateType::kNonInteractive) {
+      fiber_pool_->post([&] { EvaluateSetup(*gate); });
+    }
   }
+  ScheduleInitialGates();
 
   preprocessing_future.get();
 
-  // we have to wait until all gates are evaluated before we close the pool
+  // we have to wait until all gates are evaluated and their fibers have returned
   register_.GetGatesOnlineDoneCondition()->Wait();
-  fiber_pool.join();
-
-  // XXX: since we never pop elements from the active queue, clear it manually for now
-  // otherwise there will be complains that it is not empty upon repeated execution
-  // -> maybe remove the active queue in the future
-  register_.ClearActiveQueue();
+  fiber_pool_->wait_idle();
+  fiber_pool_ = nullptr;
 
   statistics.RecordEnd<RunTimeStatistics::StatisticsId::kEvaluate>();
+  if (profiling_) {
+    AggregateProfiles(statistics);
+  }
+}
+
+void GateExecutor::Schedule(Gate& gate) {
+  assert(fiber_pool_ != nullptr);
+  if (gate.GetGateType() != GateType::kNonInteractive) {
+    fiber_pool_->post([this, &gate] { EvaluateOnline(gate); });
+    return;
+  }
+
+  // This fiber already evaluates gates inline, so just append the gate to its work list instead
+  // of recursing, which would overflow the small fiber stacks on long chains of gates.
+  if (auto* inline_gates = inline_gates_.get(); inline_gates != nullptr) {
+    inline_gates->push_back(&gate);
+    return;
+  }
+
+  std::vector<Gate*> inline_gates{&gate};
+  inline_gates_.reset(&inline_gates);
+  while (!inline_gates.empty()) {
+    auto* next_gate = inline_gates.back();
+    inline_gates.pop_back();
+    EvaluateScheduledGate(*next_gate);
+  }
+  inline_gates_.reset(nullptr);
+}
+
+void GateExecutor::ScheduleInitialGates() {
+  for (auto& gate : register_.GetGates()) {
+    if (!gate->HasWireDependencies()) {
+      Schedule(*gate);
+    }
+  }
+}
+
+void GateExecutor::EvaluateScheduledGate(Gate& gate) {
+  if (setup_on_schedule_) {
+    EvaluateSetup(gate);
+  }
+  EvaluateOnline(gate);
+}
+
+void GateExecutor::EvaluateSetup(Gate& gate) {
+  if (!profiling_) {
+    gate.EvaluateSetup();
+    return;
+  }
+  auto& profile = GetGateProfile(gate);
+  Profile([&gate] { gate.EvaluateSetup(); }, profile.setup_time, profile.setup_wait_time);
+}
+
+void GateExecutor::EvaluateOnline(Gate& gate) {
+  if (profiling_) {
+    auto& profile = GetGateProfile(gate);
+    Profile([&gate] { gate.EvaluateOnline(); }, profile.online_time, profile.online_wait_time);
+    profile.online_end = std::chrono::steady_clock::now();
+  } else {
+    gate.EvaluateOnline();
+  }
+  if (reclaim_wire_storage_) {
+    gate.ReleaseWireDependencies();
+  }
+}
+
+void GateExecutor::Profile(const std::function<void()>& phase, Duration& time,
+                           Duration& wait_time) {
+  auto* outer_nested_time = nested_time_.get();
+  auto* outer_wait_time = FiberCondition::GetWaitTimeRecorder();
+  Duration nested_time{0};
+  nested_time_.reset(&nested_time);
+  FiberCondition::SetWaitTimeRecorder(&wait_time);
+
+  const auto start = std::chrono::steady_clock::now();
+  phase();
+  const auto duration = std::chrono::steady_clock::now() - start;
+
+  FiberCondition::SetWaitTimeRecorder(outer_wait_time);
+  nested_time_.reset(outer_nested_time);
+  time += duration - nested_time;
+  if (outer_nested_time != nullptr) {
+    *outer_nested_time += duration;
+  }
+}
+
+GateExecutor::GateProfile& GateExecutor::GetGateProfile(const Gate& gate) {
+  return gate_profiles_[gate.GetId() - register_.GetGateIdOffset()];
+}
+
+void GateExecutor::AggregateProfiles(RunTimeStatistics& statistics) const {
+  const auto& gates = register_.GetGates();
+  const auto gate_id_offset = register_.GetGateIdOffset();
+
+  std::unordered_map<std::type_index, RunTimeStatistics::GateTypeStatistics> gate_types;
+  for (const auto& gate : gates) {
+    const auto& profile = gate_profiles_[gate->GetId() - gate_id_offset];
+    auto& gate_type = gate_types[std::type_index(typeid(*gate))];
+    ++gate_type.number_of_gates;
+    gate_type.setup_time += profile.setup_time;
+    gate_type.setup_wait_time += profile.setup_wait_time;
+    gate_type.online_time += profile.online_time;
+    gate_type.online_wait_time += profile.online_wait_time;
+  }
+  statistics.gate_types.clear();
+  for (const auto& [type, gate_type] : gate_types) {
+    statistics.gate_types.emplace(boost::core::demangle(type.name()), gate_type);
+  }
+
+  // A gate is in the layer of its deepest parent, interactive gates start a new layer.  Gates
+  // have larger ids than their parents.  The inputs of gates created within other gates are not
+  // output wires of any gate, so these count as direct successors of the inputs.
+  std::vector<const Gate*> gates_by_id(gates.size());
+  for (const auto& gate : gates) {
+    gates_by_id[gate->GetId() - gate_id_offset] = gate.get();
+  }
+  std::unordered_map<std::size_t, std::size_t> wire_layers;
+  statistics.layers.clear();
+  for (std::size_t i = 0; i < gates_by_id.size(); ++i) {
+    const auto* gate = gates_by_id[i];
+    std::size_t layer = 0;
+    for (const auto wire_id : gate->GetWireDependencies()) {
+      if (auto iterator = wire_layers.find(wire_id); iterator != wire_layers.end()) {
+        layer = std::max(layer, iterator->second);
+      }
+    }
+    if (gate->GetGateType() == GateType::kInteractive) {
+      ++layer;
+    }
+    for (const auto& wire : gate->GetOutputWires()) {
+      wire_layers[wire->GetWireId()] = layer;
+    }
+
+    if (statistics.layers.size() <= layer) {
+      statistics.layers.resize(layer + 1);
+    }
+    auto& layer_statistics = statistics.layers[layer];
+    ++layer_statistics.number_of_gates;
+    layer_statistics.online_end =
+        std::max(layer_statistics.online_end, gate_profiles_[i].online_end);
+  }
+
+  auto previous_end = statistics.Get(RunTimeStatistics::StatisticsId::kEvaluate).first;
+  for (auto& layer_statistics : statistics.layers) {
+    // a layer may finish before its predecessor if none of its gates waits for the last gate of
+    // the predecessor, it then does not lengthen the critical path
+    layer_statistics.online_end = std::max(layer_statistics.online_end, previous_end);
+    layer_statistics.critical_path_latency = layer_statistics.online_end - previous_end;
+    previous_end = layer_statistics.online_end;
+  }
 }
 
 }  // namespace encrypto::motion
@@ -22,20 +22,30 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <vector>
+
+#include <boost/fiber/fss.hpp>
 
 namespace encrypto::motion {
 
 struct RunTimeStatistics;
 
+class FiberThreadPool;
+class Gate;
 class Logger;
 class Register;
 
 // Evaluates all registered gates.
 class GateExecutor {
  public:
-  GateExecutor(Register&, std::function<void()> preprocessing_function, std::shared_ptr<Logger>);
+  // fiber_pool_function returns the pool the gates are evaluated in, which is
+  // reused across evaluations
+  GateExecutor(Register&, std::function<void()> preprocessing_function,
+               std::function<FiberThreadPool&()> fiber_pool_function, std::shared_ptr<Logger>);
 
   // Run the setup phases first for all gates before starting with the online
   // phases.
@@ -43,10 +53,67 @@ class GateExecutor {
   // Run setup and online phase of each gate as soon as possible.
   void Evaluate(RunTimeStatistics& statistics);
 
+  // Dispatch a gate whose parent wires are all online-ready.  Non-interactive
+  // gates are evaluated inline by the calling fiber, all other gates get a
+  // fiber of their own.
+  void Schedule(Gate& gate);
+
+  // If set, the values of a wire are released as soon as all gates waiting
+  // for it finished their online phase, see Wire::ReleaseConsumer.
+  void SetReclaimWireStorage(bool value) { reclaim_wire_storage_ = value; }
+
+  // If set, the setup and online time of each gate is measured and aggregated per gate type and
+  // per layer into the RunTimeStatistics of the evaluation.
+  void SetProfiling(bool value) { profiling_ = value; }
+
  private:
+  // Schedule the gates that do not depend on any wire.
+  void ScheduleInitialGates();
+
+  void EvaluateScheduledGate(Gate& gate);
+
+  void EvaluateSetup(Gate& gate);
+
+  // Evaluate the online phase of a gate and release the wires it consumed.
+  void EvaluateOnline(Gate& gate);
+
+  using Duration = std::chrono::steady_clock::duration;
+
+  struct GateProfile {
+    Duration setup_time{0}, setup_wait_time{0};
+    Duration online_time{0}, online_wait_time{0};
+    std::chrono::steady_clock::time_point online_end;
+  };
+
+  // Runs phase, which evaluates one phase of a gate, and adds its duration to time and the time
+  // it blocked in FiberCondition::Wait to wait_time.  Gates scheduled inline by phase are
+  // evaluated in a nested call, whose duration is not attributed to this gate.
+  void Profile(const std::function<void()>& phase, Duration& time, Duration& wait_time);
+
+  GateProfile& GetGateProfile(const Gate& gate);
+
+  void AggregateProfiles(RunTimeStatistics& statistics) const;
+
   Register& register_;
   std::function<void()> preprocessing_function_;
+  std::function<FiberThreadPool&()> fiber_pool_function_;
   std::shared_ptr<Logger> logger_;
+
+  // pool of the current evaluation
+  FiberThreadPool* fiber_pool_ = nullptr;
+  // whether non-interactive gates evaluate their setup phase when they are
+  // scheduled, i.e., the setup phases do not run before all online phases
+  std::atomic<bool> setup_on_schedule_ = false;
+  std::atomic<bool> reclaim_wire_storage_ = false;
+  std::atomic<bool> profiling_ = false;
+  // indexed by the gate id, each gate only writes to its own entry
+  std::vector<GateProfile> gate_profiles_;
+  // duration of the nested Profile calls of the phase profiled by the current fiber
+  boost::fibers::fiber_specific_ptr<Duration> nested_time_{[](Duration*) {}};
+  // gates which became ready while the current fiber evaluates gates inline;
+  // points to a vector on that fiber's stack, hence the no-op cleanup
+  boost::fibers::fiber_specific_ptr<std::vector<Gate*>> inline_gates_{
+      [](std::vector<Gate*>*) {}};
 };
 
 }  // namespace encrypto::motion
@@ -25,8 +25,11 @@
 #include "mt_provider.h"
 
 #include "oblivious_transfer/ot_flavors.h"
+#include "preprocessing_service.h"
+#include "preprocessing_store.h"
 #include "statistics/run_time_statistics.h"
 #include "utility/constants.h"
+#include "utility/linear_algebra.h"
 #include "utility/logger.h"
 
 namespace encrypto::motion {
@@ -34,7 +37,13 @@ namespace encrypto::motion {
 bool MtProvider::NeedMts() const noexcept {
   return 0 < (GetNumberOfMts<bool>() + GetNumberOfMts<std::uint8_t>() +
               GetNumberOfMts<std::uint16_t>() + GetNumberOfMts<std::uint32_t>() +
-              GetNumberOfMts<std::uint64_t>());
+              GetNumberOfMts<std::uint64_t>()) ||
+         NeedMatrixMts();
+}
+
+bool MtProvider::NeedMatrixMts() const noexcept {
+  return std::apply([](const auto&... matrix_mts) { return (!matrix_mts.empty() || ...); },
+                    matrix_mts_);
 }
 
 std::size_t MtProvider::RequestBinaryMts(const std::size_t number_of_mts) noexcept {
@@ -73,7 +82,15 @@ MtProviderFromOts::MtProviderFromOts(std::vector<std::unique_ptr<OtProvider>>& o
       bit_ots_receiver_(number_of_parties_),
       bit_ots_sender_(number_of_parties_),
       logger_(logger),
-      run_time_statistics_(run_time_statistics) {}
+      run_time_statistics_(run_time_statistics) {
+  std::apply(
+      [this](auto&... matrix_ots) {
+        ((matrix_ots.sender.resize(number_of_parties_),
+          matrix_ots.receiver.resize(number_of_parties_)),
+         ...);
+      },
+      matrix_ots_);
+}
 
 MtProviderFromOts::~MtProviderFromOts() = default;
 
@@ -123,6 +140,10 @@ void MtProviderFromOts::Setup() {
       bit_ots_receiver_.at(i)->SendCorrections();
       bit_ots_sender_.at(i)->SendMessages();
     }
+    SendMatrixOts<std::uint8_t>(i);
+    SendMatrixOts<std::uint16_t>(i);
+    SendMatrixOts<std::uint32_t>(i);
+    SendMatrixOts<std::uint64_t>(i);
   }
 
   ParseOutputs();
@@ -158,6 +179,16 @@ static void GenerateRandomTriples(IntegerMtVector<T>& mts, std::size_t number_of
   }
 }
 
+template <typename T>
+static void GenerateRandomMatrixTriples(std::vector<IntegerMatrixMt<T>>& matrix_mts) {
+  for (auto& mt : matrix_mts) {
+    mt.a = RandomVector<T>(mt.rows * mt.inner);
+    mt.b = RandomVector<T>(mt.inner * mt.columns);
+    mt.c.assign(mt.rows * mt.columns, 0);
+    MatrixMultiplyAccumulate(mt.rows, mt.inner, mt.columns, mt.a.data(), mt.b.data(), mt.c.data());
+  }
+}
+
 static void RegisterHelperBool(OtProvider& ot_provider, std::unique_ptr<XcOtBitSender>& ots_sender,
                                std::unique_ptr<XcOtBitReceiver>& ots_receiver,
                                const BinaryMtVector& bit_mts, std::size_t number_of_bit_mts) {
@@ -208,6 +239,95 @@ static void RegisterHelper(OtProvider& ot_provider,
   }
 }
 
+// The cross terms a_i * b_j of a matrix MT are computed with additively correlated OTs: for bit t
+// of entry (row, l) of a_i, party j inputs row l of b_j shifted by t as a vector correlation.
+template <typename T>
+void MtProviderFromOts::RegisterMatrixOts(std::size_t party_id) {
+  constexpr std::size_t bit_size = sizeof(T) * 8;
+  auto& ot_provider = *ot_providers_.at(party_id);
+  auto& matrix_ots = std::get<MatrixMtOts<T>>(matrix_ots_);
+
+  for (const auto& mt : std::get<std::vector<IntegerMatrixMt<T>>>(matrix_mts_)) {
+    const auto number_of_ots = mt.rows * mt.inner * bit_size;
+
+    auto ot_to_send = ot_provider.RegisterSendAcOt<T>(number_of_ots, mt.columns);
+    std::vector<T> correlations(number_of_ots * mt.columns);
+    for (auto row = 0ull; row < mt.rows; ++row) {
+      for (auto l = 0ull; l < mt.inner; ++l) {
+        const T* b_row = mt.b.data() + l * mt.columns;
+        for (auto bit_i = 0u; bit_i < bit_size; ++bit_i) {
+          T* correlation =
+              correlations.data() + ((row * mt.inner + l) * bit_size + bit_i) * mt.columns;
+          for (auto column = 0ull; column < mt.columns; ++column) {
+            correlation[column] = static_cast<T>(b_row[column] << bit_i);
+          }
+        }
+      }
+    }
+    ot_to_send->SetCorrelations(std::move(correlations));
+
+    auto ot_to_receive = ot_provider.RegisterReceiveAcOt<T>(number_of_ots, mt.columns);
+    BitVector<> choices;
+    choices.Reserve(BitsToBytes(number_of_ots));
+    for (const auto a_i : mt.a) {
+      for (auto bit_i = 0u; bit_i < bit_size; ++bit_i) {
+        choices.Append(((a_i >> bit_i) & 1u) == 1);
+      }
+    }
+    ot_to_receive->SetChoices(std::move(choices));
+
+    matrix_ots.sender.at(party_id).emplace_back(std::move(ot_to_send));
+    matrix_ots.receiver.at(party_id).emplace_back(std::move(ot_to_receive));
+  }
+}
+
+template <typename T>
+void MtProviderFromOts::SendMatrixOts(std::size_t party_id) {
+  auto& matrix_ots = std::get<MatrixMtOts<T>>(matrix_ots_);
+  for (auto& ot : matrix_ots.sender.at(party_id)) {
+    ot->WaitSetup();
+    ot->SendMessages();
+  }
+  for (auto& ot : matrix_ots.receiver.at(party_id)) {
+    ot->WaitSetup();
+    ot->SendCorrections();
+  }
+}
+
+template <typename T>
+void MtProviderFromOts::ParseMatrixOutputs(std::size_t party_id) {
+  constexpr std::size_t bit_size = sizeof(T) * 8;
+  auto& matrix_ots = std::get<MatrixMtOts<T>>(matrix_ots_);
+  auto& matrix_mts = std::get<std::vector<IntegerMatrixMt<T>>>(matrix_mts_);
+  assert(matrix_ots.sender.at(party_id).size() == matrix_mts.size());
+  assert(matrix_ots.receiver.at(party_id).size() == matrix_mts.size());
+
+  for (auto mt_i = 0ull; mt_i < matrix_mts.size(); ++mt_i) {
+    auto& mt = matrix_mts.at(mt_i);
+    auto& ot_to_send = matrix_ots.sender.at(party_id).at(mt_i);
+    auto& ot_to_receive = matrix_ots.receiver.at(party_id).at(mt_i);
+    ot_to_send->ComputeOutputs();
+    ot_to_receive->ComputeOutputs();
+    const auto& output_sender = ot_to_send->GetOutputs();
+    const auto& output_receiver = ot_to_receive->GetOutputs();
+
+    // the receiver's outputs sum up to our a times their b plus the sender's outputs, which sum
+    // up to their a times our b minus the cross term
+    for (auto row = 0ull; row < mt.rows; ++row) {
+      T* __restrict__ c_row = mt.c.data() + row * mt.columns;
+      for (auto ot_i = row * mt.inner * bit_size; ot_i < (row + 1) * mt.inner * bit_size; ++ot_i) {
+        const T* __restrict__ receiver_row = output_receiver.data() + ot_i * mt.columns;
+        const T* __restrict__ sender_row = output_sender.data() + ot_i * mt.columns;
+        for (auto column = 0ull; column < mt.columns; ++column) {
+          c_row[column] += receiver_row[column] - sender_row[column];
+        }
+      }
+    }
+  }
+  matrix_ots.sender.at(party_id).clear();
+  matrix_ots.receiver.at(party_id).clear();
+}
+
 void MtProviderFromOts::RegisterOts() {
   if (number_of_bit_mts_ > 0) {
     GenerateRandomTriplesBool(bit_mts_, number_of_bit_mts_);
@@ -216,6 +336,8 @@ void MtProviderFromOts::RegisterOts() {
   GenerateRandomTriples<std::uint16_t>(mts16_, number_of_mts_16_);
   GenerateRandomTriples<std::uint32_t>(mts32_, number_of_mts_32_);
   GenerateRandomTriples<std::uint64_t>(mts64_, number_of_mts_64_);
+  std::apply([](auto&... matrix_mts) { (GenerateRandomMatrixTriples(matrix_mts), ...); },
+             matrix_mts_);
 
 #pragma omp parallel for num_threads(number_of_parties_)
   for (auto i = 0ull; i < number_of_parties_; ++i) {
@@ -235,6 +357,10 @@ void MtProviderFromOts::RegisterOts() {
                                   kMaxBatchSize, mts32_, number_of_mts_32_);
     RegisterHelper<std::uint64_t>(*ot_providers_.at(i), ots_sender_.at(i), ots_receiver_.at(i),
                                   kMaxBatchSize, mts64_, number_of_mts_64_);
+    RegisterMatrixOts<std::uint8_t>(i);
+    RegisterMatrixOts<std::uint16_t>(i);
+    RegisterMatrixOts<std::uint32_t>(i);
+    RegisterMatrixOts<std::uint64_t>(i);
   }
 }
 
@@ -293,10 +419,85 @@ void MtProviderFromOts::ParseOutputs() {
                                number_of_mts_32_);
     ParseHelper<std::uint64_t>(ots_sender_.at(i), ots_receiver_.at(i), kMaxBatchSize, mts64_,
                                number_of_mts_64_);
+    ParseMatrixOutputs<std::uint8_t>(i);
+    ParseMatrixOutputs<std::uint16_t>(i);
+    ParseMatrixOutputs<std::uint32_t>(i);
+    ParseMatrixOutputs<std::uint64_t>(i);
 
     assert(ots_sender_.at(i).empty());
     assert(ots_receiver_.at(i).empty());
   }
 }
 
+MtProviderFromStore::MtProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::shared_ptr<PreprocessingService> service,
+                                         const std::size_t my_id,
+                                         const std::size_t number_of_parties, Logger& logger,
+                                         RunTimeStatistics& run_time_statistics)
+    : MtProvider(my_id, number_of_parties),
+      store_(std::move(store)),
+      service_(std::move(service)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+MtProviderFromStore::~MtProviderFromStore() = default;
+
+void MtProviderFromStore::Reserve(PreprocessingMaterial material,
+                                  std::size_t number_of_elements) {
+  if (service_) {
+    service_->Reserve(material, number_of_elements);
+  } else {
+    store_->CheckAvailable(material, number_of_elements);
+  }
+}
+
+void MtProviderFromStore::PreSetup() {
+  if (!NeedMts()) {
+    return;
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kMtPresetup>();
+
+  if (NeedMatrixMts()) {
+    throw std::runtime_error("Matrix MTs are not supported by the preprocessing store");
+  }
+
+  Reserve(PreprocessingMaterial::kBinaryMt, number_of_bit_mts_);
+  Reserve(PreprocessingMaterial::kMt8, number_of_mts_8_);
+  Reserve(PreprocessingMaterial::kMt16, number_of_mts_16_);
+  Reserve(PreprocessingMaterial::kMt32, number_of_mts_32_);
+  Reserve(PreprocessingMaterial::kMt64, number_of_mts_64_);
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kMtPresetup>();
+}
+
+void MtProviderFromStore::Setup() {
+  if (!NeedMts()) {
+    return;
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading MTs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kMtSetup>();
+
+  if (number_of_bit_mts_ > 0) {
+    bit_mts_ = store_->ConsumeBinaryMts(number_of_bit_mts_);
+  }
+  mts8_ = store_->ConsumeMts<std::uint8_t>(number_of_mts_8_);
+  mts16_ = store_->ConsumeMts<std::uint16_t>(number_of_mts_16_);
+  mts32_ = store_->ConsumeMts<std::uint32_t>(number_of_mts_32_);
+  mts64_ = store_->ConsumeMts<std::uint64_t>(number_of_mts_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kMtSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading MTs from the preprocessing store");
+  }
+}
+
 }  // namespace encrypto::motion
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <list>
+#include <tuple>
 
 #include "oblivious_transfer/ot_provider.h"
 #include "utility/bit_vector.h"
@@ -35,12 +36,22 @@ namespace encrypto::motion {
 
 struct RunTimeStatistics;
 class Logger;
+class PreprocessingStore;
+class PreprocessingService;
+enum class PreprocessingMaterial : std::uint32_t;
 
 template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
 struct IntegerMtVector {
   std::vector<T> a, b, c;  // c[i] = a[i] * b[i]
 };
 
+/// \brief Beaver triple for a matrix multiplication, all matrices are stored in row-major order.
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+struct IntegerMatrixMt {
+  std::size_t rows, inner, columns;
+  std::vector<T> a, b, c;  // c = a * b, where a is rows x inner and b is inner x columns
+};
+
 struct BinaryMtVector {
   BitVector<> a, b, c;  // c[i] = a[i] ^ b[i]
 };
@@ -91,6 +102,17 @@ class MtProvider {
     return offset;
   }
 
+  /// \brief Requests an MT for multiplying a \p rows x \p inner matrix by an \p inner x \p columns
+  ///        matrix. Its generation needs rows * inner * bit length OTs of columns values each.
+  /// \returns the id of the matrix MT for GetArithmeticMatrixMt
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::size_t RequestArithmeticMatrixMt(const std::size_t rows, const std::size_t inner,
+                                        const std::size_t columns) {
+    auto& matrix_mts = std::get<std::vector<IntegerMatrixMt<T>>>(matrix_mts_);
+    matrix_mts.push_back(IntegerMatrixMt<T>{rows, inner, columns, {}, {}, {}});
+    return matrix_mts.size() - 1;
+  }
+
   // get bits [i, i+n] as vector
   BinaryMtVector GetBinary(const std::size_t offset, const std::size_t n = 1) const;
 
@@ -128,6 +150,12 @@ class MtProvider {
     }
   }
 
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  const IntegerMatrixMt<T>& GetArithmeticMatrixMt(const std::size_t id) const {
+    WaitFinished();
+    return std::get<std::vector<IntegerMatrixMt<T>>>(matrix_mts_).at(id);
+  }
+
   virtual void PreSetup() = 0;
   virtual void Setup() = 0;
 
@@ -148,6 +176,14 @@ class MtProvider {
   IntegerMtVector<std::uint32_t> mts32_;
   IntegerMtVector<std::uint64_t> mts64_;
 
+  std::tuple<std::vector<IntegerMatrixMt<std::uint8_t>>,
+             std::vector<IntegerMatrixMt<std::uint16_t>>,
+             std::vector<IntegerMatrixMt<std::uint32_t>>,
+             std::vector<IntegerMatrixMt<std::uint64_t>>>
+      matrix_mts_;
+
+  bool NeedMatrixMts() const noexcept;
+
   const std::size_t my_id_;
   const std::size_t number_of_parties_;
 
@@ -184,6 +220,15 @@ class MtProviderFromOts final : public MtProvider {
 
   void ParseOutputs();
 
+  template <typename T>
+  void RegisterMatrixOts(std::size_t party_id);
+
+  template <typename T>
+  void SendMatrixOts(std::size_t party_id);
+
+  template <typename T>
+  void ParseMatrixOutputs(std::size_t party_id);
+
   std::vector<std::unique_ptr<OtProvider>>& ot_providers_;
 
   // use alternating party roles for load balancing
@@ -192,6 +237,16 @@ class MtProviderFromOts final : public MtProvider {
   std::vector<std::unique_ptr<XcOtBitReceiver>> bit_ots_receiver_;
   std::vector<std::unique_ptr<XcOtBitSender>> bit_ots_sender_;
 
+  // parties X matrix MTs, one batch of vector OTs per matrix MT and direction
+  template <typename T>
+  struct MatrixMtOts {
+    std::vector<std::vector<std::unique_ptr<AcOtSender<T>>>> sender;
+    std::vector<std::vector<std::unique_ptr<AcOtReceiver<T>>>> receiver;
+  };
+  std::tuple<MatrixMtOts<std::uint8_t>, MatrixMtOts<std::uint16_t>, MatrixMtOts<std::uint32_t>,
+             MatrixMtOts<std::uint64_t>>
+      matrix_ots_;
+
   // Should be divisible by 128
   static inline constexpr std::size_t kMaxBatchSize{128 * 128};
 
@@ -199,4 +254,32 @@ class MtProviderFromOts final : public MtProvider {
   RunTimeStatistics& run_time_statistics_;
 };
 
+/// \brief Takes the MTs from a PreprocessingStore filled by an earlier generation job, such that
+/// the setup phase only reads the MTs instead of computing them via OTs.
+class MtProviderFromStore final : public MtProvider {
+ public:
+  /// \brief Reserves the MTs at service before consuming them if service is not null.
+  MtProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                      std::shared_ptr<PreprocessingService> service, const std::size_t my_id,
+                      const std::size_t number_of_parties, Logger& logger,
+                      RunTimeStatistics& run_time_statistics);
+  ~MtProviderFromStore();
+
+  // checks that the store holds enough MTs or reserves them at the service
+  // throws std::runtime_error if matrix MTs were requested, which the store does not hold
+  void PreSetup() final override;
+
+  void Setup() final override;
+
+ private:
+  // reserves the material at service_ if there is one, otherwise checks that store_ holds it
+  void Reserve(PreprocessingMaterial material, std::size_t number_of_elements);
+
+  std::shared_ptr<PreprocessingStore> store_;
+  std::shared_ptr<PreprocessingService> service_;
+
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
 }  // namespace encrypto::motion
@@ -0,0 +1,170 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "preprocessing_service.h"
+
+#include <stdexcept>
+
+#include "base/backend.h"
+#include "base/party.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+std::size_t& GetAmount(PreprocessingAmounts& amounts, PreprocessingMaterial material) {
+  switch (material) {
+    case PreprocessingMaterial::kBinaryMt:
+      return amounts.number_of_binary_mts;
+    case PreprocessingMaterial::kMt8:
+      return amounts.number_of_mts_8;
+    case PreprocessingMaterial::kMt16:
+      return amounts.number_of_mts_16;
+    case PreprocessingMaterial::kMt32:
+      return amounts.number_of_mts_32;
+    case PreprocessingMaterial::kMt64:
+      return amounts.number_of_mts_64;
+    case PreprocessingMaterial::kSp8:
+      return amounts.number_of_sps_8;
+    case PreprocessingMaterial::kSp16:
+      return amounts.number_of_sps_16;
+    case PreprocessingMaterial::kSp32:
+      return amounts.number_of_sps_32;
+    case PreprocessingMaterial::kSp64:
+      return amounts.number_of_sps_64;
+    case PreprocessingMaterial::kSp128:
+      return amounts.number_of_sps_128;
+    case PreprocessingMaterial::kSb8:
+      return amounts.number_of_sbs_8;
+    case PreprocessingMaterial::kSb16:
+      return amounts.number_of_sbs_16;
+    case PreprocessingMaterial::kSb32:
+      return amounts.number_of_sbs_32;
+    case PreprocessingMaterial::kSb64:
+      return amounts.number_of_sbs_64;
+    default:
+      throw std::invalid_argument("Invalid PreprocessingMaterial");
+  }
+}
+
+}  // namespace
+
+PreprocessingService::PreprocessingService(std::shared_ptr<PreprocessingStore> store,
+                                           PartyFactory party_factory,
+                                           const PreprocessingAmounts& low_watermarks,
+                                           const PreprocessingAmounts& high_watermarks)
+    : store_(std::move(store)), party_factory_(std::move(party_factory)) {
+  auto low{low_watermarks}, high{high_watermarks};
+  for (std::size_t i = 0; i < kNumberOfMaterials; ++i) {
+    const auto material{static_cast<PreprocessingMaterial>(i)};
+    low_watermarks_[i] = GetAmount(low, material);
+    high_watermarks_[i] = GetAmount(high, material);
+    if (low_watermarks_[i] > high_watermarks_[i]) {
+      throw std::invalid_argument("The low watermarks must not exceed the high watermarks");
+    }
+    projected_amounts_[i] = store_->GetNumberOfAvailable(material);
+  }
+  worker_ = std::thread([this] { Run(); });
+}
+
+PreprocessingService::~PreprocessingService() {
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  worker_.join();
+}
+
+void PreprocessingService::Start() {
+  PreprocessingAmounts refill;
+  bool need_refill{false};
+  {
+    std::scoped_lock lock(mutex_);
+    for (std::size_t i = 0; i < kNumberOfMaterials; ++i) {
+      if (projected_amounts_[i] < high_watermarks_[i]) {
+        const auto material{static_cast<PreprocessingMaterial>(i)};
+        const auto amount{high_watermarks_[i] - projected_amounts_[i]};
+        GetAmount(refill, material) = amount;
+        projected_amounts_[i] += amount;
+        need_refill = true;
+      }
+    }
+    if (need_refill) refills_.push_back(refill);
+  }
+  condition_.notify_all();
+}
+
+void PreprocessingService::Reserve(PreprocessingMaterial material,
+                                   std::size_t number_of_elements) {
+  if (number_of_elements == 0) return;
+  const auto i{static_cast<std::size_t>(material)};
+  std::unique_lock lock(mutex_);
+  auto& projected{projected_amounts_.at(i)};
+  // refill the reservation that exceeds the projected amount and everything up to the high
+  // watermark, if the rest falls below the low watermark
+  const auto missing{number_of_elements > projected ? number_of_elements - projected : 0};
+  const auto rest{projected + missing - number_of_elements};
+  if (missing > 0 || rest < low_watermarks_[i]) {
+    PreprocessingAmounts refill;
+    const auto amount{missing + std::max(high_watermarks_[i], rest) - rest};
+    GetAmount(refill, material) = amount;
+    projected += amount;
+    refills_.push_back(refill);
+    condition_.notify_all();
+  }
+  projected -= number_of_elements;
+
+  condition_.wait(lock, [this, material, number_of_elements] {
+    return error_ || store_->GetNumberOfAvailable(material) >= number_of_elements;
+  });
+  if (error_) std::rethrow_exception(error_);
+}
+
+void PreprocessingService::Run() {
+  while (true) {
+    PreprocessingAmounts refill;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this] { return stop_ || !refills_.empty(); });
+      if (refills_.empty() || error_) return;
+      refill = refills_.front();
+    }
+    try {
+      auto party{party_factory_()};
+      party->GetBackend()->GeneratePreprocessing(*store_, refill);
+      party->Finish();
+    } catch (...) {
+      std::scoped_lock lock(mutex_);
+      error_ = std::current_exception();
+    }
+    {
+      std::scoped_lock lock(mutex_);
+      refills_.pop_front();
+    }
+    condition_.notify_all();
+  }
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "preprocessing_store.h"
+
+namespace encrypto::motion {
+
+class Party;
+
+/// \brief Long-lived producer that keeps the material in a PreprocessingStore between a low and a
+/// high watermark. Online jobs reserve material before consuming it from the store (see
+/// Backend::SetPreprocessingService). Whenever a reservation leaves less than the low watermark,
+/// a refill up to the high watermark is queued and computed by a background thread, while the
+/// online jobs continue to consume what is already stored. Thus, the preprocessing of the next
+/// query is usually done when the query arrives.
+///
+/// All parties need to run services with the same watermarks and reserve the same amounts in the
+/// same order, i.e., evaluate the same circuits. Then, all services queue the same refills, which
+/// only depend on the reservations and not on the timing of the background threads.
+class PreprocessingService {
+ public:
+  /// \brief Creates a Party connected to the other parties' services for one refill. The parties
+  /// of the services need to be created pairwise in the same order.
+  using PartyFactory = std::function<std::unique_ptr<Party>()>;
+
+  PreprocessingService(std::shared_ptr<PreprocessingStore> store, PartyFactory party_factory,
+                       const PreprocessingAmounts& low_watermarks,
+                       const PreprocessingAmounts& high_watermarks);
+
+  /// \brief Computes the queued refills, since the other parties' services expect them, and
+  /// stops the background thread.
+  ~PreprocessingService();
+
+  PreprocessingService(const PreprocessingService&) = delete;
+  PreprocessingService& operator=(const PreprocessingService&) = delete;
+
+  /// \brief Queues the refill of the (initially empty) store up to the high watermarks.
+  void Start();
+
+  /// \brief Reserves number_of_elements MTs, SPs or SBs of type material for the next
+  /// consumption and blocks until the store holds them. Queues a refill if the reservation leaves
+  /// less than the low watermark of material.
+  /// \throws the exception of a failed refill.
+  void Reserve(PreprocessingMaterial material, std::size_t number_of_elements);
+
+  const std::shared_ptr<PreprocessingStore>& GetStore() const noexcept { return store_; }
+
+ private:
+  static constexpr std::size_t kNumberOfMaterials{
+      static_cast<std::size_t>(PreprocessingMaterial::kInvalid)};
+
+  // computes the queued refills
+  void Run();
+
+  std::shared_ptr<PreprocessingStore> store_;
+  PartyFactory party_factory_;
+  std::array<std::size_t, kNumberOfMaterials> low_watermarks_;
+  std::array<std::size_t, kNumberOfMaterials> high_watermarks_;
+  // stored plus queued minus reserved material
+  std::array<std::size_t, kNumberOfMaterials> projected_amounts_{};
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<PreprocessingAmounts> refills_;
+  bool stop_{false};
+  std::exception_ptr error_;
+  std::thread worker_;
+};
+
+}  // namespace encrypto::motion
@@ -0,0 +1,359 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "preprocessing_store.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace encrypto::motion {
+
+static_assert(std::endian::native == std::endian::little,
+              "the preprocessing store is only supported on little-endian platforms");
+
+namespace {
+
+constexpr std::array<std::string_view, static_cast<std::size_t>(PreprocessingMaterial::kInvalid)>
+    kMaterialNames{"binary_mts", "mts_8",  "mts_16",  "mts_32", "mts_64", "sps_8",  "sps_16",
+                   "sps_32",     "sps_64", "sps_128", "sbs_8",  "sbs_16", "sbs_32", "sbs_64"};
+
+constexpr std::size_t GetRecordSize(PreprocessingMaterial material) {
+  switch (material) {
+    case PreprocessingMaterial::kBinaryMt:
+      return 1;
+    case PreprocessingMaterial::kMt8:
+      return 3 * sizeof(std::uint8_t);
+    case PreprocessingMaterial::kMt16:
+      return 3 * sizeof(std::uint16_t);
+    case PreprocessingMaterial::kMt32:
+      return 3 * sizeof(std::uint32_t);
+    case PreprocessingMaterial::kMt64:
+      return 3 * sizeof(std::uint64_t);
+    case PreprocessingMaterial::kSp8:
+      return 2 * sizeof(std::uint8_t);
+    case PreprocessingMaterial::kSp16:
+      return 2 * sizeof(std::uint16_t);
+    case PreprocessingMaterial::kSp32:
+      return 2 * sizeof(std::uint32_t);
+    case PreprocessingMaterial::kSp64:
+      return 2 * sizeof(std::uint64_t);
+    case PreprocessingMaterial::kSp128:
+      return 2 * sizeof(__uint128_t);
+    case PreprocessingMaterial::kSb8:
+      return sizeof(std::uint8_t);
+    case PreprocessingMaterial::kSb16:
+      return sizeof(std::uint16_t);
+    case PreprocessingMaterial::kSb32:
+      return sizeof(std::uint32_t);
+    case PreprocessingMaterial::kSb64:
+      return sizeof(std::uint64_t);
+    default:
+      throw std::invalid_argument("Invalid PreprocessingMaterial");
+  }
+}
+
+}  // namespace
+
+// a memory-mapped file holding the records of one kind of material
+class PreprocessingStore::File {
+ public:
+  File(const std::string& path, PreprocessingMaterial material, std::size_t my_id,
+       std::size_t number_of_parties)
+      : path_(path) {
+    file_descriptor_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+    if (file_descriptor_ < 0) {
+      throw std::runtime_error(fmt::format("Could not open preprocessing store file {}", path));
+    }
+    // another job consuming from the same file would reuse material
+    if (::flock(file_descriptor_, LOCK_EX | LOCK_NB) != 0) {
+      ::close(file_descriptor_);
+      throw std::runtime_error(
+          fmt::format("Preprocessing store file {} is used by another process", path));
+    }
+    struct stat file_status;
+    if (::fstat(file_descriptor_, &file_status) != 0) {
+      ::close(file_descriptor_);
+      throw std::runtime_error(fmt::format("Could not access preprocessing store file {}", path));
+    }
+    if (file_status.st_size == 0) {
+      PreprocessingFileHeader header;
+      header.magic = kPreprocessingStoreMagic;
+      header.version = kPreprocessingStoreVersion;
+      header.material = static_cast<std::uint32_t>(material);
+      header.my_id = my_id;
+      header.number_of_parties = number_of_parties;
+      header.generation_id = 0;
+      header.record_size = GetRecordSize(material);
+      header.number_of_records = 0;
+      header.number_of_consumed_records = 0;
+      WriteAll(reinterpret_cast<const std::byte*>(&header), sizeof(header), 0);
+      Sync();
+    } else if (static_cast<std::size_t>(file_status.st_size) < sizeof(PreprocessingFileHeader)) {
+      ::close(file_descriptor_);
+      throw std::runtime_error(fmt::format("{} is not a preprocessing store file", path));
+    }
+    try {
+      Map();
+    } catch (...) {
+      ::close(file_descriptor_);
+      throw;
+    }
+
+    const auto& header{GetHeader()};
+    const auto invalid = [this](std::string_view reason) {
+      Unmap();
+      ::close(file_descriptor_);
+      return std::runtime_error(
+          fmt::format("Invalid preprocessing store file {}: {}", path_, reason));
+    };
+    if (header.magic != kPreprocessingStoreMagic) throw invalid("wrong magic number");
+    if (header.version != kPreprocessingStoreVersion) {
+      throw invalid(fmt::format("unsupported version {}", header.version));
+    }
+    if (header.material != static_cast<std::uint32_t>(material) ||
+        header.record_size != GetRecordSize(material)) {
+      throw invalid("wrong kind of material");
+    }
+    if (header.my_id != my_id || header.number_of_parties != number_of_parties) {
+      throw invalid(fmt::format("created for party {} of {}", header.my_id,
+                                header.number_of_parties));
+    }
+    if (header.number_of_consumed_records > header.number_of_records ||
+        header.number_of_records > (size_ - sizeof(header)) / header.record_size) {
+      throw invalid("inconsistent header");
+    }
+  }
+
+  ~File() {
+    Unmap();
+    ::close(file_descriptor_);
+  }
+
+  std::size_t GetNumberOfAvailableRecords() const {
+    const auto& header{GetHeader()};
+    return header.number_of_records - header.number_of_consumed_records;
+  }
+
+  PreprocessingFileState GetState() const {
+    const auto& header{GetHeader()};
+    return {header.generation_id, header.number_of_records, header.number_of_consumed_records};
+  }
+
+  void SetGenerationId(std::uint64_t generation_id) {
+    if (GetHeader().generation_id != 0) {
+      throw std::logic_error(
+          fmt::format("Preprocessing store file {} already has a generation ID", path_));
+    }
+    GetHeader().generation_id = generation_id;
+    SyncHeader();
+  }
+
+  void Append(std::span<const std::byte> records, std::size_t number_of_records) {
+    const auto& header{GetHeader()};
+    assert(records.size() == number_of_records * header.record_size);
+    const std::size_t offset{sizeof(header) + header.number_of_records * header.record_size};
+    WriteAll(records.data(), records.size(), offset);
+    // the records need to be on disk before the header accounts for them
+    Sync();
+    Unmap();
+    Map();
+    GetHeader().number_of_records += number_of_records;
+    SyncHeader();
+  }
+
+  void Consume(std::size_t number_of_records,
+               const std::function<void(std::span<const std::byte>)>& read) {
+    auto& header{GetHeader()};
+    if (number_of_records > GetNumberOfAvailableRecords()) {
+      throw std::runtime_error(
+          fmt::format("Preprocessing store file {} holds only {} records, but {} are required",
+                      path_, GetNumberOfAvailableRecords(), number_of_records));
+    }
+    const std::size_t offset{sizeof(header) +
+                             header.number_of_consumed_records * header.record_size};
+    header.number_of_consumed_records += number_of_records;
+    SyncHeader();
+    read(std::span(static_cast<const std::byte*>(data_) + offset,
+                   number_of_records * header.record_size));
+  }
+
+ private:
+  PreprocessingFileHeader& GetHeader() const {
+    return *reinterpret_cast<PreprocessingFileHeader*>(data_);
+  }
+
+  void WriteAll(const std::byte* data, std::size_t size, std::size_t offset) {
+    while (size > 0) {
+      const auto written{::pwrite(file_descriptor_, data, size, offset)};
+      if (written <= 0) {
+        throw std::runtime_error(
+            fmt::format("Could not write to preprocessing store file {}", path_));
+      }
+      data += written;
+      size -= written;
+      offset += written;
+    }
+  }
+
+  void Sync() {
+    if (::fdatasync(file_descriptor_) != 0) {
+      throw std::runtime_error(fmt::format("Could not sync preprocessing store file {}", path_));
+    }
+  }
+
+  void SyncHeader() {
+    if (::msync(data_, sizeof(PreprocessingFileHeader), MS_SYNC) != 0) {
+      throw std::runtime_error(fmt::format("Could not sync preprocessing store file {}", path_));
+    }
+  }
+
+  void Map() {
+    struct stat file_status;
+    if (::fstat(file_descriptor_, &file_status) != 0) {
+      throw std::runtime_error(fmt::format("Could not access preprocessing store file {}", path_));
+    }
+    size_ = file_status.st_size;
+    data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+    if (data_ == MAP_FAILED) {
+      data_ = nullptr;
+      throw std::runtime_error(fmt::format("Could not map preprocessing store file {}", path_));
+    }
+  }
+
+  void Unmap() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+    }
+  }
+
+  const std::string path_;
+  int file_descriptor_{-1};
+  void* data_{nullptr};
+  std::size_t size_{0};
+};
+
+PreprocessingStore::PreprocessingStore(const std::string& directory, std::size_t my_id,
+                                       std::size_t number_of_parties)
+    : directory_(directory), my_id_(my_id), number_of_parties_(number_of_parties) {
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    throw std::runtime_error(fmt::format("Could not create preprocessing store directory {}: {}",
+                                         directory_, error.message()));
+  }
+}
+
+PreprocessingStore::~PreprocessingStore() = default;
+
+std::size_t PreprocessingStore::GetNumberOfAvailable(PreprocessingMaterial material) {
+  std::scoped_lock lock(mutex_);
+  return GetFile(material).GetNumberOfAvailableRecords();
+}
+
+void PreprocessingStore::CheckAvailable(PreprocessingMaterial material,
+                                        std::size_t number_of_elements) {
+  if (const auto available{GetNumberOfAvailable(material)}; available < number_of_elements) {
+    throw std::runtime_error(
+        fmt::format("Preprocessing store holds only {} {}, but {} are required", available,
+                    kMaterialNames.at(static_cast<std::size_t>(material)), number_of_elements));
+  }
+}
+
+PreprocessingFileState PreprocessingStore::GetState(PreprocessingMaterial material) {
+  std::scoped_lock lock(mutex_);
+  return GetFile(material).GetState();
+}
+
+void PreprocessingStore::SetGenerationId(PreprocessingMaterial material,
+                                         std::uint64_t generation_id) {
+  std::scoped_lock lock(mutex_);
+  GetFile(material).SetGenerationId(generation_id);
+}
+
+void PreprocessingStore::AppendBinaryMts(const BinaryMtVector& mts, std::size_t number_of_mts) {
+  assert(number_of_mts <= mts.a.GetSize());
+  // one record per MT, such that exactly the appended MTs are handed out and never any padding
+  std::vector<std::byte> records(number_of_mts);
+  for (std::size_t i = 0; i < number_of_mts; ++i) {
+    records[i] = static_cast<std::byte>(mts.a.Get(i) | (mts.b.Get(i) << 1) | (mts.c.Get(i) << 2));
+  }
+  Append(PreprocessingMaterial::kBinaryMt, records, number_of_mts);
+}
+
+BinaryMtVector PreprocessingStore::ConsumeBinaryMts(std::size_t number_of_mts) {
+  if (number_of_mts == 0) return {};
+  BinaryMtVector mts{BitVector<>(number_of_mts), BitVector<>(number_of_mts),
+                     BitVector<>(number_of_mts)};
+  Consume(PreprocessingMaterial::kBinaryMt, number_of_mts,
+          [&mts](std::span<const std::byte> records) {
+            for (std::size_t i = 0; i < records.size(); ++i) {
+              const auto record{std::to_integer<unsigned>(records[i])};
+              mts.a.Set(record & 1, i);
+              mts.b.Set((record >> 1) & 1, i);
+              mts.c.Set((record >> 2) & 1, i);
+            }
+          });
+  return mts;
+}
+
+PreprocessingStore::File& PreprocessingStore::GetFile(PreprocessingMaterial material) {
+  const auto index{static_cast<std::size_t>(material)};
+  if (index >= files_.size()) {
+    throw std::invalid_argument("Invalid PreprocessingMaterial");
+  }
+  if (!files_[index]) {
+    const auto path{fmt::format("{}/{}_{}_of_{}.mpp", directory_, kMaterialNames[index], my_id_,
+                                number_of_parties_)};
+    files_[index] = std::make_unique<File>(path, material, my_id_, number_of_parties_);
+  }
+  return *files_[index];
+}
+
+void PreprocessingStore::Append(PreprocessingMaterial material,
+                                std::span<const std::byte> records,
+                                std::size_t number_of_records) {
+  if (number_of_records == 0) return;
+  std::scoped_lock lock(mutex_);
+  GetFile(material).Append(records, number_of_records);
+}
+
+void PreprocessingStore::Consume(PreprocessingMaterial material, std::size_t number_of_records,
+                                 const std::function<void(std::span<const std::byte>)>& read) {
+  if (number_of_records == 0) return;
+  std::scoped_lock lock(mutex_);
+  GetFile(material).Consume(number_of_records, read);
+}
+
+}  // namespace encrypto::motion
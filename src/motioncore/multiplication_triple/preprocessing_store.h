@@ -0,0 +1,280 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mt_provider.h"
+#include "sp_provider.h"
+
+namespace encrypto::motion {
+
+// Preprocessing store file format, one file per kind of material, all values are little-endian:
+// PreprocessingFileHeader
+// records[number_of_records]   *** a record holds a_i, b_i, c_i of one MT, a_i, c_i of one SP, or
+//                                  one SB; a binary MT is one byte with a_i, b_i, c_i in bits 0-2
+
+constexpr std::array<char, 8> kPreprocessingStoreMagic{'M', 'O', 'T', 'I', 'O', 'N', 'P', 'P'};
+constexpr std::uint32_t kPreprocessingStoreVersion{3};
+
+enum class PreprocessingMaterial : std::uint32_t {
+  kBinaryMt = 0,
+  kMt8,
+  kMt16,
+  kMt32,
+  kMt64,
+  kSp8,
+  kSp16,
+  kSp32,
+  kSp64,
+  kSp128,
+  kSb8,
+  kSb16,
+  kSb32,
+  kSb64,
+  kInvalid  // for checking whether the value is valid
+};
+
+struct PreprocessingFileHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t material;  // PreprocessingMaterial
+  std::uint64_t my_id;
+  std::uint64_t number_of_parties;
+  // random ID that all parties agree on when their files are filled for the first time, such that
+  // the files of different parties can be matched, 0 if no generation job assigned one yet
+  std::uint64_t generation_id;
+  std::uint64_t record_size;
+  std::uint64_t number_of_records;
+  // persisted before any consumed record is handed out, such that no record is ever used twice
+  std::uint64_t number_of_consumed_records;
+};
+
+static_assert(sizeof(PreprocessingFileHeader) == 64);
+
+/// \brief The part of a file header that needs to match the ones of the other parties' files.
+struct PreprocessingFileState {
+  std::uint64_t generation_id;
+  std::uint64_t number_of_records;
+  std::uint64_t number_of_consumed_records;
+};
+
+/// \brief Amounts of preprocessed material that Backend::GeneratePreprocessing computes.
+struct PreprocessingAmounts {
+  std::size_t number_of_binary_mts{0};
+  std::size_t number_of_mts_8{0}, number_of_mts_16{0}, number_of_mts_32{0}, number_of_mts_64{0};
+  std::size_t number_of_sps_8{0}, number_of_sps_16{0}, number_of_sps_32{0}, number_of_sps_64{0},
+      number_of_sps_128{0};
+  std::size_t number_of_sbs_8{0}, number_of_sbs_16{0}, number_of_sbs_32{0}, number_of_sbs_64{0};
+};
+
+/// \brief Persistent store of MTs, SPs and SBs of one party, which allows to move the whole
+/// preprocessing phase out of the online jobs: a generation job appends material computed by the
+/// OT-based providers, and the store-backed providers (MtProviderFromStore, SpProviderFromStore,
+/// SbProviderFromStore) consume it later in the order in which it was appended.
+///
+/// The files are memory-mapped and exclusively locked while the store is open. The consumption
+/// offsets are synced to the files before the material is handed out, so material is never
+/// reused, even if a job crashes. All parties need to use stores that were filled by the same
+/// generation jobs and consume in lockstep, i.e., evaluate the same circuits, which the Backend
+/// checks by comparing the generation IDs and offsets of the files with the other parties.
+class PreprocessingStore {
+ public:
+  /// \brief Opens or creates the store of party my_id in directory.
+  /// \throws std::runtime_error if the directory cannot be created.
+  PreprocessingStore(const std::string& directory, std::size_t my_id,
+                     std::size_t number_of_parties);
+  ~PreprocessingStore();
+
+  PreprocessingStore(const PreprocessingStore&) = delete;
+  PreprocessingStore& operator=(const PreprocessingStore&) = delete;
+
+  /// \brief Number of MTs, SPs or SBs of type material that were not consumed yet.
+  std::size_t GetNumberOfAvailable(PreprocessingMaterial material);
+
+  /// \brief Checks that at least number_of_elements MTs, SPs or SBs of type material are available.
+  /// \throws std::runtime_error otherwise.
+  void CheckAvailable(PreprocessingMaterial material, std::size_t number_of_elements);
+
+  /// \brief Generation ID and offsets of the file of type material.
+  PreprocessingFileState GetState(PreprocessingMaterial material);
+
+  /// \brief Assigns the generation ID that all parties agreed on to the file of type material.
+  /// \throws std::logic_error if the file already has a generation ID.
+  void SetGenerationId(PreprocessingMaterial material, std::uint64_t generation_id);
+
+  void AppendBinaryMts(const BinaryMtVector& mts, std::size_t number_of_mts);
+
+  /// \brief Consumes the next number_of_mts binary MTs.
+  /// \throws std::runtime_error if the store holds less MTs.
+  BinaryMtVector ConsumeBinaryMts(std::size_t number_of_mts);
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  void AppendMts(const IntegerMtVector<T>& mts, std::size_t number_of_mts) {
+    std::vector<T> records(3 * number_of_mts);
+    for (std::size_t i = 0; i < number_of_mts; ++i) {
+      records[3 * i] = mts.a.at(i);
+      records[3 * i + 1] = mts.b.at(i);
+      records[3 * i + 2] = mts.c.at(i);
+    }
+    Append(GetMtMaterial<T>(), std::as_bytes(std::span(records)), number_of_mts);
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  IntegerMtVector<T> ConsumeMts(std::size_t number_of_mts) {
+    IntegerMtVector<T> mts;
+    mts.a.resize(number_of_mts);
+    mts.b.resize(number_of_mts);
+    mts.c.resize(number_of_mts);
+    Consume(GetMtMaterial<T>(), number_of_mts, [&mts](std::span<const std::byte> bytes) {
+      const auto* records{reinterpret_cast<const T*>(bytes.data())};
+      for (std::size_t i = 0; i < mts.a.size(); ++i) {
+        mts.a[i] = records[3 * i];
+        mts.b[i] = records[3 * i + 1];
+        mts.c[i] = records[3 * i + 2];
+      }
+    });
+    return mts;
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  void AppendSps(const SpVector<T>& sps, std::size_t number_of_sps) {
+    std::vector<T> records(2 * number_of_sps);
+    for (std::size_t i = 0; i < number_of_sps; ++i) {
+      records[2 * i] = sps.a.at(i);
+      records[2 * i + 1] = sps.c.at(i);
+    }
+    Append(GetSpMaterial<T>(), std::as_bytes(std::span(records)), number_of_sps);
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  SpVector<T> ConsumeSps(std::size_t number_of_sps) {
+    SpVector<T> sps;
+    sps.a.resize(number_of_sps);
+    sps.c.resize(number_of_sps);
+    Consume(GetSpMaterial<T>(), number_of_sps, [&sps](std::span<const std::byte> bytes) {
+      const auto* records{reinterpret_cast<const T*>(bytes.data())};
+      for (std::size_t i = 0; i < sps.a.size(); ++i) {
+        sps.a[i] = records[2 * i];
+        sps.c[i] = records[2 * i + 1];
+      }
+    });
+    return sps;
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  void AppendSbs(const std::vector<T>& sbs, std::size_t number_of_sbs) {
+    assert(number_of_sbs <= sbs.size());
+    Append(GetSbMaterial<T>(), std::as_bytes(std::span(sbs.data(), number_of_sbs)),
+           number_of_sbs);
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::vector<T> ConsumeSbs(std::size_t number_of_sbs) {
+    std::vector<T> sbs(number_of_sbs);
+    Consume(GetSbMaterial<T>(), number_of_sbs, [&sbs](std::span<const std::byte> bytes) {
+      std::copy_n(reinterpret_cast<const T*>(bytes.data()), sbs.size(), sbs.data());
+    });
+    return sbs;
+  }
+
+  template <typename T>
+  static constexpr PreprocessingMaterial GetMtMaterial() {
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return PreprocessingMaterial::kMt8;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return PreprocessingMaterial::kMt16;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return PreprocessingMaterial::kMt32;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return PreprocessingMaterial::kMt64;
+    } else {
+      static_assert(!std::is_same_v<T, T>, "Unknown type");
+    }
+  }
+
+  template <typename T>
+  static constexpr PreprocessingMaterial GetSpMaterial() {
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return PreprocessingMaterial::kSp8;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return PreprocessingMaterial::kSp16;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return PreprocessingMaterial::kSp32;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return PreprocessingMaterial::kSp64;
+    } else if constexpr (std::is_same_v<T, __uint128_t>) {
+      return PreprocessingMaterial::kSp128;
+    } else {
+      static_assert(!std::is_same_v<T, T>, "Unknown type");
+    }
+  }
+
+  template <typename T>
+  static constexpr PreprocessingMaterial GetSbMaterial() {
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+      return PreprocessingMaterial::kSb8;
+    } else if constexpr (std::is_same_v<T, std::uint16_t>) {
+      return PreprocessingMaterial::kSb16;
+    } else if constexpr (std::is_same_v<T, std::uint32_t>) {
+      return PreprocessingMaterial::kSb32;
+    } else if constexpr (std::is_same_v<T, std::uint64_t>) {
+      return PreprocessingMaterial::kSb64;
+    } else {
+      static_assert(!std::is_same_v<T, T>, "Unknown type");
+    }
+  }
+
+ private:
+  class File;
+
+  File& GetFile(PreprocessingMaterial material);
+
+  void Append(PreprocessingMaterial material, std::span<const std::byte> records,
+              std::size_t number_of_records);
+
+  // passes the next number_of_records records to read after persisting their consumption
+  void Consume(PreprocessingMaterial material, std::size_t number_of_records,
+               const std::function<void(std::span<const std::byte>)>& read);
+
+  const std::string directory_;
+  const std::size_t my_id_;
+  const std::size_t number_of_parties_;
+  std::mutex mutex_;
+  std::array<std::unique_ptr<File>, static_cast<std::size_t>(PreprocessingMaterial::kInvalid)>
+      files_;
+};
+
+}  // namespace encrypto::motion
@@ -31,6 +31,8 @@
 #include "communication/message_handler.h"
 #include "communication/shared_bits_message.h"
 #include "data_storage/shared_bits_data.h"
+#include "preprocessing_service.h"
+#include "preprocessing_store.h"
 #include "sb_impl.h"
 #include "sp_provider.h"
 #include "statistics/run_time_statistics.h"
@@ -321,4 +323,64 @@ void SbProviderFromSps::ComputeSbs() noexcept {
   detail::compute_sbs_phase_3<std::uint64_t>(wb1_64, wb2_64, sbs_64_, my_id_);
 }
 
+SbProviderFromStore::SbProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::shared_ptr<PreprocessingService> service,
+                                         const std::size_t my_id, Logger& logger,
+                                         RunTimeStatistics& run_time_statistics)
+    : SbProvider(my_id),
+      store_(std::move(store)),
+      service_(std::move(service)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+void SbProviderFromStore::Reserve(PreprocessingMaterial material,
+                                  std::size_t number_of_elements) {
+  if (service_) {
+    service_->Reserve(material, number_of_elements);
+  } else {
+    store_->CheckAvailable(material, number_of_elements);
+  }
+}
+
+void SbProviderFromStore::PreSetup() {
+  if (!NeedSbs()) {
+    return;
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSbPresetup>();
+
+  Reserve(PreprocessingMaterial::kSb8, number_of_sbs_8_);
+  Reserve(PreprocessingMaterial::kSb16, number_of_sbs_16_);
+  Reserve(PreprocessingMaterial::kSb32, number_of_sbs_32_);
+  Reserve(PreprocessingMaterial::kSb64, number_of_sbs_64_);
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSbPresetup>();
+}
+
+void SbProviderFromStore::Setup() {
+  if (!NeedSbs()) {
+    return;
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading SBs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSbSetup>();
+
+  sbs_8_ = store_->ConsumeSbs<std::uint8_t>(number_of_sbs_8_);
+  sbs_16_ = store_->ConsumeSbs<std::uint16_t>(number_of_sbs_16_);
+  sbs_32_ = store_->ConsumeSbs<std::uint32_t>(number_of_sbs_32_);
+  sbs_64_ = store_->ConsumeSbs<std::uint64_t>(number_of_sbs_64_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSbSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading SBs from the preprocessing store");
+  }
+}
+
 }  // namespace encrypto::motion
@@ -29,6 +29,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "utility/bit_vector.h"
 #include "utility/fiber_condition.h"
 #include "utility/reusable_future.h"
 
@@ -43,12 +44,34 @@ namespace encrypto::motion {
 class RunTimeStatistics;
 class Logger;
 class SpProvider;
+class PreprocessingStore;
+class PreprocessingService;
+enum class PreprocessingMaterial : std::uint32_t;
 struct SharedBitsData;
 
+// extended doubly-authenticated bits (edaBits), random values r in Z/2^kZ shared arithmetically
+// together with XOR sharings of the bits of r
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+struct EdaBitVector {
+  std::vector<T> values;          // arithmetic shares of the r
+  std::vector<BitVector<>> bits;  // bits[i] holds the shares of the i-th bit of all r
+};
+
+// truncation pairs for the probabilistic truncation by f bits, random values r in Z/2^kZ shared
+// arithmetically together with arithmetic sharings of (r mod 2^(k-1)) >> f and of the msb of r
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+struct TruncationPairVector {
+  std::vector<T> values;                 // arithmetic shares of the r
+  std::vector<T> truncated_values;       // arithmetic shares of the (r mod 2^(k-1)) >> f
+  std::vector<T> most_significant_bits;  // arithmetic shares of the r_(k-1)
+};
+
 // Provider for Shared Bits (SBs),
 // sharings of a random bit 0 or 1 in Z/2^kZ
 class SbProvider {
  public:
+  virtual ~SbProvider() = default;
+
   bool NeedSbs() const noexcept;
 
   template <typename T>
@@ -119,6 +142,69 @@ class SbProvider {
     }
   }
 
+  // requests edaBits composed of sizeof(T) * 8 SBs each, returns the offset for GetEdaBits
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::size_t RequestEdaBits(const std::size_t number_of_edabits) noexcept {
+    return RequestSbs<T>(number_of_edabits * sizeof(T) * 8);
+  }
+
+  // An SB is an arithmetic sharing of a bit b, so the least significant bits of its shares are a
+  // XOR sharing of b.  The i-th SB of an edaBit is used as its i-th bit, such that the edaBit is
+  // the weighted sum of its SBs.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  EdaBitVector<T> GetEdaBits(const std::size_t offset, const std::size_t n) {
+    constexpr auto kBitLength = sizeof(T) * 8;
+    const auto& sbs = GetSbsAll<T>();
+    assert(offset + n * kBitLength <= sbs.size());
+    EdaBitVector<T> edabits{std::vector<T>(n, 0), std::vector<BitVector<>>(kBitLength)};
+    for (std::size_t bit_i = 0; bit_i < kBitLength; ++bit_i) {
+      auto& bits = edabits.bits[bit_i];
+      bits = BitVector<>(n);
+      const T* sbs_i = sbs.data() + offset + bit_i * n;
+      for (std::size_t j = 0; j < n; ++j) {
+        edabits.values[j] += T(sbs_i[j] << bit_i);
+        bits.Set(sbs_i[j] & 1, j);
+      }
+    }
+    return edabits;
+  }
+
+  // requests truncation pairs composed of sizeof(T) * 8 SBs each, returns the offset for
+  // GetTruncationPairs
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  std::size_t RequestTruncationPairs(const std::size_t number_of_pairs) noexcept {
+    return RequestSbs<T>(number_of_pairs * sizeof(T) * 8);
+  }
+
+  // Since all parts of a truncation pair are linear in the bits of r, they are computed locally
+  // from the arithmetic shares of the SBs, laid out as for GetEdaBits.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  TruncationPairVector<T> GetTruncationPairs(const std::size_t offset, const std::size_t n,
+                                             const std::size_t fractional_bits) {
+    constexpr auto kBitLength = sizeof(T) * 8;
+    assert(fractional_bits < kBitLength - 1);
+    const auto& sbs = GetSbsAll<T>();
+    assert(offset + n * kBitLength <= sbs.size());
+    TruncationPairVector<T> pairs{std::vector<T>(n, 0), std::vector<T>(n, 0), std::vector<T>(n)};
+    for (std::size_t bit_i = 0; bit_i < kBitLength - 1; ++bit_i) {
+      const T* sbs_i = sbs.data() + offset + bit_i * n;
+      for (std::size_t j = 0; j < n; ++j) {
+        pairs.values[j] += T(sbs_i[j] << bit_i);
+      }
+      if (bit_i >= fractional_bits) {
+        for (std::size_t j = 0; j < n; ++j) {
+          pairs.truncated_values[j] += T(sbs_i[j] << (bit_i - fractional_bits));
+        }
+      }
+    }
+    const T* msbs = sbs.data() + offset + (kBitLength - 1) * n;
+    for (std::size_t j = 0; j < n; ++j) {
+      pairs.values[j] += T(msbs[j] << (kBitLength - 1));
+      pairs.most_significant_bits[j] = msbs[j];
+    }
+    return pairs;
+  }
+
   virtual void PreSetup() = 0;
   virtual void Setup() = 0;
 
@@ -194,4 +280,29 @@ class SbProviderFromSps final : public SbProvider {
   RunTimeStatistics& run_time_statistics_;
 };
 
+/// \brief Takes the SBs from a PreprocessingStore filled by an earlier generation job, which
+/// saves the SPs and the communication round of SbProviderFromSps.
+class SbProviderFromStore final : public SbProvider {
+ public:
+  /// \brief Reserves the SBs at service before consuming them if service is not null.
+  SbProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                      std::shared_ptr<PreprocessingService> service, const std::size_t my_id,
+                      Logger& logger, RunTimeStatistics& run_time_statistics);
+
+  // checks that the store holds enough SBs or reserves them at the service
+  void PreSetup() final override;
+
+  void Setup() final override;
+
+ private:
+  // reserves the material at service_ if there is one, otherwise checks that store_ holds it
+  void Reserve(PreprocessingMaterial material, std::size_t number_of_elements);
+
+  std::shared_ptr<PreprocessingStore> store_;
+  std::shared_ptr<PreprocessingService> service_;
+
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
 }  // namespace encrypto::motion
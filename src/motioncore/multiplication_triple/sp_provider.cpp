@@ -24,6 +24,8 @@
 
 #include "sp_provider.h"
 #include "oblivious_transfer/ot_provider.h"
+#include "preprocessing_service.h"
+#include "preprocessing_store.h"
 #include "statistics/run_time_statistics.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
@@ -269,4 +271,66 @@ void SpProviderFromOts::ParseOutputs() {
   }
 }
 
+SpProviderFromStore::SpProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                                         std::shared_ptr<PreprocessingService> service,
+                                         const std::size_t my_id, Logger& logger,
+                                         RunTimeStatistics& run_time_statistics)
+    : SpProvider(my_id),
+      store_(std::move(store)),
+      service_(std::move(service)),
+      logger_(logger),
+      run_time_statistics_(run_time_statistics) {}
+
+void SpProviderFromStore::Reserve(PreprocessingMaterial material,
+                                  std::size_t number_of_elements) {
+  if (service_) {
+    service_->Reserve(material, number_of_elements);
+  } else {
+    store_->CheckAvailable(material, number_of_elements);
+  }
+}
+
+void SpProviderFromStore::PreSetup() {
+  if (!NeedSps()) {
+    return;
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSpPresetup>();
+
+  Reserve(PreprocessingMaterial::kSp8, number_of_sps_8_);
+  Reserve(PreprocessingMaterial::kSp16, number_of_sps_16_);
+  Reserve(PreprocessingMaterial::kSp32, number_of_sps_32_);
+  Reserve(PreprocessingMaterial::kSp64, number_of_sps_64_);
+  Reserve(PreprocessingMaterial::kSp128, number_of_sps_128_);
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSpPresetup>();
+}
+
+void SpProviderFromStore::Setup() {
+  if (!NeedSps()) {
+    return;
+  }
+
+  if constexpr (kDebug) {
+    logger_.LogDebug("Start loading SPs from the preprocessing store");
+  }
+  run_time_statistics_.RecordStart<RunTimeStatistics::StatisticsId::kSpSetup>();
+
+  sps_8_ = store_->ConsumeSps<std::uint8_t>(number_of_sps_8_);
+  sps_16_ = store_->ConsumeSps<std::uint16_t>(number_of_sps_16_);
+  sps_32_ = store_->ConsumeSps<std::uint32_t>(number_of_sps_32_);
+  sps_64_ = store_->ConsumeSps<std::uint64_t>(number_of_sps_64_);
+  sps_128_ = store_->ConsumeSps<__uint128_t>(number_of_sps_128_);
+
+  {
+    std::scoped_lock lock(finished_condition_->GetMutex());
+    finished_ = true;
+  }
+  finished_condition_->NotifyAll();
+
+  run_time_statistics_.RecordEnd<RunTimeStatistics::StatisticsId::kSpSetup>();
+  if constexpr (kDebug) {
+    logger_.LogDebug("Finished loading SPs from the preprocessing store");
+  }
+}
+
 }  // namespace encrypto::motion
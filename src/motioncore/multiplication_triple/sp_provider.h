@@ -40,6 +40,9 @@ class OtVectorSender;
 class OtVectorReceiver;
 struct RunTimeStatistics;
 class Logger;
+class PreprocessingStore;
+class PreprocessingService;
+enum class PreprocessingMaterial : std::uint32_t;
 
 template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
 struct SpVector {
@@ -194,4 +197,28 @@ class SpProviderFromOts final : public SpProvider {
   RunTimeStatistics& run_time_statistics_;
 };
 
+/// \brief Takes the SPs from a PreprocessingStore filled by an earlier generation job.
+class SpProviderFromStore final : public SpProvider {
+ public:
+  /// \brief Reserves the SPs at service before consuming them if service is not null.
+  SpProviderFromStore(std::shared_ptr<PreprocessingStore> store,
+                      std::shared_ptr<PreprocessingService> service, const std::size_t my_id,
+                      Logger& logger, RunTimeStatistics& run_time_statistics);
+
+  // checks that the store holds enough SPs or reserves them at the service
+  void PreSetup() final override;
+
+  void Setup() final override;
+
+ private:
+  // reserves the material at service_ if there is one, otherwise checks that store_ holds it
+  void Reserve(PreprocessingMaterial material, std::size_t number_of_elements);
+
+  std::shared_ptr<PreprocessingStore> store_;
+  std::shared_ptr<PreprocessingService> service_;
+
+  Logger& logger_;
+  RunTimeStatistics& run_time_statistics_;
+};
+
 }  // namespace encrypto::motion
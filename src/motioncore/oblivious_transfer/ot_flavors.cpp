@@ -48,7 +48,7 @@ BasicOtSender::BasicOtSender(
   data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
 }
 
-void BasicOtSender::WaitSetup() const { data_.setup_finished_condition->Wait(); }
+void BasicOtSender::WaitSetup() const { data_.WaitSetup(ot_id_ + number_of_ots_); }
 
 // ---------- BasicOtReceiver ----------
 
@@ -62,7 +62,7 @@ BasicOtReceiver::BasicOtReceiver(
   data_.number_of_ots_in_batch.emplace(ot_id, number_of_ots);
 }
 
-void BasicOtReceiver::WaitSetup() const { data_.setup_finished_condition->Wait(); }
+void BasicOtReceiver::WaitSetup() const { data_.WaitSetup(ot_id_ + number_of_ots_); }
 
 void BasicOtReceiver::SendCorrections() {
   if (choices_.Empty()) {
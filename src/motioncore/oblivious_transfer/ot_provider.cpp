@@ -23,8 +23,13 @@
 // SOFTWARE.
 
 #include "ot_provider.h"
+
+#include <algorithm>
+#include <stdexcept>
+
 #include "base_ots/base_ot_provider.h"
 #include "ot_flavors.h"
+#include "silent_ot_provider.h"
 
 #include "base/motion_base_provider.h"
 #include "communication/communication_layer.h"
@@ -41,6 +46,30 @@
 
 namespace encrypto::motion {
 
+namespace {
+
+// partitions the columns [0, number_of_columns) of a bit matrix into at most number_of_workers
+// blocks of whole 128-column tiles and calls function(block_offset, block_size) for each block in
+// parallel. The blocks are disjoint, so the calls can write their results into shared outputs.
+template <typename Function>
+void ParallelForColumnBlocks(const std::size_t number_of_columns,
+                             const std::size_t number_of_workers, const Function& function) {
+  constexpr std::size_t kTileSize{128};
+  assert(number_of_columns % kTileSize == 0);
+  const std::size_t number_of_tiles{number_of_columns / kTileSize};
+  const std::size_t tiles_per_block{(number_of_tiles + number_of_workers - 1) / number_of_workers};
+  const std::size_t number_of_blocks{(number_of_tiles + tiles_per_block - 1) / tiles_per_block};
+#pragma omp parallel for num_threads(number_of_blocks)
+  for (std::size_t block_id = 0; block_id < number_of_blocks; ++block_id) {
+    const std::size_t first_tile{block_id * tiles_per_block};
+    const std::size_t block_size{std::min(tiles_per_block, number_of_tiles - first_tile) *
+                                 kTileSize};
+    function(first_tile * kTileSize, block_size);
+  }
+}
+
+}  // namespace
+
 OtProvider::OtProvider(std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function,
                        OtExtensionData& data, std::size_t party_id, std::shared_ptr<Logger> logger)
     : send_function_(send_function),
@@ -150,141 +179,128 @@ void OtProviderFromOtExtension::SendSetup() {
   // == width of the bit matrix
   const std::size_t bit_size = sender_provider_.GetNumOts();
   if (bit_size == 0) return;  // no OTs needed
-  ot_extension_sender_data.bit_size = bit_size;
-
-  // XXX: index variable?
-  std::size_t i;
 
-  // bit size of the matrix rounded to bytes
-  // XXX: maybe round to blocks?
-  const std::size_t byte_size = BitsToBytes(bit_size);
+  // the bit matrix is processed in chunks of kOtExtensionChunkSize columns, such that only one
+  // chunk of the matrix is kept in memory and the OTs can be used chunk by chunk
+  const std::size_t number_of_chunks =
+      (bit_size + kOtExtensionChunkSize - 1) / kOtExtensionChunkSize;
 
   // bit size rounded to blocks
   const auto bit_size_padded = bit_size + kKappa - (bit_size % kKappa);
 
-  // vector containing the matrix rows
+  // the outputs of the padding columns are computed but never used
+  ot_extension_sender_data.y0.resize(bit_size_padded);
+  ot_extension_sender_data.y1.resize(bit_size_padded);
+
+  // storage for the receiver's masks, needs to be allocated before bit_size is set
+  {
+    std::scoped_lock lock(ot_extension_sender_data.u_mutex);
+    ot_extension_sender_data.u.resize(number_of_chunks * kKappa);
+    ot_extension_sender_data.number_of_received_us.assign(number_of_chunks, 0);
+  }
+  ot_extension_sender_data.bit_size = bit_size;
+
+  motion_base_provider_.Setup();
+  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
+
+  // vector containing the matrix rows of the current chunk
   // XXX: note that rows/columns are swapped compared to the ALSZ paper
   std::vector<AlignedBitVector> v(kKappa);
 
-  // PRG which is used to expand the keys we got from the base OTs
-  primitives::Prg prgs_variable_key;
-  //// fill the rows of the matrix
-  for (i = 0; i < kKappa; ++i) {
-    // use the key we got from the base OTs as seed
-    prgs_variable_key.SetKey(base_ots_receiver_data.messages_c.at(i).data());
-    // change the offset in the output stream since we might have already used
-    // the same base OTs previously
-    prgs_variable_key.SetOffset(base_ots_receiver_data.consumed_offset);
-    // expand the seed such that it fills one row of the matrix
-    auto row(prgs_variable_key.Encrypt(byte_size));
-    v[i] = AlignedBitVector(std::move(row), bit_size_padded);
-  }
+  for (std::size_t chunk_id = 0; chunk_id < number_of_chunks; ++chunk_id) {
+    const std::size_t chunk_offset = chunk_id * kOtExtensionChunkSize;
+    const std::size_t chunk_size = std::min(kOtExtensionChunkSize, bit_size - chunk_offset);
+    // chunk size rounded to blocks, i.e., to AES blocks in the PRG output
+    const std::size_t chunk_size_padded = (chunk_size + kKappa - 1) / kKappa * kKappa;
+
+    //// fill the rows of the matrix, the rows are expanded independently by the workers
+#pragma omp parallel for num_threads(number_of_workers_)
+    for (std::size_t i = 0; i < kKappa; ++i) {
+      // PRG which is used to expand the keys we got from the base OTs
+      primitives::Prg prgs_variable_key;
+      // use the key we got from the base OTs as seed
+      prgs_variable_key.SetKey(base_ots_receiver_data.messages_c.at(i).data());
+      // change the offset in the output stream since we might have already used
+      // the same base OTs previously and skip the blocks of the previous chunks
+      prgs_variable_key.SetOffset(base_ots_receiver_data.consumed_offset + chunk_offset / kKappa);
+      // expand the seed such that it fills one row of the matrix
+      auto row(prgs_variable_key.Encrypt(chunk_size_padded / 8));
+      v[i] = AlignedBitVector(std::move(row), chunk_size_padded);
+    }
 
-  // receive the vectors u one by one from the receiver
-  // and xor them to the expanded keys if the corresponding selection bit is 1
-  // transmitted one by one to prevent waiting for finishing all messages to start sending
-  // the vectors can be transmitted in the wrong order
-
-  for (auto it = ot_extension_sender_data.u_futures.begin();
-       it < ot_extension_sender_data.u_futures.end(); ++it) {
-    const std::size_t u_id{it->get()};
-    if (base_ots_receiver_data.c[u_id]) {
-      const auto& u = ot_extension_sender_data.u[u_id];
-      BitSpan bs(v[u_id].GetMutableData().data(), bit_size, true);
-      bs ^= u;
+    // wait for the vectors u of this chunk from the receiver and xor them to the expanded keys if
+    // the corresponding selection bit is 1. The vectors of the next chunks are received meanwhile.
+    {
+      std::unique_lock lock(ot_extension_sender_data.u_mutex);
+      ot_extension_sender_data.u_condition.wait(lock, [&ot_extension_sender_data, chunk_id] {
+        return ot_extension_sender_data.number_of_received_us[chunk_id] == kKappa;
+      });
+    }
+#pragma omp parallel for num_threads(number_of_workers_)
+    for (std::size_t i = 0; i < kKappa; ++i) {
+      auto& u = ot_extension_sender_data.u[chunk_id * kKappa + i];
+      if (base_ots_receiver_data.c[i]) {
+        BitSpan bs(v[i].GetMutableData().data(), chunk_size, true);
+        bs ^= u;
+      }
+      // delete the allocated memory
+      u = AlignedBitVector();
     }
-  }
 
-  // delete the allocated memory
-  ot_extension_sender_data.u = {};
+    // transpose the chunk of the bit matrix and compute the outputs of its OTs. Each worker
+    // transposes and hashes a block of columns and writes the outputs in place into y0 and y1.
+    ParallelForColumnBlocks(chunk_size_padded, number_of_workers_, [&](std::size_t block_offset,
+                                                                       std::size_t block_size) {
+      primitives::Prg prg_fixed_key;
+      prg_fixed_key.SetKey(fixed_key_aes_key.data());
+      // array with pointers to each row of the block
+      std::array<const std::byte*, kKappa> pointers;
+      for (std::size_t i = 0; i < pointers.size(); ++i) {
+        pointers[i] = v[i].GetData().data() + block_offset / 8;
+      }
+      BitMatrix::SenderTransposeAndEncrypt(
+          pointers, ot_extension_sender_data.y0, ot_extension_sender_data.y1,
+          base_ots_receiver_data.c, prg_fixed_key, block_size,
+          ot_extension_sender_data.bitlengths, chunk_offset + block_offset);
+    });
 
-  // array with pointers to each row of the matrix
-  std::array<const std::byte*, kKappa> pointers;
-  for (i = 0u; i < pointers.size(); ++i) {
-    pointers[i] = v[i].GetData().data();
+    // release the OTs of this chunk
+    {
+      std::scoped_lock lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
+      ot_extension_sender_data.number_of_ready_ots = chunk_offset + chunk_size;
+    }
+    ot_extension_sender_data.setup_finished_condition->NotifyAll();
   }
 
-  motion_base_provider_.Setup();
-  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
-
-  // for each (extended) OT i
-  primitives::Prg prg_fixed_key;
-  prg_fixed_key.SetKey(fixed_key_aes_key.data());
-
-  // transpose the bit matrix
-  // XXX: figure out how the result looks like
-  BitMatrix::SenderTransposeAndEncrypt(
-      pointers, ot_extension_sender_data.y0, ot_extension_sender_data.y1, base_ots_receiver_data.c,
-      prg_fixed_key, bit_size_padded, ot_extension_sender_data.bitlengths);
-  /*
-    for (i = 0; i < ot_extension_sender_data.bitlengths.size(); ++i) {
-      // here we want to store the sender's outputs
-      // XXX: why are the y0_, y1_ vectors resized every time new ots are registered?
-      auto &out0 = ot_extension_sender_data.y0[i];
-      auto &out1 = ot_extension_sender_data.y1[i];
-
-      // bit length of the OT
-      const auto bitlength = ot_extension_sender_data.bitlengths[i];
-
-      // in which of the above "rows" can we find the block
-      const auto row_i = i % kKappa;
-      // where in the "row" do we have to look for the block
-      const auto blk_offset = ((kKappa / 8) * (i / kKappa));
-      auto V_row = reinterpret_cast<std::byte *>(
-          __builtin_assume_aligned(pointers.at(row_i) + blk_offset,
-    kAlignment));
-
-      // compute the sender outputs
-      if (bitlength <= kKappa) {
-        // the bit length is smaller than 128 bit
-        out0 = BitVector<>(prg_fixed_key.FixedKeyAes(V_row, i), bitlength);
-
-        auto out1_in = base_ots_receiver_data.c ^ BitSpan(V_row, kKappa, true);
-        out1 = BitVector<>(prg_fixed_key.FixedKeyAes(out1_in.GetData().data(), i), bitlength);
-      } else {
-        // string OT with bit length > 128 bit
-        // -> do seed compression and send later only 128 bit seeds
-        auto seed0 = prg_fixed_key.FixedKeyAes(V_row, i);
-        prgs_variable_key.SetKey(seed0.data());
-        out0 =
-            BitVector<>(prgs_variable_key.Encrypt(BitsToBytes(bitlength)),
-    bitlength);
-
-        auto out1_in = base_ots_receiver_data.c ^ BitSpan(V_row, kKappa, true);
-        auto seed1 = prg_fixed_key.FixedKeyAes(out1_in.GetData().data(), i);
-        prgs_variable_key.SetKey(seed1.data());
-        out1 =
-            BitVector<>(prgs_variable_key.Encrypt(BitsToBytes(bitlength)),
-    bitlength);
-      }
-    }*/
+  {
+    std::scoped_lock lock(ot_extension_sender_data.u_mutex);
+    ot_extension_sender_data.u = {};
+    ot_extension_sender_data.number_of_received_us = {};
+  }
 
   // we are done with the setup for the sender side
   {
-    std::scoped_lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
+    std::scoped_lock lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
     ot_extension_sender_data.setup_finished = true;
   }
   ot_extension_sender_data.setup_finished_condition->NotifyAll();
 }
 
 void OtProviderFromOtExtension::ReceiveSetup() {
-  // some index variables
-  std::size_t i = 0, j = 0;
   // security parameter and number of base OTs
   constexpr std::size_t kKappa = 128;
   // number of OTs and width of the bit matrix
   const std::size_t bit_size = receiver_provider_.GetNumOts();
   if (bit_size == 0) return;  // nothing to do
 
+  // the bit matrix is processed in chunks of kOtExtensionChunkSize columns, such that only one
+  // chunk of the matrix is kept in memory and the OTs can be used chunk by chunk
+  const std::size_t number_of_chunks =
+      (bit_size + kOtExtensionChunkSize - 1) / kOtExtensionChunkSize;
+
   // rounded up to a multiple of the security parameter
   const auto bit_size_padded = bit_size + kKappa - (bit_size % kKappa);
 
-  // convert to bytes
-  const std::size_t byte_size = BitsToBytes(bit_size);
-  // XXX: if byte_size is 0 then bit_size was also zero (or an overflow happened
-  if (byte_size == 0) {
-    return;
-  }
   // storage for receiver and base OT sender data
   const auto& base_ots_sender_data = base_ot_data_.GetSenderData();
   auto& ot_extension_receiver_data = data_.GetReceiverData();
@@ -293,80 +309,83 @@ void OtProviderFromOtExtension::ReceiveSetup() {
   ot_extension_receiver_data.random_choices =
       std::make_unique<AlignedBitVector>(AlignedBitVector::SecureRandom(bit_size));
 
-  // create matrix with kKappa rows
-  std::vector<AlignedBitVector> v(kKappa);
+  // the outputs of the padding columns are computed but never used
+  ot_extension_receiver_data.outputs.resize(bit_size_padded);
 
-  // PRG we use with the fixed-key AES function
-
-  // PRG which is used to expand the keys we got from the base OTs
-  primitives::Prg prg_fixed_key, prg_variable_key;
-  // fill the rows of the matrix
-  for (i = 0; i < kKappa; ++i) {
-    // generate rows of the matrix using the corresponding 0 key
-    // T[j] = Prg(s_{j,0})
-    prg_variable_key.SetKey(base_ots_sender_data.messages_0.at(i).data());
-    // change the offset in the output stream since we might have already used
-    // the same base OTs previously
-    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
-    // expand the seed such that it fills one row of the matrix
-    auto row(prg_variable_key.Encrypt(byte_size));
-    v.at(i) = AlignedBitVector(std::move(row), bit_size);
-    // take a copy of the row and XOR it with our choices
-    auto u = v.at(i);
-    // u_j = T[j] XOR r
-    u ^= *ot_extension_receiver_data.random_choices;
-
-    // now mask the result with random stream expanded from the 1 key
-    // u_j = u_j XOR Prg(s_{j,1})
-    prg_variable_key.SetKey(base_ots_sender_data.messages_1.at(i).data());
-    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
-    u ^= AlignedBitVector(prg_variable_key.Encrypt(byte_size), bit_size);
-
-    // send this row
-    send_function_(communication::BuildOtExtensionMessageReceiverMasks(u.GetData().data(),
-                                                                       u.GetData().size(), i));
-  }
+  motion_base_provider_.Setup();
+  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
 
-  // transpose matrix T
-  if (bit_size_padded != bit_size) {
-    for (i = 0u; i < v.size(); ++i) {
-      v.at(i).Resize(bit_size_padded, true);
-    }
-  }
+  // create matrix with kKappa rows for the current chunk
+  std::vector<AlignedBitVector> v(kKappa);
 
-  std::array<const std::byte*, kKappa> pointers;
-  for (j = 0; j < pointers.size(); ++j) {
-    pointers.at(j) = v.at(j).GetMutableData().data();
-  }
+  for (std::size_t chunk_id = 0; chunk_id < number_of_chunks; ++chunk_id) {
+    const std::size_t chunk_offset = chunk_id * kOtExtensionChunkSize;
+    const std::size_t chunk_size = std::min(kOtExtensionChunkSize, bit_size - chunk_offset);
+    // chunk size rounded to blocks, i.e., to AES blocks in the PRG output
+    const std::size_t chunk_size_padded = (chunk_size + kKappa - 1) / kKappa * kKappa;
+    // offset of this chunk in the PRG output streams
+    const std::size_t prg_offset = base_ots_sender_data.consumed_offset + chunk_offset / kKappa;
+
+    auto random_choices =
+        ot_extension_receiver_data.random_choices->Subset(chunk_offset, chunk_offset + chunk_size);
+
+    // fill the rows of the matrix, the rows are expanded and sent independently by the workers
+#pragma omp parallel for num_threads(number_of_workers_)
+    for (std::size_t i = 0; i < kKappa; ++i) {
+      // PRG which is used to expand the keys we got from the base OTs
+      primitives::Prg prg_variable_key;
+      // generate rows of the matrix using the corresponding 0 key
+      // T[j] = Prg(s_{j,0})
+      prg_variable_key.SetKey(base_ots_sender_data.messages_0.at(i).data());
+      // change the offset in the output stream since we might have already used
+      // the same base OTs previously and skip the blocks of the previous chunks
+      prg_variable_key.SetOffset(prg_offset);
+      // expand the seed such that it fills one row of the matrix
+      auto row(prg_variable_key.Encrypt(chunk_size_padded / 8));
+      v[i] = AlignedBitVector(std::move(row), chunk_size_padded);
+      // take a copy of the row and XOR it with our choices
+      auto u = v[i];
+      // u_j = T[j] XOR r
+      u ^= random_choices;
+
+      // now mask the result with random stream expanded from the 1 key
+      // u_j = u_j XOR Prg(s_{j,1})
+      prg_variable_key.SetKey(base_ots_sender_data.messages_1.at(i).data());
+      prg_variable_key.SetOffset(prg_offset);
+      u ^= AlignedBitVector(prg_variable_key.Encrypt(chunk_size_padded / 8), chunk_size_padded);
+
+      // send this row of the chunk
+      send_function_(communication::BuildOtExtensionMessageReceiverMasks(
+          u.GetData().data(), BitsToBytes(chunk_size), chunk_id * kKappa + i));
+    }
 
-  motion_base_provider_.Setup();
-  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
-  prg_fixed_key.SetKey(fixed_key_aes_key.data());
-  BitMatrix::ReceiverTransposeAndEncrypt(pointers, ot_extension_receiver_data.outputs,
-                                         prg_fixed_key, bit_size_padded,
-                                         ot_extension_receiver_data.bitlengths);
-  /*BitMatrix::TransposeUsingBitSlicing(pointers, bit_size_padded);
-  for (i = 0; i < ot_extension_receiver_data.outputs.size(); ++i) {
-    const auto row_i = i % kKappa;
-    const auto blk_offset = ((kKappa / 8) * (i / kKappa));
-    const auto T_row = pointers.at(row_i) + blk_offset;
-    auto &out = ot_extension_receiver_data.outputs.at(i);
-
-    std::unique_lock lock(ot_extension_receiver_data.bitlengths_mutex);
-    const std::size_t bitlength = ot_extension_receiver_data.bitlengths.at(i);
-    lock.unlock();
+    // transpose the chunk of matrix T and compute the outputs of its OTs. Each worker transposes
+    // and hashes a block of columns and writes the outputs in place into outputs.
+    ParallelForColumnBlocks(chunk_size_padded, number_of_workers_, [&](std::size_t block_offset,
+                                                                       std::size_t block_size) {
+      // PRG we use with the fixed-key AES function
+      primitives::Prg prg_fixed_key;
+      prg_fixed_key.SetKey(fixed_key_aes_key.data());
+      std::array<const std::byte*, kKappa> pointers;
+      for (std::size_t j = 0; j < pointers.size(); ++j) {
+        pointers[j] = v[j].GetData().data() + block_offset / 8;
+      }
+      BitMatrix::ReceiverTransposeAndEncrypt(pointers, ot_extension_receiver_data.outputs,
+                                             prg_fixed_key, block_size,
+                                             ot_extension_receiver_data.bitlengths,
+                                             chunk_offset + block_offset);
+    });
 
-    if (bitlength <= kKappa) {
-      out = BitVector<>(prg_fixed_key.FixedKeyAes(T_row, i), bitlength);
-    } else {
-      auto seed = prg_fixed_key.FixedKeyAes(T_row, i);
-      prg_variable_key.SetKey(seed.data());
-      out = BitVector<>(prg_variable_key.Encrypt(BitsToBytes(bitlength)), bitlength);
+    // release the OTs of this chunk
+    {
+      std::scoped_lock lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
+      ot_extension_receiver_data.number_of_ready_ots = chunk_offset + chunk_size;
     }
-  }*/
+    ot_extension_receiver_data.setup_finished_condition->NotifyAll();
+  }
 
   {
-    std::scoped_lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
+    std::scoped_lock lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
     ot_extension_receiver_data.setup_finished = true;
   }
   ot_extension_receiver_data.setup_finished_condition->NotifyAll();
@@ -396,7 +415,7 @@ const std::vector<BitVector<>>& OtVectorSender::GetOutputs() {
   return outputs_;
 }
 
-void OtVectorSender::WaitSetup() { data_.setup_finished_condition->Wait(); }
+void OtVectorSender::WaitSetup() { data_.WaitSetup(ot_id_ + number_of_ots_); }
 
 OtVectorSender::OtVectorSender(
     const std::size_t ot_id, const std::size_t number_of_ots, const std::size_t bitlength,
@@ -660,7 +679,7 @@ void ROtVectorSender::SendMessages() {
   throw std::runtime_error("Inputs in ROT are available locally and thus do not need to be sent");
 }
 
-void OtVectorReceiver::WaitSetup() { data_.setup_finished_condition->Wait(); }
+void OtVectorReceiver::WaitSetup() { data_.WaitSetup(ot_id_ + number_of_ots_); }
 
 OtVectorReceiver::OtVectorReceiver(
     const std::size_t ot_id, const std::size_t number_of_ots, const std::size_t bitlength,
@@ -1011,10 +1030,12 @@ void OtProviderSender::Clear() {
   // data_storage_->GetBaseOTsData()->GetSenderData().consumed_offset += total_ots_count_;
 
   total_ots_count_ = 0;
+  data_.bit_size = 0;
 
   {
     std::scoped_lock lock(data_.setup_finished_condition->GetMutex());
     data_.setup_finished = false;
+    data_.number_of_ready_ots = 0;
   }
   {
     std::scoped_lock lock(data_.corrections_mutex);
@@ -1215,6 +1236,7 @@ void OtProviderReceiver::Clear() {
   {
     std::scoped_lock lock(data_.setup_finished_condition->GetMutex());
     data_.setup_finished = false;
+    data_.number_of_ready_ots = 0;
   }
 
   {
@@ -1232,14 +1254,18 @@ void OtProviderReceiver::Reset() { Clear(); }
 class OtExtensionMessageHandler : public communication::MessageHandler {
  public:
   OtExtensionMessageHandler(OtExtensionData& data) : data_(data) {}
-  void ReceivedMessage(std::size_t, std::vector<std::uint8_t>&& message) override;
+  void ReceivedMessage(std::size_t party_id, std::vector<std::uint8_t>&& message) override {
+    ReceivedMessageView(party_id, communication::MessageView(std::move(message)));
+  }
+  void ReceivedMessageView(std::size_t, communication::MessageView&& message) override;
 
  private:
   OtExtensionData& data_;
 };
 
-void OtExtensionMessageHandler::ReceivedMessage(std::size_t,
-                                                std::vector<std::uint8_t>&& raw_message) {
+// the OT data is read directly from the receive buffer
+void OtExtensionMessageHandler::ReceivedMessageView(std::size_t,
+                                                    communication::MessageView&& raw_message) {
   assert(!raw_message.empty());
   auto message = communication::GetMessage(raw_message.data());
   auto message_type = message->message_type();
@@ -1261,6 +1287,16 @@ void OtExtensionMessageHandler::ReceivedMessage(std::size_t,
       data_.MessageReceived(ot_data, ot_data_size, OtExtensionDataType::kSendMessage, index_i);
       break;
     }
+    case communication::MessageType::kSilentOtReceiverCorrections: {
+      data_.MessageReceived(ot_data, ot_data_size, OtExtensionDataType::kSilentOtCorrection,
+                            index_i);
+      break;
+    }
+    case communication::MessageType::kSilentOtSender: {
+      data_.MessageReceived(ot_data, ot_data_size, OtExtensionDataType::kSilentOtSenderMessage,
+                            index_i);
+      break;
+    }
     default: {
       assert(false);
       break;
@@ -1271,8 +1307,12 @@ void OtExtensionMessageHandler::ReceivedMessage(std::size_t,
 OtProviderManager::OtProviderManager(communication::CommunicationLayer& communication_layer,
                                      const BaseOtProvider& base_ot_provider,
                                      BaseProvider& motion_base_provider,
-                                     std::shared_ptr<Logger> logger)
+                                     std::shared_ptr<Logger> logger, OtBackend ot_backend)
     : communication_layer_(communication_layer),
+      base_ot_provider_(base_ot_provider),
+      motion_base_provider_(motion_base_provider),
+      logger_(logger),
+      ot_backend_(OtBackend::kInvalid),
       number_of_parties_(communication_layer_.GetNumberOfParties()),
       providers_(number_of_parties_),
       data_(number_of_parties_) {
@@ -1281,14 +1321,9 @@ OtProviderManager::OtProviderManager(communication::CommunicationLayer& communic
     if (party_id == my_id) {
       continue;
     }
-    auto send_function = [this, party_id](flatbuffers::FlatBufferBuilder&& message_builder) {
-      communication_layer_.SendMessage(party_id, std::move(message_builder));
-    };
     data_.at(party_id) = std::make_unique<OtExtensionData>();
-    providers_.at(party_id) = std::make_unique<OtProviderFromOtExtension>(
-        send_function, *data_.at(party_id), base_ot_provider.GetBaseOtsData(party_id),
-        motion_base_provider, party_id, logger);
   }
+  SetOtBackend(ot_backend);
 
   communication_layer_.RegisterMessageHandler(
       [this](std::size_t party_id) {
@@ -1296,14 +1331,54 @@ OtProviderManager::OtProviderManager(communication::CommunicationLayer& communic
       },
       {communication::MessageType::kOtExtensionReceiverMasks,
        communication::MessageType::kOtExtensionReceiverCorrections,
-       communication::MessageType::kOtExtensionSender});
+       communication::MessageType::kOtExtensionSender,
+       communication::MessageType::kSilentOtReceiverCorrections,
+       communication::MessageType::kSilentOtSender});
+}
+
+void OtProviderManager::SetOtBackend(OtBackend ot_backend) {
+  if (ot_backend == ot_backend_) return;
+  for (auto& provider : providers_) {
+    if (provider && (provider->GetNumOtsSender() > 0 || provider->GetNumOtsReceiver() > 0)) {
+      throw std::logic_error("Cannot change the OT backend after OTs were registered");
+    }
+  }
+  auto my_id = communication_layer_.GetMyId();
+  for (std::size_t party_id = 0; party_id < number_of_parties_; ++party_id) {
+    if (party_id == my_id) {
+      continue;
+    }
+    auto send_function = [this, party_id](flatbuffers::FlatBufferBuilder&& message_builder) {
+      communication_layer_.SendMessage(party_id, std::move(message_builder));
+    };
+    switch (ot_backend) {
+      case OtBackend::kOtExtension: {
+        providers_.at(party_id) = std::make_unique<OtProviderFromOtExtension>(
+            send_function, *data_.at(party_id), base_ot_provider_.GetBaseOtsData(party_id),
+            motion_base_provider_, party_id, logger_);
+        break;
+      }
+      case OtBackend::kSilentOt: {
+        providers_.at(party_id) = std::make_unique<OtProviderFromSilentOt>(
+            send_function, *data_.at(party_id), base_ot_provider_.GetBaseOtsData(party_id),
+            motion_base_provider_, party_id, logger_);
+        break;
+      }
+      default:
+        throw std::invalid_argument(
+            fmt::format("Invalid OtBackend {}", static_cast<unsigned int>(ot_backend)));
+    }
+  }
+  ot_backend_ = ot_backend;
 }
 
 OtProviderManager::~OtProviderManager() {
   communication_layer_.DeregisterMessageHandler(
       {communication::MessageType::kOtExtensionReceiverMasks,
        communication::MessageType::kOtExtensionReceiverCorrections,
-       communication::MessageType::kOtExtensionSender});
+       communication::MessageType::kOtExtensionSender,
+       communication::MessageType::kSilentOtReceiverCorrections,
+       communication::MessageType::kSilentOtSender});
 }
 
 }  // namespace encrypto::motion
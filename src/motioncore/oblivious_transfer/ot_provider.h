@@ -32,6 +32,7 @@
 #include <flatbuffers/flatbuffers.h>
 
 #include "utility/bit_vector.h"
+#include "utility/typedefs.h"
 
 namespace encrypto::motion::communication {
 
@@ -415,6 +416,14 @@ class OtProvider {
   virtual void SendSetup() = 0;
   virtual void ReceiveSetup() = 0;
 
+  /// \brief Sets the number of threads that SendSetup and ReceiveSetup each use to expand and
+  ///        transpose the bit matrix. 0 is treated as 1.
+  void SetNumberOfWorkers(std::size_t number_of_workers) noexcept {
+    number_of_workers_ = number_of_workers > 0 ? number_of_workers : 1;
+  }
+
+  std::size_t GetNumberOfWorkers() const noexcept { return number_of_workers_; }
+
   void WaitSetup() const;
 
   void Clear() {
@@ -435,6 +444,7 @@ class OtProvider {
   OtExtensionData& data_;
   OtProviderReceiver receiver_provider_;
   OtProviderSender sender_provider_;
+  std::size_t number_of_workers_{1};
 };
 
 class OtProviderFromFile : public OtProvider {
@@ -471,14 +481,26 @@ class OtProviderFromMultipleThirdParties : public OtProvider {
 class OtProviderManager {
  public:
   OtProviderManager(communication::CommunicationLayer&, const BaseOtProvider&, BaseProvider&,
-                    std::shared_ptr<Logger> logger);
+                    std::shared_ptr<Logger> logger,
+                    OtBackend ot_backend = OtBackend::kOtExtension);
   ~OtProviderManager();
 
   std::vector<std::unique_ptr<OtProvider>>& GetProviders() { return providers_; }
   OtProvider& GetProvider(std::size_t party_id) { return *providers_.at(party_id); }
 
+  /// \brief Replaces the OT providers by providers that generate the OTs with ot_backend.
+  /// \throws std::logic_error if OTs were already registered at the current providers.
+  /// \throws std::invalid_argument if ot_backend is invalid.
+  void SetOtBackend(OtBackend ot_backend);
+
+  OtBackend GetOtBackend() const noexcept { return ot_backend_; }
+
  private:
   communication::CommunicationLayer& communication_layer_;
+  const BaseOtProvider& base_ot_provider_;
+  BaseProvider& motion_base_provider_;
+  std::shared_ptr<Logger> logger_;
+  OtBackend ot_backend_;
   std::size_t number_of_parties_;
   std::vector<std::unique_ptr<OtProvider>> providers_;
   std::vector<std::unique_ptr<OtExtensionData>> data_;
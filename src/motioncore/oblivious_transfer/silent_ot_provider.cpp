@@ -0,0 +1,432 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "silent_ot_provider.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "base/motion_base_provider.h"
+#include "communication/ot_extension_message.h"
+#include "data_storage/base_ot_data.h"
+#include "data_storage/ot_extension_data.h"
+#include "primitives/pseudo_random_generator.h"
+#include "utility/bit_matrix.h"
+#include "utility/block.h"
+#include "utility/constants.h"
+#include "utility/fiber_condition.h"
+
+namespace encrypto::motion {
+
+namespace {
+
+constexpr std::size_t kTreeSize{std::size_t(1) << kSilentOtTreeDepth};
+constexpr std::size_t kNumberOfTreeCots{kSilentOtNumberOfTrees * kSilentOtTreeDepth};
+
+// public seed of the LPN matrix, which is the same for all parties and iterations
+constexpr std::array<std::uint8_t, 16> kLpnMatrixSeed{0x4d, 0x4f, 0x54, 0x49, 0x4f, 0x4e,
+                                                      0x2d, 0x4c, 0x50, 0x4e, 0x2d, 0x53,
+                                                      0x45, 0x45, 0x44, 0x00};
+
+// calls function(j, rows) for every column j of the public LPN matrix, where rows points to the
+// kSilentOtLpnColumnWeight indices of the non-zero entries in column j
+template <typename Function>
+void ForEachLpnColumn(Function function) {
+  constexpr std::size_t kBatchSize{4096};
+  constexpr std::size_t kBatchBytes{kBatchSize * kSilentOtLpnColumnWeight * sizeof(std::uint32_t)};
+  static_assert(kBatchBytes % kAesBlockSize == 0);
+  primitives::Prg prg;
+  prg.SetKey(kLpnMatrixSeed.data());
+  for (std::size_t batch_offset = 0; batch_offset < kSilentOtLpnOutputSize;
+       batch_offset += kBatchSize) {
+    prg.SetOffset(batch_offset / kBatchSize * (kBatchBytes / kAesBlockSize));
+    auto random_bytes{prg.Encrypt(kBatchBytes)};
+    auto rows{reinterpret_cast<std::uint32_t*>(random_bytes.data())};
+    const std::size_t batch_end{std::min(batch_offset + kBatchSize, kSilentOtLpnOutputSize)};
+    for (std::size_t j = batch_offset; j < batch_end; ++j) {
+      for (std::size_t r = 0; r < kSilentOtLpnColumnWeight; ++r) {
+        rows[r] &= kSilentOtLpnSecretSize - 1;
+      }
+      function(j, rows);
+      rows += kSilentOtLpnColumnWeight;
+    }
+  }
+}
+
+// output[j] ^= sum_r secret[A_{r,j}]
+void LpnEncode(const Block128* secret, Block128* output) {
+  ForEachLpnColumn([secret, output](std::size_t j, const std::uint32_t* rows) {
+    for (std::size_t r = 0; r < kSilentOtLpnColumnWeight; ++r) output[j] ^= secret[rows[r]];
+  });
+}
+
+// output_j ^= sum_r secret_{A_{r,j}}
+void LpnEncode(const AlignedBitVector& secret, AlignedBitVector& output) {
+  ForEachLpnColumn([&secret, &output](std::size_t j, const std::uint32_t* rows) {
+    bool bit{false};
+    for (std::size_t r = 0; r < kSilentOtLpnColumnWeight; ++r) bit ^= secret.Get(rows[r]);
+    if (bit) output.Set(!output.Get(j), j);
+  });
+}
+
+// expands the nodes[0, 2^level) of a GGM tree level in place to the nodes[0, 2^(level + 1)) of the
+// next level. The children of unknown_node are set to zero instead.
+void ExpandGgmLevel(Block128* nodes, std::size_t level, primitives::Prg& prg_left,
+                    primitives::Prg& prg_right, std::size_t unknown_node = kTreeSize) {
+  for (std::size_t j = (std::size_t(1) << level); j-- > 0;) {
+    const Block128 seed{nodes[j]};
+    if (j == unknown_node) {
+      nodes[2 * j].SetToZero();
+      nodes[2 * j + 1].SetToZero();
+      continue;
+    }
+    nodes[2 * j + 1] = seed;
+    prg_right.Mmo(nodes[2 * j + 1].data());
+    nodes[2 * j] = seed;
+    prg_left.Mmo(nodes[2 * j].data());
+  }
+}
+
+// correlation robust hash for deriving chosen-message OTs from COTs
+Block128 Hash(primitives::Prg& prg_fixed_key, const Block128& input, std::size_t tweak) {
+  Block128 output;
+  prg_fixed_key.FixedKeyAes(input.data(), tweak, output.data());
+  return output;
+}
+
+// hashes a 128-bit COT output into a random OT output of the given bit length in the same way as
+// BitMatrix::SenderTransposeAndEncrypt and BitMatrix::ReceiverTransposeAndEncrypt
+BitVector<> HashToOutput(primitives::Prg& prg_fixed_key, const Block128& input,
+                         std::size_t bitlength) {
+  BitVector<> output(input.data(), kKappa);
+  prg_fixed_key.Mmo(output.GetMutableData().data());
+  if (bitlength <= kKappa) {
+    output.Resize(bitlength);
+  } else {
+    primitives::Prg prg_variable_key;
+    prg_variable_key.SetKey(output.GetData().data());
+    output = BitVector<>(prg_variable_key.Encrypt(BitsToBytes(bitlength)), bitlength);
+  }
+  return output;
+}
+
+// sets the keys of the two length-doubling halves of the GGM tree PRG
+void SetGgmKeys(const std::vector<std::uint8_t>& fixed_key, primitives::Prg& prg_left,
+                primitives::Prg& prg_right) {
+  std::array<std::uint8_t, kAesKeySize> key;
+  std::copy_n(fixed_key.data(), kAesKeySize, key.data());
+  key[0] ^= 0x01;
+  prg_left.SetKey(key.data());
+  key[0] ^= 0x03;
+  prg_right.SetKey(key.data());
+}
+
+}  // namespace
+
+OtProviderFromSilentOt::OtProviderFromSilentOt(
+    std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function, OtExtensionData& data,
+    const BaseOtData& base_ot_data, BaseProvider& motion_base_provider, std::size_t party_id,
+    std::shared_ptr<Logger> logger)
+    : OtProvider(send_function, data, party_id, logger),
+      base_ot_data_(base_ot_data),
+      motion_base_provider_(motion_base_provider) {
+  auto& ot_extension_receiver_data = data_.GetReceiverData();
+  ot_extension_receiver_data.real_choices = std::make_unique<BitVector<>>();
+}
+
+Block128Vector OtProviderFromSilentOt::SendBootstrapCots() {
+  constexpr std::size_t kBitSize{kSilentOtNumberOfBootstrapCots};
+  constexpr std::size_t kBitSizePadded{(kBitSize + kKappa - 1) / kKappa * kKappa};
+  static_assert(kBitSize <= kOtExtensionChunkSize);
+
+  const auto& base_ots_receiver_data = base_ot_data_.GetReceiverData();
+  auto& ot_extension_sender_data = data_.GetSenderData();
+
+  // the receiver sends the masks as a single chunk of the IKNP bit matrix
+  {
+    std::scoped_lock lock(ot_extension_sender_data.u_mutex);
+    ot_extension_sender_data.u.resize(kKappa);
+    ot_extension_sender_data.number_of_received_us.assign(1, 0);
+  }
+  ot_extension_sender_data.bit_size = kBitSize;
+
+  std::vector<AlignedBitVector> v(kKappa);
+  primitives::Prg prg_variable_key;
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    prg_variable_key.SetKey(base_ots_receiver_data.messages_c.at(i).data());
+    prg_variable_key.SetOffset(base_ots_receiver_data.consumed_offset);
+    v[i] = AlignedBitVector(prg_variable_key.Encrypt(kBitSizePadded / 8), kBitSizePadded);
+  }
+
+  {
+    std::unique_lock lock(ot_extension_sender_data.u_mutex);
+    ot_extension_sender_data.u_condition.wait(lock, [&ot_extension_sender_data] {
+      return ot_extension_sender_data.number_of_received_us[0] == kKappa;
+    });
+  }
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    if (base_ots_receiver_data.c[i]) {
+      BitSpan bs(v[i].GetMutableData().data(), kBitSize, true);
+      bs ^= ot_extension_sender_data.u[i];
+    }
+  }
+  {
+    std::scoped_lock lock(ot_extension_sender_data.u_mutex);
+    ot_extension_sender_data.u = {};
+    ot_extension_sender_data.number_of_received_us = {};
+  }
+
+  std::array<const std::byte*, kKappa> pointers;
+  for (std::size_t i = 0; i < kKappa; ++i) pointers[i] = v[i].GetData().data();
+  Block128Vector q(kBitSizePadded);
+  BitMatrix::TransposeToBlocks(pointers, q.data(), kBitSizePadded);
+  q.resize(kBitSize);
+  return q;
+}
+
+Block128Vector OtProviderFromSilentOt::ReceiveBootstrapCots(AlignedBitVector& choices) {
+  constexpr std::size_t kBitSize{kSilentOtNumberOfBootstrapCots};
+  constexpr std::size_t kBitSizePadded{(kBitSize + kKappa - 1) / kKappa * kKappa};
+
+  const auto& base_ots_sender_data = base_ot_data_.GetSenderData();
+
+  choices = AlignedBitVector::SecureRandom(kBitSize);
+
+  std::vector<AlignedBitVector> v(kKappa);
+  primitives::Prg prg_variable_key;
+  for (std::size_t i = 0; i < kKappa; ++i) {
+    // T[j] = Prg(s_{j,0})
+    prg_variable_key.SetKey(base_ots_sender_data.messages_0.at(i).data());
+    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
+    v[i] = AlignedBitVector(prg_variable_key.Encrypt(kBitSizePadded / 8), kBitSizePadded);
+    // u_j = T[j] XOR r XOR Prg(s_{j,1})
+    auto u = v[i];
+    u ^= choices;
+    prg_variable_key.SetKey(base_ots_sender_data.messages_1.at(i).data());
+    prg_variable_key.SetOffset(base_ots_sender_data.consumed_offset);
+    u ^= AlignedBitVector(prg_variable_key.Encrypt(kBitSizePadded / 8), kBitSizePadded);
+    send_function_(communication::BuildOtExtensionMessageReceiverMasks(u.GetData().data(),
+                                                                       BitsToBytes(kBitSize), i));
+  }
+
+  std::array<const std::byte*, kKappa> pointers;
+  for (std::size_t i = 0; i < kKappa; ++i) pointers[i] = v[i].GetData().data();
+  Block128Vector t(kBitSizePadded);
+  BitMatrix::TransposeToBlocks(pointers, t.data(), kBitSizePadded);
+  t.resize(kBitSize);
+  return t;
+}
+
+void OtProviderFromSilentOt::SendSetup() {
+  const auto& base_ots_receiver_data = base_ot_data_.GetReceiverData();
+  auto& ot_extension_sender_data = data_.GetSenderData();
+
+  const std::size_t number_of_ots = sender_provider_.GetNumOts();
+  if (number_of_ots == 0) return;  // no OTs needed
+
+  motion_base_provider_.Setup();
+  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
+  primitives::Prg prg_fixed_key, prg_left, prg_right;
+  prg_fixed_key.SetKey(fixed_key_aes_key.data());
+  SetGgmKeys(fixed_key_aes_key, prg_left, prg_right);
+
+  // the global correlation of the COTs is the choice vector of the base OTs, as in IKNP
+  const Block128 delta{Block128::MakeFromMemory(base_ots_receiver_data.c.GetData().data())};
+
+  // COTs for the current iteration: the LPN secret followed by one COT per GGM tree level
+  Block128Vector bootstrap{SendBootstrapCots()};
+
+  const std::size_t number_of_iterations =
+      (number_of_ots + kSilentOtNumberOfOutputs - 1) / kSilentOtNumberOfOutputs;
+  Block128Vector q(kSilentOtLpnOutputSize);
+  Block128Vector message(2 * kNumberOfTreeCots + kSilentOtNumberOfTrees);
+  std::array<Block128, kSilentOtTreeDepth> left_sums, right_sums;
+
+  for (std::size_t iteration = 0; iteration < number_of_iterations; ++iteration) {
+    // single-point COTs: expand a GGM tree with random leaves per noise block
+    for (std::size_t tree = 0; tree < kSilentOtNumberOfTrees; ++tree) {
+      Block128* leaves{q.data() + tree * kTreeSize};
+      leaves[0] = Block128::MakeRandom();
+      for (std::size_t level = 0; level < kSilentOtTreeDepth; ++level) {
+        ExpandGgmLevel(leaves, level, prg_left, prg_right);
+        left_sums[level].SetToZero();
+        right_sums[level].SetToZero();
+        for (std::size_t j = 0; j < (std::size_t(2) << level); j += 2) {
+          left_sums[level] ^= leaves[j];
+          right_sums[level] ^= leaves[j + 1];
+        }
+      }
+      // the receiver learns the level sums on the other side of its punctured path via
+      // chosen-message OTs derived from the bootstrap COTs
+      auto& leaf_sum{message[2 * kNumberOfTreeCots + tree]};
+      leaf_sum = delta;
+      for (std::size_t j = 0; j < kTreeSize; ++j) leaf_sum ^= leaves[j];
+      for (std::size_t level = 0; level < kSilentOtTreeDepth; ++level) {
+        message[2 * (tree * kSilentOtTreeDepth + level)] = left_sums[level];
+        message[2 * (tree * kSilentOtTreeDepth + level) + 1] = right_sums[level];
+      }
+    }
+
+    const auto corrections{ot_extension_sender_data.silent_ot_corrections_future.get()};
+    for (std::size_t i = 0; i < kNumberOfTreeCots; ++i) {
+      const auto& cot{bootstrap[kSilentOtLpnSecretSize + i]};
+      const std::size_t tweak{iteration * kNumberOfTreeCots + i};
+      // the receiver's COT choice bit is its real choice bit XOR correction
+      const Block128 cot_correlated{cot ^ delta};
+      const bool correction{corrections.Get(i)};
+      message[2 * i] ^= Hash(prg_fixed_key, correction ? cot_correlated : cot, tweak);
+      message[2 * i + 1] ^= Hash(prg_fixed_key, correction ? cot : cot_correlated, tweak);
+    }
+    send_function_(communication::BuildSilentOtMessageSender(
+        reinterpret_cast<const std::byte*>(message.data()), message.ByteSize(), iteration));
+
+    // q = bootstrap_secret * A XOR v
+    LpnEncode(bootstrap.data(), q.data());
+
+    // compute the random OTs of this iteration
+    const std::size_t ot_offset{iteration * kSilentOtNumberOfOutputs};
+    const std::size_t ot_end{std::min(ot_offset + kSilentOtNumberOfOutputs, number_of_ots)};
+    for (std::size_t ot_id = ot_offset; ot_id < ot_end; ++ot_id) {
+      const auto bitlength{ot_extension_sender_data.bitlengths[ot_id]};
+      const auto& cot{q[ot_id - ot_offset]};
+      ot_extension_sender_data.y0[ot_id] = HashToOutput(prg_fixed_key, cot, bitlength);
+      ot_extension_sender_data.y1[ot_id] = HashToOutput(prg_fixed_key, cot ^ delta, bitlength);
+    }
+    {
+      std::scoped_lock lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
+      ot_extension_sender_data.number_of_ready_ots = ot_end;
+    }
+    ot_extension_sender_data.setup_finished_condition->NotifyAll();
+
+    // keep the last COTs for the next iteration
+    std::copy(q.end() - kSilentOtNumberOfBootstrapCots, q.end(), bootstrap.begin());
+  }
+
+  {
+    std::scoped_lock lock(ot_extension_sender_data.setup_finished_condition->GetMutex());
+    ot_extension_sender_data.setup_finished = true;
+  }
+  ot_extension_sender_data.setup_finished_condition->NotifyAll();
+}
+
+void OtProviderFromSilentOt::ReceiveSetup() {
+  auto& ot_extension_receiver_data = data_.GetReceiverData();
+
+  const std::size_t number_of_ots = receiver_provider_.GetNumOts();
+  if (number_of_ots == 0) return;  // nothing to do
+
+  motion_base_provider_.Setup();
+  const auto& fixed_key_aes_key = motion_base_provider_.GetAesFixedKey();
+  primitives::Prg prg_fixed_key, prg_left, prg_right;
+  prg_fixed_key.SetKey(fixed_key_aes_key.data());
+  SetGgmKeys(fixed_key_aes_key, prg_left, prg_right);
+
+  ot_extension_receiver_data.random_choices = std::make_unique<AlignedBitVector>(number_of_ots);
+
+  // COTs for the current iteration: the LPN secret followed by one COT per GGM tree level
+  AlignedBitVector bootstrap_choices;
+  Block128Vector bootstrap{ReceiveBootstrapCots(bootstrap_choices)};
+
+  const std::size_t number_of_iterations =
+      (number_of_ots + kSilentOtNumberOfOutputs - 1) / kSilentOtNumberOfOutputs;
+  Block128Vector t(kSilentOtLpnOutputSize);
+
+  for (std::size_t iteration = 0; iteration < number_of_iterations; ++iteration) {
+    // the punctured points, i.e., the positions of the noise in each block
+    const auto punctured_points{BitVector<>::SecureRandom(kNumberOfTreeCots)};
+    // choose the level sum that is not on the path to the punctured point
+    BitVector<> corrections(kNumberOfTreeCots);
+    for (std::size_t i = 0; i < kNumberOfTreeCots; ++i) {
+      corrections.Set(bootstrap_choices.Get(kSilentOtLpnSecretSize + i) == punctured_points.Get(i),
+                      i);
+    }
+    send_function_(communication::BuildSilentOtMessageReceiverCorrections(
+        corrections.GetData().data(), corrections.GetData().size(), iteration));
+
+    const auto message{ot_extension_receiver_data.silent_ot_sender_message_future.get()};
+    AlignedBitVector choices(kSilentOtLpnOutputSize);
+    for (std::size_t tree = 0; tree < kSilentOtNumberOfTrees; ++tree) {
+      Block128* leaves{t.data() + tree * kTreeSize};
+      std::size_t punctured_node{0};
+      leaves[0].SetToZero();
+      for (std::size_t level = 0; level < kSilentOtTreeDepth; ++level) {
+        const std::size_t i{tree * kSilentOtTreeDepth + level};
+        const bool path{punctured_points.Get(i)};
+        ExpandGgmLevel(leaves, level, prg_left, prg_right, punctured_node);
+        // the sibling of the punctured path is the received level sum XOR all known nodes on its
+        // side of the level
+        const bool sibling_side{!path};
+        const std::size_t tweak{iteration * kNumberOfTreeCots + i};
+        Block128 sibling{message[2 * i + sibling_side] ^
+                         Hash(prg_fixed_key, bootstrap[kSilentOtLpnSecretSize + i], tweak)};
+        for (std::size_t j = sibling_side; j < (std::size_t(2) << level); j += 2) {
+          sibling ^= leaves[j];
+        }
+        leaves[2 * punctured_node + sibling_side] = sibling;
+        punctured_node = 2 * punctured_node + path;
+      }
+      // w_alpha = Delta XOR v_alpha
+      auto& punctured_leaf{leaves[punctured_node]};
+      punctured_leaf = message[2 * kNumberOfTreeCots + tree];
+      for (std::size_t j = 0; j < kTreeSize; ++j) {
+        if (j != punctured_node) punctured_leaf ^= leaves[j];
+      }
+      choices.Set(true, tree * kTreeSize + punctured_node);
+    }
+
+    // choices = bootstrap_choices * A XOR e, t = bootstrap_secret * A XOR w
+    LpnEncode(bootstrap_choices, choices);
+    LpnEncode(bootstrap.data(), t.data());
+
+    // compute the random OTs of this iteration
+    const std::size_t ot_offset{iteration * kSilentOtNumberOfOutputs};
+    const std::size_t ot_end{std::min(ot_offset + kSilentOtNumberOfOutputs, number_of_ots)};
+    ot_extension_receiver_data.random_choices->Copy(ot_offset, ot_end,
+                                                    choices.Subset(0, ot_end - ot_offset));
+    for (std::size_t ot_id = ot_offset; ot_id < ot_end; ++ot_id) {
+      const auto bitlength{ot_extension_receiver_data.bitlengths[ot_id]};
+      ot_extension_receiver_data.outputs[ot_id] =
+          HashToOutput(prg_fixed_key, t[ot_id - ot_offset], bitlength);
+    }
+    {
+      std::scoped_lock lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
+      ot_extension_receiver_data.number_of_ready_ots = ot_end;
+    }
+    ot_extension_receiver_data.setup_finished_condition->NotifyAll();
+
+    // keep the last COTs for the next iteration
+    bootstrap_choices = choices.Subset(kSilentOtLpnOutputSize - kSilentOtNumberOfBootstrapCots,
+                                       kSilentOtLpnOutputSize);
+    std::copy(t.end() - kSilentOtNumberOfBootstrapCots, t.end(), bootstrap.begin());
+  }
+
+  {
+    std::scoped_lock lock(ot_extension_receiver_data.setup_finished_condition->GetMutex());
+    ot_extension_receiver_data.setup_finished = true;
+  }
+  ot_extension_receiver_data.setup_finished_condition->NotifyAll();
+}
+
+}  // namespace encrypto::motion
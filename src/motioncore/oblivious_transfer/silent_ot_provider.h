@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "ot_provider.h"
+
+namespace encrypto::motion {
+
+struct Block128Vector;
+
+// Parameters of the regular LPN problem used by the silent OT generator (cf. Ferret, Yang et al.,
+// CCS'20): every iteration outputs kSilentOtLpnOutputSize COTs, which are computed from
+// kSilentOtLpnSecretSize COTs via a public sparse matrix with kSilentOtLpnColumnWeight non-zero
+// entries per column and a regular noise vector with one non-zero entry in each of the
+// kSilentOtNumberOfTrees blocks of 2^kSilentOtTreeDepth entries.
+constexpr std::size_t kSilentOtLpnOutputSize{470016};
+constexpr std::size_t kSilentOtLpnSecretSize{32768};
+constexpr std::size_t kSilentOtLpnColumnWeight{10};
+constexpr std::size_t kSilentOtNumberOfTrees{918};
+constexpr std::size_t kSilentOtTreeDepth{9};
+
+// number of COTs that an iteration consumes: the LPN secret and one COT per GGM tree level
+constexpr std::size_t kSilentOtNumberOfBootstrapCots{kSilentOtLpnSecretSize +
+                                                     kSilentOtNumberOfTrees * kSilentOtTreeDepth};
+
+// number of OTs that an iteration outputs; the last kSilentOtNumberOfBootstrapCots COTs are kept
+// for the next iteration and the count is rounded down to bytes in the choice bit vector
+constexpr std::size_t kSilentOtNumberOfOutputs{
+    (kSilentOtLpnOutputSize - kSilentOtNumberOfBootstrapCots) / 128 * 128};
+
+static_assert(kSilentOtLpnOutputSize == kSilentOtNumberOfTrees << kSilentOtTreeDepth);
+static_assert((kSilentOtLpnSecretSize & (kSilentOtLpnSecretSize - 1)) == 0);
+
+/// \brief Generates the random OTs from a pseudorandom correlation generator instead of IKNP
+/// OT extension. The COTs are expanded iteration by iteration from a regular LPN instance whose
+/// noise is distributed via GGM-tree based single-point COTs. Only the first iteration is
+/// bootstrapped with kSilentOtNumberOfBootstrapCots COTs from IKNP OT extension, every following
+/// iteration reuses a part of the previous output. Thus, the communication is sublinear in the
+/// number of OTs. The random OTs are stored in the same format as by OtProviderFromOtExtension,
+/// such that all OT flavors work with both providers. Secure against semi-honest adversaries.
+class OtProviderFromSilentOt final : public OtProvider {
+ public:
+  void SendSetup() final;
+
+  void ReceiveSetup() final;
+
+  OtProviderFromSilentOt(std::function<void(flatbuffers::FlatBufferBuilder&&)> send_function,
+                         OtExtensionData& data, const BaseOtData& base_ot_data, BaseProvider&,
+                         std::size_t party_id, std::shared_ptr<Logger> logger);
+
+ private:
+  // computes the sender's kSilentOtNumberOfBootstrapCots COTs via IKNP OT extension
+  Block128Vector SendBootstrapCots();
+
+  // computes the receiver's kSilentOtNumberOfBootstrapCots COTs via IKNP OT extension and stores
+  // their choice bits in choices
+  Block128Vector ReceiveBootstrapCots(AlignedBitVector& choices);
+
+  const BaseOtData& base_ot_data_;
+  BaseProvider& motion_base_provider_;
+};
+
+}  // namespace encrypto::motion
@@ -350,3 +350,98 @@ void AesniBmrDkc(const void* round_keys_input, const void* key_a, const void* ke
     out[party_id] ^= AesniXorEncrypt(round_keys, tmp);
   }
 }
+
+void AesniBmrDkcBatch(const void* round_keys_input, const void* keys_a, const void* keys_b,
+                      std::uint64_t gate_id, std::size_t number_of_simd,
+                      std::size_t number_of_parties, void* output_input_pointer) {
+  // number of AES blocks which are encrypted in an interleaved fashion
+  constexpr std::size_t kBatchSize = 16;
+  alignas(16) std::array<__m128i, kAesNumRoundKeys128> round_keys;
+  alignas(64) std::array<__m128i, kBatchSize> input;
+  alignas(64) std::array<__m128i, kBatchSize> wb;
+  std::array<std::size_t, kBatchSize> output_indices;
+
+  // copy the round keys onto the stack
+  // -> compiler will put them into registers
+  std::copy(reinterpret_cast<const __m128i*>(
+                __builtin_assume_aligned(round_keys_input, kAesBlockSize)),
+            reinterpret_cast<const __m128i*>(
+                __builtin_assume_aligned(round_keys_input, kAesBlockSize)) +
+                kAesNumRoundKeys128,
+            round_keys.data());
+#if defined(MOTION_AVX512_VAES)
+  alignas(64) std::array<__m512i, kAesNumRoundKeys128> round_keys_512;
+  for (std::size_t i = 0; i < kAesNumRoundKeys128; ++i) {
+    round_keys_512[i] = _mm512_broadcast_i32x4(round_keys[i]);
+  }
+#endif
+  auto keys_a_pointer =
+      reinterpret_cast<const __m128i*>(__builtin_assume_aligned(keys_a, kAesBlockSize));
+  auto keys_b_pointer =
+      reinterpret_cast<const __m128i*>(__builtin_assume_aligned(keys_b, kAesBlockSize));
+  auto output =
+      reinterpret_cast<__m128i*>(__builtin_assume_aligned(output_input_pointer, kAesBlockSize));
+
+  const auto number_of_blocks = number_of_simd * number_of_parties * number_of_parties;
+  if (number_of_blocks == 0) {
+    return;
+  }
+  input.fill(_mm_setzero_si128());
+
+  // block (simd_i, party_i, party_j) uses the keys of party_i and is xored into output block
+  // (simd_i, party_j)
+  std::size_t simd_i = 0, party_i = 0, party_j = 0;
+  __m128i mixed_keys = AesniMixKeys(keys_a_pointer[0], keys_b_pointer[0]);
+  for (std::size_t block_i = 0; block_i < number_of_blocks; block_i += kBatchSize) {
+    const auto batch_size = std::min(kBatchSize, number_of_blocks - block_i);
+    for (std::size_t j = 0; j < batch_size; ++j) {
+      input[j] = mixed_keys ^ _mm_set_epi64x(gate_id + simd_i, party_j);
+      output_indices[j] = simd_i * number_of_parties + party_j;
+      if (++party_j == number_of_parties) {
+        party_j = 0;
+        if (++party_i == number_of_parties) {
+          party_i = 0;
+          ++simd_i;
+        }
+        if (simd_i < number_of_simd) {
+          const auto key_i = simd_i * number_of_parties + party_i;
+          mixed_keys = AesniMixKeys(keys_a_pointer[key_i], keys_b_pointer[key_i]);
+        }
+      }
+    }
+
+    // encrypt the whole batch, the unused blocks of the last batch are ignored
+#if defined(MOTION_AVX512_VAES)
+    // each 512 bit register holds four blocks
+    constexpr std::size_t kNumberOfRegisters = kBatchSize / 4;
+    std::array<__m512i, kNumberOfRegisters> wb_512;
+    for (std::size_t j = 0; j < kNumberOfRegisters; ++j) {
+      wb_512[j] = _mm512_xor_si512(_mm512_load_si512(&input[4 * j]), round_keys_512[0]);
+    }
+    for (std::size_t round = 1; round < kAesNumRoundKeys128 - 1; ++round) {
+      for (std::size_t j = 0; j < kNumberOfRegisters; ++j) {
+        wb_512[j] = _mm512_aesenc_epi128(wb_512[j], round_keys_512[round]);
+      }
+    }
+    for (std::size_t j = 0; j < kNumberOfRegisters; ++j) {
+      wb_512[j] = _mm512_aesenclast_epi128(wb_512[j], round_keys_512[kAesNumRoundKeys128 - 1]);
+      _mm512_store_si512(&wb[4 * j], wb_512[j]);
+    }
+#else
+    for (std::size_t j = 0; j < kBatchSize; ++j) wb[j] = _mm_xor_si128(input[j], round_keys[0]);
+    for (std::size_t round = 1; round < kAesNumRoundKeys128 - 1; ++round) {
+      for (std::size_t j = 0; j < kBatchSize; ++j) {
+        wb[j] = _mm_aesenc_si128(wb[j], round_keys[round]);
+      }
+    }
+    for (std::size_t j = 0; j < kBatchSize; ++j) {
+      wb[j] = _mm_aesenclast_si128(wb[j], round_keys[kAesNumRoundKeys128 - 1]);
+    }
+#endif
+
+    // several blocks of a batch may target the same output block
+    for (std::size_t j = 0; j < batch_size; ++j) {
+      output[output_indices[j]] ^= wb[j] ^ input[j];
+    }
+  }
+}
@@ -79,3 +79,17 @@ void AesniMmoSingle(const void* round_keys, void* input);
 // The output is xored into `output`.
 void AesniBmrDkc(const void* round_keys, const void* key_a, const void* key_b,
                  std::uint64_t gate_id, std::size_t number_of_parties, void* output);
+
+// Batched AesniBmrDkc for evaluating number_of_simd garbled rows at once.
+//
+// keys_a, keys_b and output are arrays of number_of_simd * number_of_parties
+// blocks.  For each simd_i and each party_i, this computes
+//    AesniBmrDkc(round_keys, keys_a[k], keys_b[k], gate_id + simd_i,
+//                number_of_parties, output + simd_i * number_of_parties)
+// where k = simd_i * number_of_parties + party_i.  The AES invocations are
+// interleaved and use VAES if MOTION_AVX512_VAES is defined.
+//
+// * round_keys, keys_a, keys_b and output are 16B aligned
+void AesniBmrDkcBatch(const void* round_keys, const void* keys_a, const void* keys_b,
+                      std::uint64_t gate_id, std::size_t number_of_simd,
+                      std::size_t number_of_parties, void* output);
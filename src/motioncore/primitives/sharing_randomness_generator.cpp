@@ -24,6 +24,10 @@
 
 #include "sharing_randomness_generator.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 namespace encrypto::motion::primitives {
 
 SharingRandomnessGenerator::SharingRandomnessGenerator(std::size_t party_id)
@@ -57,6 +61,10 @@ void SharingRandomnessGenerator::Initialize(
 
   prg_a.SetKey(raw_key_arithmetic_);
   prg_b.SetKey(raw_key_boolean_);
+  {
+    auto digest = HashKey(master_seed_, KeyType::kArithmeticGmwStreamKey);
+    prg_arithmetic_stream_.SetKey(digest.data());
+  }
 
   {
     std::scoped_lock lock(initialized_condition_->GetMutex());
@@ -84,27 +92,11 @@ BitVector<> SharingRandomnessGenerator::GetBits(const std::size_t gate_id,
   constexpr std::size_t kBytesInBatch = kBitsInBatch / 8;
 
   while (random_bits_.GetSize() < (gate_id - random_bits_offset_ + number_of_bits)) {
-    std::vector<std::byte> input(kBytesInBatch + AES_BLOCK_SIZE),
-        output(kBytesInBatch + AES_BLOCK_SIZE);
-    for (auto offset = random_bits_.GetSize() / kAesBlockSize; offset < kCipherTextsInBatch;
-         ++offset) {
-      auto pointer = reinterpret_cast<std::uint8_t*>(input.data()) + offset * kAesBlockSize;
-      // copy nonce
-      std::copy(std::begin(aes_ctr_nonce_boolean_), std::end(aes_ctr_nonce_boolean_), pointer);
-      // copy counter value
-      *reinterpret_cast<uint64_t*>(pointer + kAesBlockSize / 2) = offset;
-    }
-
-    // encrypt as in CTR mode, but without sequentially incrementing the counter
-    // after each encryption
-    std::vector<std::byte> output_bytes =
-        prg_b.Encrypt(input.data(), kCipherTextsInBatch * AES_BLOCK_SIZE);
-
-    for (auto i = 0ull; i < kBytesInBatch; ++i) {
-      output_bytes.push_back(std::byte(output.at(i)));
-    }
-    auto randomness = BitVector(std::move(output_bytes), kBitsInBatch);
-    random_bits_.Append(randomness);
+    // AES in counter mode, the counter continues across batches
+    std::vector<std::byte> output_bytes(kBytesInBatch);
+    AesniCtrStreamBlocks128Unaligned(prg_b.GetRoundKeys(), &random_bits_counter_,
+                                     output_bytes.data(), kCipherTextsInBatch);
+    random_bits_.Append(BitVector(std::move(output_bytes), kBitsInBatch));
   }
 
   const auto requested = gate_id - random_bits_offset_ + number_of_bits;
@@ -117,6 +109,48 @@ BitVector<> SharingRandomnessGenerator::GetBits(const std::size_t gate_id,
                              gate_id + number_of_bits - random_bits_offset_);
 }
 
+void SharingRandomnessGenerator::FillArithmeticStream(std::size_t stream_id,
+                                                      std::size_t byte_offset, std::byte* output,
+                                                      std::size_t number_of_bytes) {
+  if (number_of_bytes == 0) {
+    return;
+  }
+
+  initialized_condition_->Wait();
+
+  assert(stream_id < (1ull << (64 - kStreamIdShift)));
+  assert((byte_offset + number_of_bytes) / kAesBlockSize < (1ull << kStreamIdShift));
+  const auto round_keys = prg_arithmetic_stream_.GetRoundKeys();
+  std::uint64_t counter = (static_cast<std::uint64_t>(stream_id) << kStreamIdShift) |
+                          static_cast<std::uint64_t>(byte_offset / kAesBlockSize);
+  alignas(kAesBlockSize) std::array<std::byte, kAesBlockSize> block;
+
+  // the first block may be used only partially
+  if (const auto skip = byte_offset % kAesBlockSize; skip != 0) {
+    AesniCtrStreamBlocks128(round_keys, &counter, block.data(), 1);
+    const auto length = std::min(kAesBlockSize - skip, number_of_bytes);
+    std::copy_n(block.data() + skip, length, output);
+    output += length;
+    number_of_bytes -= length;
+  }
+
+  if (const auto number_of_blocks = number_of_bytes / kAesBlockSize; number_of_blocks > 0) {
+    if (reinterpret_cast<std::uintptr_t>(output) % kAesBlockSize == 0) {
+      AesniCtrStreamBlocks128(round_keys, &counter, output, number_of_blocks);
+    } else {
+      AesniCtrStreamBlocks128Unaligned(round_keys, &counter, output, number_of_blocks);
+    }
+    output += number_of_blocks * kAesBlockSize;
+    number_of_bytes -= number_of_blocks * kAesBlockSize;
+  }
+
+  // and so may the last one
+  if (number_of_bytes > 0) {
+    AesniCtrStreamBlocks128(round_keys, &counter, block.data(), 1);
+    std::copy_n(block.data(), number_of_bytes, output);
+  }
+}
+
 std::vector<std::uint8_t> SharingRandomnessGenerator::HashKey(
     const std::uint8_t seed[kMasterSeedByteLength], const KeyType key_type) {
   std::vector<std::uint8_t> seed_padded(seed, seed + kMasterSeedByteLength);
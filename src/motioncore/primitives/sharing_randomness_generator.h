@@ -25,7 +25,9 @@
 #pragma once
 
 #include <boost/fiber/mutex.hpp>
+#include <bit>
 #include <limits>
+#include <span>
 #include <thread>
 #include <vector>
 
@@ -146,6 +148,19 @@ class SharingRandomnessGenerator {
     return results;
   }
 
+  /// \brief Fills output with the pseudorandom values for the arithmetic sharing ids
+  ///        [sharing_id, sharing_id + output.size()).
+  ///
+  /// The values are read directly from an AES-NI counter-mode stream keyed once per pair of
+  /// parties, i.e., without intermediate buffers and modular reductions. Each bit length uses its
+  /// own stream, so sharing ids used with different types do not share randomness.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  void FillUnsigned(const std::size_t sharing_id, std::span<T> output) {
+    static_assert(sizeof(T) <= kAesBlockSize);
+    FillArithmeticStream(std::countr_zero(sizeof(T)), sharing_id * sizeof(T),
+                         reinterpret_cast<std::byte*>(output.data()), output.size_bytes());
+  }
+
   BitVector<> GetBits(const std::size_t gate_id, const std::size_t number_of_bits);
 
   void ClearBitPool();
@@ -155,6 +170,8 @@ class SharingRandomnessGenerator {
  private:
   static constexpr std::size_t kCounterOffset =
       AES_BLOCK_SIZE / 2;  /// Byte length of the AES-CTR nonce
+  /// The stream id is stored in the upper bits of the 64 bit AES-CTR counter
+  static constexpr std::size_t kStreamIdShift = 60;
   std::int64_t party_id_ = -1;
 
   /// AES context, created only once and reused further
@@ -171,16 +188,21 @@ class SharingRandomnessGenerator {
   std::uint8_t aes_ctr_nonce_boolean_[AES_BLOCK_SIZE / 2] = {0};  /// Raw AES CTR nonce that is used
   /// in the left part of IV
 
-  primitives::Prg prg_a, prg_b;
+  primitives::Prg prg_a, prg_b, prg_arithmetic_stream_;
 
   enum KeyType : uint {
     kArithmeticGmwKey = 0,
     kArithmeticGmwNonce = 1,
     kBooleanGmwKey = 2,
     kBooleanGmwNonce = 3,
-    kInvalidKeyType = 4
+    kArithmeticGmwStreamKey = 4,
+    kInvalidKeyType = 5
   };
 
+  // write number_of_bytes bytes of stream stream_id, starting at byte_offset, to output
+  void FillArithmeticStream(std::size_t stream_id, std::size_t byte_offset, std::byte* output,
+                            std::size_t number_of_bytes);
+
   // use a seed to generate randomness for a new key
   std::vector<std::uint8_t> HashKey(const std::uint8_t seed[kAesKeySize], const KeyType key_type);
 
@@ -190,6 +212,8 @@ class SharingRandomnessGenerator {
 
   std::size_t random_bits_offset_ = 0;
   std::size_t random_bits_used_ = 0;
+  /// AES-CTR counter of the next block of random bits
+  std::uint64_t random_bits_counter_ = 0;
 
   boost::fibers::mutex random_bits_mutex_;
 
@@ -34,11 +34,13 @@
 #include "communication/fbs_headers/output_message_generated.h"
 #include "communication/output_message.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/sb_provider.h"
 #include "multiplication_triple/sp_provider.h"
 #include "primitives/sharing_randomness_generator.h"
 #include "protocols/gate.h"
 #include "utility/fiber_condition.h"
 #include "utility/helpers.h"
+#include "utility/linear_algebra.h"
 #include "utility/logger.h"
 #include "utility/reusable_future.h"
 
@@ -81,7 +83,7 @@ class InputGate final : public motion::InputGate {
           fmt::format("Created an arithmetic_gmw::InputGate with global id {}", gate_id_));
     }
     output_wires_ = {std::static_pointer_cast<motion::Wire>(
-        std::make_shared<arithmetic_gmw::Wire<T>>(input_, backend_))};
+        GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(input_, backend_))};
     for (auto& w : output_wires_) {
       GetRegister().RegisterNextWire(w);
     }
@@ -114,14 +116,15 @@ class InputGate final : public motion::InputGate {
 
     if (static_cast<std::size_t>(input_owner_id_) == my_id) {
       result.resize(input_.size());
+      std::vector<T> randomness(input_.size());
       auto log_string = std::string("");
       for (auto party_id = 0u; party_id < number_of_parties; ++party_id) {
         if (party_id == my_id) {
           continue;
         }
         auto& randomness_generator = GetBaseProvider().GetMyRandomnessGenerator(party_id);
-        auto randomness =
-            randomness_generator.template GetUnsigned<T>(arithmetic_sharing_id_, input_.size());
+        randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_,
+                                                      std::span(randomness));
         if constexpr (kVerboseDebug) {
           log_string.append(fmt::format("id#{}:{} ", party_id, randomness.at(0)));
         }
@@ -142,7 +145,8 @@ class InputGate final : public motion::InputGate {
       }
     } else {
       auto& randomness_generator = GetBaseProvider().GetTheirRandomnessGenerator(input_owner_id_);
-      result = randomness_generator.template GetUnsigned<T>(arithmetic_sharing_id_, input_.size());
+      result.resize(input_.size());
+      randomness_generator.template FillUnsigned<T>(arithmetic_sharing_id_, std::span(result));
 
       if constexpr (kVerboseDebug) {
         auto s = fmt::format(
@@ -165,7 +169,7 @@ class InputGate final : public motion::InputGate {
   // case we need it multiple times
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire = GetOutputArithmeticWire();
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
@@ -195,24 +199,30 @@ class OutputGate final : public motion::OutputGate {
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     assert(arithmetic_wire);
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
   OutputGate(const arithmetic_gmw::WirePointer<T>& parent, std::size_t output_owner = kAll)
-      : Base(parent->GetBackend()) {
-    assert(parent);
-
-    if (parent->GetProtocol() != MpcProtocol::kArithmeticGmw) {
-      auto sharing_type = to_string(parent->GetProtocol());
-      throw(
-          std::runtime_error((fmt::format("Arithmetic output gate expects an arithmetic share, "
-                                          "got a share of type {}",
-                                          sharing_type))));
+      : OutputGate(std::vector<arithmetic_gmw::WirePointer<T>>{parent}, output_owner) {}
+
+  /// \brief Reconstructs all \p parents at once, i.e., the shares of all parents are sent in a
+  ///        single OutputMessage per peer. Output wire i holds the reconstruction of parent i.
+  OutputGate(const std::vector<arithmetic_gmw::WirePointer<T>>& parents,
+             std::size_t output_owner = kAll)
+      : Base(parents.at(0)->GetBackend()) {
+    for (const auto& parent : parents) {
+      assert(parent);
+      if (parent->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+        auto sharing_type = to_string(parent->GetProtocol());
+        throw(
+            std::runtime_error((fmt::format("Arithmetic output gate expects an arithmetic share, "
+                                            "got a share of type {}",
+                                            sharing_type))));
+      }
+      parent_.emplace_back(parent);
     }
 
-    parent_ = {parent};
-
     // values we need repeatedly
     auto& communication_layer = GetCommunicationLayer();
     auto my_id = communication_layer.GetMyId();
@@ -231,14 +241,18 @@ class OutputGate final : public motion::OutputGate {
     is_my_output_ = my_id == static_cast<std::size_t>(output_owner_) ||
                     static_cast<std::size_t>(output_owner_) == kAll;
 
-    RegisterWaitingFor(parent_.at(0)->GetWireId());
-    parent_.at(0)->RegisterWaitingGate(gate_id_);
+    for (auto& parent : parent_) {
+      RegisterWaitingFor(parent->GetWireId());
+      parent->RegisterWaitingGate(gate_id_);
+    }
 
-    {
+    output_wires_.reserve(parent_.size());
+    for (const auto& parent : parent_) {
       auto w = std::static_pointer_cast<motion::Wire>(
-          std::make_shared<arithmetic_gmw::Wire<T>>(backend_, parent->GetNumberOfSimdValues()));
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_,
+                                                            parent->GetNumberOfSimdValues()));
       GetRegister().RegisterNextWire(w);
-      output_wires_ = {std::move(w)};
+      output_wires_.emplace_back(std::move(w));
     }
 
     // Tell the DataStorages that we want to receive OutputMessages from the
@@ -249,8 +263,8 @@ class OutputGate final : public motion::OutputGate {
     }
 
     if constexpr (kDebug) {
-      auto gate_info = fmt::format("uint{}_t type, gate id {}, owner {}", sizeof(T) * 8, gate_id_,
-                                   output_owner_);
+      auto gate_info = fmt::format("uint{}_t type, gate id {}, owner {}, {} wires",
+                                   sizeof(T) * 8, gate_id_, output_owner_, parent_.size());
       GetLogger().LogDebug(fmt::format(
           "Allocate an arithmetic_gmw::OutputGate with following properties: {}", gate_info));
     }
@@ -284,74 +298,93 @@ class OutputGate final : public motion::OutputGate {
     auto my_id = communication_layer.GetMyId();
     auto number_of_parties = communication_layer.GetNumberOfParties();
 
-    // note that arithmetic gates have only a single wire
-    auto arithmetic_wire = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
-    assert(arithmetic_wire);
-    // wait for parent wire to obtain a value
-    arithmetic_wire->GetIsReadyCondition().Wait();
-    // initialize output with local share
-    auto output = arithmetic_wire->GetValues();
-
-    // we need to send shares to one other party:
-    if (!is_my_output_) {
-      auto payload = ToByteVector(output);
-      auto output_message = motion::communication::BuildOutputMessage(gate_id_, payload);
-      communication_layer.SendMessage(output_owner_, std::move(output_message));
+    const auto number_of_wires = parent_.size();
+
+    // initialize output with local shares
+    std::vector<std::vector<T>> output;
+    output.reserve(number_of_wires);
+    for (const auto& parent : parent_) {
+      auto arithmetic_wire = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent);
+      assert(arithmetic_wire);
+      // wait for parent wire to obtain a value
+      arithmetic_wire->GetIsReadyCondition().Wait();
+      output.emplace_back(arithmetic_wire->GetValues());
     }
-    // we need to send shares to all other parties:
-    else if (output_owner_ == kAll) {
-      auto payload = ToByteVector(output);
-      auto output_message = motion::communication::BuildOutputMessage(gate_id_, payload);
-      communication_layer.BroadcastMessage(std::move(output_message));
+
+    // we need to send shares
+    if (!is_my_output_ || output_owner_ == kAll) {
+      // one payload per wire, all of them in a single message
+      std::vector<std::vector<std::uint8_t>> payloads;
+      payloads.reserve(number_of_wires);
+      for (const auto& values : output) {
+        payloads.emplace_back(ToByteVector(values));
+      }
+      auto output_message = motion::communication::BuildOutputMessage(gate_id_, payloads);
+      // we need to send shares to one other party:
+      if (!is_my_output_) {
+        communication_layer.SendMessage(output_owner_, std::move(output_message));
+      }
+      // we need to send shares to all other parties:
+      else {
+        communication_layer.BroadcastMessage(std::move(output_message));
+      }
     }
 
     // we receive shares from other parties
     if (is_my_output_) {
       // collect shares from all parties
-      std::vector<std::vector<T>> shared_outputs;
-      shared_outputs.reserve(number_of_parties);
+      std::vector<std::vector<std::vector<T>>> shared_outputs(number_of_wires);
+      for (auto& shares : shared_outputs) {
+        shares.reserve(number_of_parties);
+      }
 
       for (std::size_t i = 0; i < number_of_parties; ++i) {
         if (i == my_id) {
-          shared_outputs.push_back(output);
+          for (std::size_t j = 0; j < number_of_wires; ++j) {
+            shared_outputs.at(j).push_back(output.at(j));
+          }
           continue;
         }
         const auto output_message = output_message_futures_.at(i).get();
         auto message = communication::GetMessage(output_message.data());
         auto output_message_pointer = communication::GetOutputMessage(message->payload()->data());
         assert(output_message_pointer);
-        assert(output_message_pointer->wires()->size() == 1);
+        assert(output_message_pointer->wires()->size() == number_of_wires);
 
-        shared_outputs.push_back(
-            FromByteVector<T>(*output_message_pointer->wires()->Get(0)->payload()));
-        assert(shared_outputs[i].size() == parent_[0]->GetNumberOfSimdValues());
+        for (std::size_t j = 0; j < number_of_wires; ++j) {
+          shared_outputs.at(j).push_back(
+              FromByteVector<T>(*output_message_pointer->wires()->Get(j)->payload()));
+          assert(shared_outputs.at(j).back().size() == parent_.at(j)->GetNumberOfSimdValues());
+        }
       }
 
-      // reconstruct the shared value
-      if constexpr (kVerboseDebug) {
-        // we need to copy since we have to keep shared_outputs for the debug output below
-        output = AddVectors(shared_outputs);
-      } else {
-        // we can move
-        output = AddVectors(std::move(shared_outputs));
-      }
+      for (std::size_t j = 0; j < number_of_wires; ++j) {
+        // reconstruct the shared value
+        if constexpr (kVerboseDebug) {
+          // we need to copy since we have to keep shared_outputs for the debug output below
+          output.at(j) = AddVectors(shared_outputs.at(j));
+        } else {
+          // we can move
+          output.at(j) = AddVectors(std::move(shared_outputs.at(j)));
+        }
 
-      // set the value of the output wire
-      auto arithmetic_output_wire =
-          std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-      assert(arithmetic_output_wire);
-      arithmetic_output_wire->GetMutableValues() = output;
+        // set the value of the output wire
+        auto arithmetic_output_wire =
+            std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(j));
+        assert(arithmetic_output_wire);
+        arithmetic_output_wire->GetMutableValues() = output.at(j);
 
-      if constexpr (kVerboseDebug) {
-        std::string shares{""};
-        for (auto i = 0u; i < number_of_parties; ++i) {
-          shares.append(fmt::format("id#{}:{} ", i, to_string(shared_outputs.at(i))));
+        if constexpr (kVerboseDebug) {
+          std::string shares{""};
+          for (auto i = 0u; i < number_of_parties; ++i) {
+            shares.append(fmt::format("id#{}:{} ", i, to_string(shared_outputs.at(j).at(i))));
+          }
+          auto result = to_string(output.at(j));
+          GetLogger().LogTrace(
+              fmt::format("Received output shares: {} from other parties, "
+                          "reconstructed result is {}",
+                          shares, result));
         }
-        auto result = to_string(output);
-        GetLogger().LogTrace(
-            fmt::format("Received output shares: {} from other parties, "
-                        "reconstructed result is {}",
-                        shares, result));
       }
     }
 
@@ -368,7 +401,7 @@ class OutputGate final : public motion::OutputGate {
   // indicates whether this party obtains the output
   bool is_my_output_ = false;
 
-  std::vector<motion::ReusableFiberFuture<std::vector<std::uint8_t>>> output_message_futures_;
+  std::vector<motion::ReusableFiberFuture<communication::MessageView>> output_message_futures_;
 
   std::mutex m;
 };
@@ -396,7 +429,7 @@ class AdditionGate final : public motion::TwoGate {
 
     {
       auto w = std::static_pointer_cast<motion::Wire>(
-          std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
       GetRegister().RegisterNextWire(w);
       output_wires_ = {std::move(w)};
     }
@@ -445,7 +478,7 @@ class AdditionGate final : public motion::TwoGate {
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     assert(arithmetic_wire);
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
@@ -477,7 +510,7 @@ class SubtractionGate final : public motion::TwoGate {
 
     {
       auto w = std::static_pointer_cast<motion::Wire>(
-          std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
       GetRegister().RegisterNextWire(w);
       output_wires_ = {std::move(w)};
     }
@@ -525,7 +558,7 @@ class SubtractionGate final : public motion::TwoGate {
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     assert(arithmetic_wire);
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
@@ -548,16 +581,17 @@ class MultiplicationGate final : public motion::TwoGate {
     requires_online_interaction_ = true;
     gate_type_ = GateType::kInteractive;
 
-    d_ = std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
+    d_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
     GetRegister().RegisterNextWire(d_);
-    e_ = std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
+    e_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
     GetRegister().RegisterNextWire(e_);
 
-    d_output_ = std::make_shared<OutputGate<T>>(d_);
-    e_output_ = std::make_shared<OutputGate<T>>(e_);
+    // d and e are opened together in a single message per peer
+    de_output_ = GetRegister().MakeShared<OutputGate<T>>(
+        std::vector<arithmetic_gmw::WirePointer<T>>{d_, e_});
 
-    GetRegister().RegisterNextGate(d_output_);
-    GetRegister().RegisterNextGate(e_output_);
+    GetRegister().RegisterNextGate(de_output_);
+    ConsumeOutputWiresOf(*de_output_);
 
     gate_id_ = GetRegister().NextGateId();
 
@@ -569,7 +603,7 @@ class MultiplicationGate final : public motion::TwoGate {
 
     {
       auto w = std::static_pointer_cast<motion::Wire>(
-          std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
       GetRegister().RegisterNextWire(w);
       output_wires_ = {std::move(w)};
     }
@@ -601,8 +635,7 @@ class MultiplicationGate final : public motion::TwoGate {
     mt_provider.WaitFinished();
     const auto& mts = mt_provider.template GetIntegerAll<T>();
     {
-      const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
-      assert(x);
+      const auto x = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
       d_->GetMutableValues() = std::vector<T>(
           mts.a.begin() + mt_offset_, mts.a.begin() + mt_offset_ + x->GetNumberOfSimdValues());
       T* __restrict__ d_v = d_->GetMutableValues().data();
@@ -613,8 +646,7 @@ class MultiplicationGate final : public motion::TwoGate {
                      [](const T& a, const T& b) { return a + b; });
       d_->SetOnlineFinished();
 
-      const auto y = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
-      assert(y);
+      const auto y = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
       e_->GetMutableValues() = std::vector<T>(
           mts.b.begin() + mt_offset_, mts.b.begin() + mt_offset_ + x->GetNumberOfSimdValues());
       T* __restrict__ e_v = e_->GetMutableValues().data();
@@ -624,27 +656,20 @@ class MultiplicationGate final : public motion::TwoGate {
       e_->SetOnlineFinished();
     }
 
-    d_output_->WaitOnline();
-    e_output_->WaitOnline();
+    de_output_->WaitOnline();
 
-    const auto& d_clear = d_output_->GetOutputWires().at(0);
-    const auto& e_clear = e_output_->GetOutputWires().at(0);
+    const auto& d_clear = de_output_->GetOutputWires().at(0);
+    const auto& e_clear = de_output_->GetOutputWires().at(1);
 
     d_clear->GetIsReadyCondition().Wait();
     e_clear->GetIsReadyCondition().Wait();
 
-    const auto d_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
-    const auto x_i_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
-    const auto e_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(e_clear);
-    const auto y_i_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
+    const auto d_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
+    const auto x_i_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
+    const auto e_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(e_clear);
+    const auto y_i_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
 
-    assert(d_w);
-    assert(x_i_w);
-    assert(e_w);
-    assert(y_i_w);
-
-    auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    assert(output);
+    auto output = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     output->GetMutableValues() =
         std::vector<T>(mts.c.begin() + mt_offset_,
                        mts.c.begin() + mt_offset_ + parent_a_.at(0)->GetNumberOfSimdValues());
@@ -675,9 +700,8 @@ class MultiplicationGate final : public motion::TwoGate {
   // perhaps, we should return a copy of the pointer and not move it for the
   // case we need it multiple times
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
-    auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    assert(arithmetic_wire);
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto arithmetic_wire = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
@@ -687,11 +711,164 @@ class MultiplicationGate final : public motion::TwoGate {
 
  private:
   arithmetic_gmw::WirePointer<T> d_, e_;
-  std::shared_ptr<OutputGate<T>> d_output_, e_output_;
+  std::shared_ptr<OutputGate<T>> de_output_;
 
   std::size_t number_of_mts_, mt_offset_;
 };
 
+/// \brief Multiplies a \p rows x \p inner matrix by an \p inner x \p columns matrix, where the
+///        matrices are stored in row-major order in the SIMD values of the parent wires.
+///
+/// Uses a matrix Beaver triple, so only the masked inputs D = X + A and E = Y + B are opened,
+/// i.e., (rows + columns) * inner values instead of rows * inner * columns for a
+/// MultiplicationGate over replicated inputs.
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+class MatrixMultiplicationGate final : public motion::TwoGate {
+ public:
+  MatrixMultiplicationGate(const arithmetic_gmw::WirePointer<T>& a,
+                           const arithmetic_gmw::WirePointer<T>& b, std::size_t rows,
+                           std::size_t inner, std::size_t columns)
+      : TwoGate(a->GetBackend()), rows_(rows), inner_(inner), columns_(columns) {
+    parent_a_ = {std::static_pointer_cast<motion::Wire>(a)};
+    parent_b_ = {std::static_pointer_cast<motion::Wire>(b)};
+
+    if (a->GetNumberOfSimdValues() != rows * inner ||
+        b->GetNumberOfSimdValues() != inner * columns) {
+      throw std::invalid_argument(fmt::format(
+          "Cannot multiply a matrix with {} values by a matrix with {} values as {}x{} by {}x{}",
+          a->GetNumberOfSimdValues(), b->GetNumberOfSimdValues(), rows, inner, inner, columns));
+    }
+
+    requires_online_interaction_ = true;
+    gate_type_ = GateType::kInteractive;
+
+    d_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, rows_ * inner_);
+    GetRegister().RegisterNextWire(d_);
+    e_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, inner_ * columns_);
+    GetRegister().RegisterNextWire(e_);
+
+    // D and E are opened together in a single message per peer
+    de_output_ = GetRegister().MakeShared<OutputGate<T>>(
+        std::vector<arithmetic_gmw::WirePointer<T>>{d_, e_});
+
+    GetRegister().RegisterNextGate(de_output_);
+    ConsumeOutputWiresOf(*de_output_);
+
+    gate_id_ = GetRegister().NextGateId();
+
+    RegisterWaitingFor(parent_a_.at(0)->GetWireId());
+    parent_a_.at(0)->RegisterWaitingGate(gate_id_);
+
+    RegisterWaitingFor(parent_b_.at(0)->GetWireId());
+    parent_b_.at(0)->RegisterWaitingGate(gate_id_);
+
+    {
+      auto w = std::static_pointer_cast<motion::Wire>(
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, rows_ * columns_));
+      GetRegister().RegisterNextWire(w);
+      output_wires_ = {std::move(w)};
+    }
+
+    mt_id_ = GetMtProvider().template RequestArithmeticMatrixMt<T>(rows_, inner_, columns_);
+
+    auto gate_info = fmt::format("uint{}_t type, gate id {}, parents: {}, {}, dimensions {}x{}x{}",
+                                 sizeof(T) * 8, gate_id_, parent_a_.at(0)->GetWireId(),
+                                 parent_b_.at(0)->GetWireId(), rows_, inner_, columns_);
+    GetLogger().LogDebug(fmt::format(
+        "Created an arithmetic_gmw::MatrixMultiplicationGate with following properties: {}",
+        gate_info));
+  }
+
+  ~MatrixMultiplicationGate() final = default;
+
+  void EvaluateSetup() final override {
+    SetSetupIsReady();
+    GetRegister().IncrementEvaluatedGatesSetupCounter();
+  }
+
+  void EvaluateOnline() final override {
+    WaitSetup();
+    assert(setup_is_ready_);
+    parent_a_.at(0)->GetIsReadyCondition().Wait();
+    parent_b_.at(0)->GetIsReadyCondition().Wait();
+
+    const auto& mt = GetMtProvider().template GetArithmeticMatrixMt<T>(mt_id_);
+    const auto x_i_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_a_.at(0));
+    const auto y_i_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_b_.at(0));
+    {
+      d_->GetMutableValues() = mt.a;
+      T* __restrict__ d_v = d_->GetMutableValues().data();
+      const T* __restrict__ x_v = x_i_w->GetValues().data();
+      std::transform(x_v, x_v + rows_ * inner_, d_v, d_v,
+                     [](const T& a, const T& b) { return a + b; });
+      d_->SetOnlineFinished();
+
+      e_->GetMutableValues() = mt.b;
+      T* __restrict__ e_v = e_->GetMutableValues().data();
+      const T* __restrict__ y_v = y_i_w->GetValues().data();
+      std::transform(y_v, y_v + inner_ * columns_, e_v, e_v,
+                     [](const T& a, const T& b) { return a + b; });
+      e_->SetOnlineFinished();
+    }
+
+    de_output_->WaitOnline();
+
+    const auto& d_clear = de_output_->GetOutputWires().at(0);
+    const auto& e_clear = de_output_->GetOutputWires().at(1);
+
+    d_clear->GetIsReadyCondition().Wait();
+    e_clear->GetIsReadyCondition().Wait();
+
+    const auto d_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
+    const auto e_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(e_clear);
+
+    auto output = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    output->GetMutableValues() = mt.c;
+
+    // Z_i = C_i + D * Y_i + X_i * E, and one party additionally subtracts D * E, which it merges
+    // into the first product as D * (Y_i - E)
+    const auto& e = e_w->GetValues();
+    if (GetCommunicationLayer().GetMyId() ==
+        (gate_id_ % GetCommunicationLayer().GetNumberOfParties())) {
+      std::vector<T> y_minus_e(y_i_w->GetValues());
+      std::transform(y_minus_e.cbegin(), y_minus_e.cend(), e.cbegin(), y_minus_e.begin(),
+                     [](const T& a, const T& b) { return a - b; });
+      MatrixMultiplyAccumulate(rows_, inner_, columns_, d_w->GetValues().data(), y_minus_e.data(),
+                               output->GetMutableValues().data());
+    } else {
+      MatrixMultiplyAccumulate(rows_, inner_, columns_, d_w->GetValues().data(),
+                               y_i_w->GetValues().data(), output->GetMutableValues().data());
+    }
+    MatrixMultiplyAccumulate(rows_, inner_, columns_, x_i_w->GetValues().data(), e.data(),
+                             output->GetMutableValues().data());
+
+    GetLogger().LogDebug(
+        fmt::format("Evaluated arithmetic_gmw::MatrixMultiplicationGate with id#{}", gate_id_));
+    SetOnlineIsReady();
+    GetRegister().IncrementEvaluatedGatesOnlineCounter();
+  }
+
+  // perhaps, we should return a copy of the pointer and not move it for the
+  // case we need it multiple times
+  arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
+    auto arithmetic_wire = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    return result;
+  }
+
+  MatrixMultiplicationGate() = delete;
+
+  MatrixMultiplicationGate(Gate&) = delete;
+
+ private:
+  const std::size_t rows_, inner_, columns_;
+
+  arithmetic_gmw::WirePointer<T> d_, e_;
+  std::shared_ptr<OutputGate<T>> de_output_;
+
+  std::size_t mt_id_;
+};
+
 template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
 class SquareGate final : public motion::OneGate {
  public:
@@ -701,12 +878,13 @@ class SquareGate final : public motion::OneGate {
     requires_online_interaction_ = true;
     gate_type_ = GateType::kInteractive;
 
-    d_ = std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
+    d_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
     GetRegister().RegisterNextWire(d_);
 
-    d_output_ = std::make_shared<OutputGate<T>>(d_);
+    d_output_ = GetRegister().MakeShared<OutputGate<T>>(d_);
 
     GetRegister().RegisterNextGate(d_output_);
+    ConsumeOutputWiresOf(*d_output_);
 
     gate_id_ = GetRegister().NextGateId();
 
@@ -715,7 +893,7 @@ class SquareGate final : public motion::OneGate {
 
     {
       auto w = std::static_pointer_cast<motion::Wire>(
-          std::make_shared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
       GetRegister().RegisterNextWire(w);
       output_wires_ = {std::move(w)};
     }
@@ -745,8 +923,7 @@ class SquareGate final : public motion::OneGate {
     sp_provider.WaitFinished();
     const auto& sps = sp_provider.template GetSpsAll<T>();
     {
-      const auto x = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
-      assert(x);
+      const auto x = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
       d_->GetMutableValues() = std::vector<T>(
           sps.a.begin() + sp_offset_, sps.a.begin() + sp_offset_ + x->GetNumberOfSimdValues());
       const auto number_of_simd_values{d_->GetNumberOfSimdValues()};
@@ -763,14 +940,10 @@ class SquareGate final : public motion::OneGate {
 
     d_clear->GetIsReadyCondition().Wait();
 
-    const auto d_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
-    const auto x_i_w = std::dynamic_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
-
-    assert(d_w);
-    assert(x_i_w);
+    const auto d_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(d_clear);
+    const auto x_i_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
 
-    auto output = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    assert(output);
+    auto output = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     output->GetMutableValues() =
         std::vector<T>(sps.c.begin() + sp_offset_,
                        sps.c.begin() + sp_offset_ + parent_.at(0)->GetNumberOfSimdValues());
@@ -799,7 +972,7 @@ class SquareGate final : public motion::OneGate {
   arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     assert(arithmetic_wire);
-    auto result = std::make_shared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
     return result;
   }
 
@@ -814,4 +987,145 @@ class SquareGate final : public motion::OneGate {
   std::size_t number_of_sps_, sp_offset_;
 };
 
+/// \brief Probabilistic truncation of a shared value x by fractional_bits bits using a truncation
+/// pair (r, (r mod 2^(l-1)) >> f, r_(l-1)).
+///
+/// The parties open c = x + 2^(l-2) + r, which hides x since r is uniform.  For x interpreted as
+/// signed number in [-2^(l-2), 2^(l-2)), the carry into the most significant bit of c is the XOR
+/// of the msbs of c and r, which is linear in the shared msb of r, so the only error is the
+/// borrow of the lower f bits: the result is either x >> f or (x >> f) + 1 (arithmetic shifts).
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+class TruncationGate final : public motion::OneGate {
+ public:
+  TruncationGate(const arithmetic_gmw::WirePointer<T>& a, const std::size_t fractional_bits)
+      : OneGate(a->GetBackend()), fractional_bits_(fractional_bits) {
+    assert(fractional_bits_ <= kBitLength - 2);
+    parent_ = {std::static_pointer_cast<motion::Wire>(a)};
+
+    requires_online_interaction_ = true;
+    gate_type_ = GateType::kInteractive;
+
+    c_ = GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues());
+    GetRegister().RegisterNextWire(c_);
+
+    c_output_ = GetRegister().MakeShared<OutputGate<T>>(c_);
+
+    GetRegister().RegisterNextGate(c_output_);
+    ConsumeOutputWiresOf(*c_output_);
+
+    gate_id_ = GetRegister().NextGateId();
+
+    RegisterWaitingFor(parent_.at(0)->GetWireId());
+    parent_.at(0)->RegisterWaitingGate(gate_id_);
+
+    {
+      auto w = std::static_pointer_cast<motion::Wire>(
+          GetRegister().MakeShared<arithmetic_gmw::Wire<T>>(backend_, a->GetNumberOfSimdValues()));
+      GetRegister().RegisterNextWire(w);
+      output_wires_ = {std::move(w)};
+    }
+
+    truncation_pair_offset_ =
+        GetSbProvider().template RequestTruncationPairs<T>(parent_.at(0)->GetNumberOfSimdValues());
+
+    auto gate_info = fmt::format("uint{}_t type, gate id {}, parent: {}, fractional bits: {}",
+                                 sizeof(T) * 8, gate_id_, parent_.at(0)->GetWireId(),
+                                 fractional_bits_);
+    GetLogger().LogDebug(fmt::format(
+        "Created an arithmetic_gmw::TruncationGate with following properties: {}", gate_info));
+  }
+
+  ~TruncationGate() final = default;
+
+  void EvaluateSetup() final override {
+    SetSetupIsReady();
+    GetRegister().IncrementEvaluatedGatesSetupCounter();
+  }
+
+  void EvaluateOnline() final override {
+    WaitSetup();
+    assert(setup_is_ready_);
+    parent_.at(0)->GetIsReadyCondition().Wait();
+
+    auto& sb_provider = GetSbProvider();
+    sb_provider.WaitFinished();
+    const auto number_of_simd_values{parent_.at(0)->GetNumberOfSimdValues()};
+    const auto pairs{sb_provider.template GetTruncationPairs<T>(
+        truncation_pair_offset_, number_of_simd_values, fractional_bits_)};
+    const bool is_party_0{GetCommunicationLayer().GetMyId() == 0};
+    {
+      const auto x = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(parent_.at(0));
+      assert(x);
+      // only one party adds the offset 2^(l-2), which makes x non-negative
+      const T offset{is_party_0 ? T(T(1) << (kBitLength - 2)) : T(0)};
+      auto& c_values{c_->GetMutableValues()};
+      c_values.resize(number_of_simd_values);
+      const T* __restrict__ x_v{x->GetValues().data()};
+      const T* __restrict__ r_v{pairs.values.data()};
+      T* __restrict__ c_v{c_values.data()};
+      for (auto i = 0ull; i < number_of_simd_values; ++i) {
+        c_v[i] = x_v[i] + offset + r_v[i];
+      }
+      c_->SetOnlineFinished();
+    }
+
+    c_output_->WaitOnline();
+
+    const auto& c_clear = c_output_->GetOutputWires().at(0);
+    c_clear->GetIsReadyCondition().Wait();
+    const auto c_w = std::static_pointer_cast<const arithmetic_gmw::Wire<T>>(c_clear);
+    assert(c_w);
+
+    auto output = std::static_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    assert(output);
+    output->GetMutableValues().resize(number_of_simd_values);
+
+    // x + 2^(l-2) = (c mod 2^(l-1)) - (r mod 2^(l-1)) + 2^(l-1) * (c_(l-1) ^ r_(l-1))
+    const std::size_t msb_shift{kBitLength - 1 - fractional_bits_};
+    constexpr T kLowerBitsMask{T(T(1) << (kBitLength - 1)) - 1};
+    const T* __restrict__ c{c_w->GetValues().data()};
+    const T* __restrict__ r_truncated{pairs.truncated_values.data()};
+    const T* __restrict__ r_msb{pairs.most_significant_bits.data()};
+    T* __restrict__ output_pointer{output->GetMutableValues().data()};
+    for (auto i = 0ull; i < number_of_simd_values; ++i) {
+      const T c_msb = c[i] >> (kBitLength - 1);
+      output_pointer[i] = T(T(T(1 - 2 * c_msb) * r_msb[i]) << msb_shift) - r_truncated[i];
+    }
+    if (is_party_0) {
+      const T offset_truncated{T(T(1) << (kBitLength - 2 - fractional_bits_))};
+      for (auto i = 0ull; i < number_of_simd_values; ++i) {
+        const T c_msb = c[i] >> (kBitLength - 1);
+        output_pointer[i] += T((c[i] & kLowerBitsMask) >> fractional_bits_) +
+                             T(c_msb << msb_shift) - offset_truncated;
+      }
+    }
+
+    GetLogger().LogDebug(
+        fmt::format("Evaluated arithmetic_gmw::TruncationGate with id#{}", gate_id_));
+    SetOnlineIsReady();
+    GetRegister().IncrementEvaluatedGatesOnlineCounter();
+  }
+
+  arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
+    auto arithmetic_wire = std::dynamic_pointer_cast<arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    assert(arithmetic_wire);
+    auto result = GetRegister().MakeShared<arithmetic_gmw::Share<T>>(arithmetic_wire);
+    return result;
+  }
+
+  TruncationGate() = delete;
+
+  TruncationGate(Gate&) = delete;
+
+ private:
+  static constexpr std::size_t kBitLength{sizeof(T) * 8};
+
+  const std::size_t fractional_bits_;
+
+  arithmetic_gmw::WirePointer<T> c_;
+  std::shared_ptr<OutputGate<T>> c_output_;
+
+  std::size_t truncation_pair_offset_;
+};
+
 }  // namespace encrypto::motion::proto::arithmetic_gmw
@@ -60,6 +60,9 @@ class Wire final : public motion::Wire {
 
   bool IsConstant() const noexcept final { return false; }
 
+ protected:
+  void DynamicReleaseValues() final { std::vector<T>().swap(values_); }
+
  private:
   std::vector<T> values_;
 };
@@ -28,6 +28,7 @@
 #include "bmr_wire.h"
 
 #include "base/backend.h"
+#include "base/configuration.h"
 #include "base/motion_base_provider.h"
 #include "communication/bmr_message.h"
 #include "communication/communication_layer.h"
@@ -85,7 +86,7 @@ void InputGate::InitializationHelper() {
 
   output_wires_.reserve(bit_size_);
   for (std::size_t i = 0; i < bit_size_; ++i)
-    output_wires_.emplace_back(std::make_shared<bmr::Wire>(backend_, number_of_simd_));
+    output_wires_.emplace_back(GetRegister().MakeShared<bmr::Wire>(backend_, number_of_simd_));
 
   for (auto& w : output_wires_) GetRegister().RegisterNextWire(w);
 
@@ -311,7 +312,7 @@ void InputGate::EvaluateOnline() {
 }
 
 const bmr::SharePointer InputGate::GetOutputAsBmrShare() const {
-  auto result = std::make_shared<bmr::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<bmr::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -363,13 +364,15 @@ OutputGate::OutputGate(const motion::SharePointer& parent, std::size_t output_ow
   assert(!dummy_bitvector.Empty());
 
   for (auto& w : gmw_wires) {
-    w = std::make_shared<boolean_gmw::Wire>(dummy_bitvector, backend_);
+    w = GetRegister().MakeShared<boolean_gmw::Wire>(dummy_bitvector, backend_);
     GetRegister().RegisterNextWire(w);
   }
 
-  gmw_output_share_ = std::make_shared<boolean_gmw::Share>(gmw_wires);
-  output_gate_ = std::make_shared<boolean_gmw::OutputGate>(gmw_output_share_, output_owner_);
+  gmw_output_share_ = GetRegister().MakeShared<boolean_gmw::Share>(gmw_wires);
+  output_gate_ =
+      GetRegister().MakeShared<boolean_gmw::OutputGate>(gmw_output_share_, output_owner_);
   GetRegister().RegisterNextGate(output_gate_);
+  ConsumeOutputWiresOf(*output_gate_);
 
   gate_id_ = GetRegister().NextGateId();
 
@@ -385,7 +388,7 @@ OutputGate::OutputGate(const motion::SharePointer& parent, std::size_t output_ow
   assert(!output_.empty());
   for (auto& wire : output_wires_) {
     wire = std::static_pointer_cast<motion::Wire>(
-        std::make_shared<bmr::Wire>(backend_, number_of_simd));
+        GetRegister().MakeShared<bmr::Wire>(backend_, number_of_simd));
   }
 
   for (auto& wire : output_wires_) GetRegister().RegisterNextWire(wire);
@@ -457,7 +460,7 @@ void OutputGate::EvaluateOnline() {
 }
 
 const bmr::SharePointer OutputGate::GetOutputAsBmrShare() const {
-  auto result = std::make_shared<bmr::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<bmr::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -497,7 +500,7 @@ XorGate::XorGate(const motion::SharePointer& a, const motion::SharePointer& b)
   output_wires_.resize(parent_a_.size());
   const motion::BitVector tmp_bv(a->GetNumberOfSimdValues());
   for (auto& w : output_wires_) {
-    w = std::make_shared<bmr::Wire>(tmp_bv, backend_);
+    w = GetRegister().MakeShared<bmr::Wire>(tmp_bv, backend_);
     GetRegister().RegisterNextWire(w);
   }
 
@@ -581,7 +584,7 @@ void XorGate::EvaluateOnline() {
 }
 
 const bmr::SharePointer XorGate::GetOutputAsBmrShare() const {
-  auto result = std::make_shared<bmr::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<bmr::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -613,7 +616,7 @@ InvGate::InvGate(const motion::SharePointer& parent) : OneGate(parent->GetBacken
   output_wires_.resize(parent_.size());
   const motion::BitVector tmp_bv(parent->GetNumberOfSimdValues());
   for (auto& w : output_wires_) {
-    w = std::make_shared<bmr::Wire>(tmp_bv, backend_);
+    w = GetRegister().MakeShared<bmr::Wire>(tmp_bv, backend_);
     GetRegister().RegisterNextWire(w);
   }
 
@@ -703,7 +706,7 @@ void InvGate::EvaluateOnline() {
 }
 
 const bmr::SharePointer InvGate::GetOutputAsBmrShare() const {
-  auto result = std::make_shared<bmr::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<bmr::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -735,7 +738,9 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   const auto number_of_parties = communication_layer.GetNumberOfParties();
   const auto number_of_simd{parent_a_.at(0)->GetNumberOfSimdValues()};
   const auto number_of_wires{parent_a_.size()};
-  const auto size_of_all_garbled_tables = number_of_wires * number_of_simd * 4 * number_of_parties;
+  row_reduction_ = GetConfiguration().GetBmrRowReduction();
+  const auto size_of_all_garbled_tables =
+      number_of_wires * number_of_simd * GetNumberOfGarbledRows() * number_of_parties;
 
   for (auto& wire : parent_a_) {
     RegisterWaitingFor(wire->GetWireId());
@@ -750,7 +755,7 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   output_wires_.resize(number_of_wires);
   const motion::BitVector tmp_bv(number_of_simd);
   for (auto& w : output_wires_) {
-    w = std::make_shared<bmr::Wire>(tmp_bv, backend_);
+    w = GetRegister().MakeShared<bmr::Wire>(tmp_bv, backend_);
     GetRegister().RegisterNextWire(w);
   }
 
@@ -781,10 +786,17 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   // allocate enough space for number_of_wires * number_of_simd garbled tables
   garbled_tables_.resize(size_of_all_garbled_tables);
   garbled_tables_.SetToZero();
+  if (row_reduction_) {
+    key_shares_.resize(number_of_wires * number_of_simd * number_of_parties);
+    key_shares_.SetToZero();
+  }
 
-  // store futures for the (partial) garbled tables we will receive during garbling
+  // store futures for the (partial) garbled tables we will receive during garbling, which are
+  // followed by the sender's shares of our output keys with row reduction
+  const auto size_of_garbled_rows_message =
+      size_of_all_garbled_tables + (row_reduction_ ? number_of_wires * number_of_simd : 0);
   received_garbled_rows_ =
-      backend_.GetBmrProvider().RegisterForGarbledRows(gate_id_, size_of_all_garbled_tables);
+      backend_.GetBmrProvider().RegisterForGarbledRows(gate_id_, size_of_garbled_rows_message);
 
   if constexpr (kDebug) {
     auto gate_info = fmt::format("gate id {}, parents: {}, {}", gate_id_,
@@ -802,6 +814,8 @@ void AndGate::GenerateRandomness() {
     auto bmr_output{std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i))};
     assert(bmr_output);
     bmr_output->GenerateRandomPermutationBits();
+    // with row reduction, the keys are derived from the garbled tables at the end of the setup
+    if (row_reduction_) continue;
     bmr_output->GenerateRandomPrivateKeys();
     if constexpr (kVerboseDebug) {
       const auto my_id = GetCommunicationLayer().GetMyId();
@@ -841,11 +855,19 @@ void AndGate::EvaluateSetup() {
   const auto number_of_parties = communication_layer.GetNumberOfParties();
   [[maybe_unused]] const auto batch_size_3{number_of_simd * 3};
 
+  // index function for the buffer of output key shares
+  const auto GetKeyShareIndex = [number_of_simd, number_of_parties](auto wire_i, auto simd_i,
+                                                                    auto party_i) {
+    return (wire_i * number_of_simd + simd_i) * number_of_parties + party_i;
+  };
+
+  const auto number_of_rows{GetNumberOfGarbledRows()};
+
   // index function for the buffer of garbled tables
-  const auto GetGarbledTableIndex = [number_of_simd, number_of_parties](auto wire_i, auto simd_i,
-                                                                        auto row_i, auto party_i) {
-    return wire_i * number_of_simd * 4 * number_of_parties + simd_i * (4 * number_of_parties) +
-           row_i * number_of_parties + party_i;
+  const auto GetGarbledTableIndex = [number_of_simd, number_of_parties, number_of_rows](
+                                        auto wire_i, auto simd_i, auto row_i, auto party_i) {
+    return wire_i * number_of_simd * number_of_rows * number_of_parties +
+           simd_i * (number_of_rows * number_of_parties) + row_i * number_of_parties + party_i;
   };
 
   if constexpr (kVerboseDebug) {
@@ -1005,20 +1027,32 @@ void AndGate::EvaluateSetup() {
       // TODO: fix gate id computation
       const auto gate_id = static_cast<uint64_t>(bmr_output->GetWireId() + simd_i);
 
-      AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_0.data(), gate_id, number_of_parties,
-                  &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, 0)]);
-      AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_1.data(), gate_id, number_of_parties,
-                  &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, 0)]);
-      AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_0.data(), gate_id, number_of_parties,
-                  &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, 0)]);
-      AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_1.data(), gate_id, number_of_parties,
-                  &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, 0)]);
-
-      const auto& key_w_0 = bmr_output->GetSecretKeys()[simd_i];
-      garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, my_id)] ^= key_w_0;
-      garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, my_id)] ^= key_w_0;
-      garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, my_id)] ^= key_w_0;
-      garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, my_id)] ^= key_w_0 ^ R;
+      if (row_reduction_) {
+        // row_00 goes into the key shares, the remaining rows are shifted by one
+        AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_0.data(), gate_id, number_of_parties,
+                    &key_shares_[GetKeyShareIndex(wire_i, simd_i, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_1.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_0.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_1.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, 0)]);
+      } else {
+        AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_0.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_0.data(), key_b_1.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_0.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, 0)]);
+        AesniBmrDkc(aes_round_keys, key_a_1.data(), key_b_1.data(), gate_id, number_of_parties,
+                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, 0)]);
+
+        const auto& key_w_0 = bmr_output->GetSecretKeys()[simd_i];
+        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, my_id)] ^= key_w_0;
+        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, my_id)] ^= key_w_0;
+        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, my_id)] ^= key_w_0;
+        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, my_id)] ^= key_w_0 ^ R;
+      }
 
       for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
         std::array<motion::Block128, 3> shared_R;
@@ -1077,23 +1111,45 @@ void AndGate::EvaluateSetup() {
                           shared_R.at(1).AsString(), shared_R.at(2).AsString()));
         }
 
-        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, party_i)] ^= shared_R[0];
-        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, party_i)] ^= shared_R[1];
-        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, party_i)] ^= shared_R[2];
-        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, party_i)] ^=
-            shared_R[0] ^ shared_R[1] ^ shared_R[2];
+        if (row_reduction_) {
+          key_shares_[GetKeyShareIndex(wire_i, simd_i, party_i)] ^= shared_R[0];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, party_i)] ^= shared_R[1];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, party_i)] ^= shared_R[2];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, party_i)] ^=
+              shared_R[0] ^ shared_R[1] ^ shared_R[2];
+        } else {
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 0, party_i)] ^= shared_R[0];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 1, party_i)] ^= shared_R[1];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, party_i)] ^= shared_R[2];
+          garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 3, party_i)] ^=
+              shared_R[0] ^ shared_R[1] ^ shared_R[2];
+        }
       }  // for each party
-    }    // for each simd
+
+      if (row_reduction_) {
+        // The 0-key of party i is defined as the XOR of all parties' shares of row_00 for party i,
+        // so the reconstructed row_00 is zero.  XORing our key shares instead of our own key onto
+        // the remaining rows puts the complete 0-keys into the reconstructed rows.
+        for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
+          const auto& key_share = key_shares_[GetKeyShareIndex(wire_i, simd_i, party_i)];
+          for (auto row_i = 0ull; row_i < number_of_rows; ++row_i) {
+            garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, row_i, party_i)] ^= key_share;
+          }
+        }
+        garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, 2, my_id)] ^= R;
+      }
+    }  // for each simd
   }      // for each wire
 
   if constexpr (kVerboseDebug) {
     std::string s{fmt::format("Me#{}: ", my_id)};
-    assert(garbled_tables_.size() == number_of_wires * number_of_simd * 4 * number_of_parties);
+    assert(garbled_tables_.size() ==
+           number_of_wires * number_of_simd * number_of_rows * number_of_parties);
     for (auto wire_j = 0ull; wire_j < number_of_wires; ++wire_j) {
       s.append(fmt::format(" Wire #{}: ", wire_j));
       for (auto simd_k = 0ull; simd_k < number_of_simd; ++simd_k) {
         s.append(fmt::format("\nSIMD #{}: ", simd_k));
-        for (auto row_l = 0ull; row_l < 4; ++row_l) {
+        for (auto row_l = 0ull; row_l < number_of_rows; ++row_l) {
           s.append(fmt::format("\nRow #{}: ", row_l));
           for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
             s.append(fmt::format("\nParty #{}: ", party_i));
@@ -1110,18 +1166,65 @@ void AndGate::EvaluateSetup() {
   }
 
   // send out our partial garbled tables
-  const std::vector<std::uint8_t> send_message_buffer(
-      reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()),
-      reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()) + garbled_tables_.ByteSize());
-  communication_layer.BroadcastMessage(
-      communication::BuildBmrAndMessage(static_cast<std::size_t>(gate_id_), send_message_buffer));
+  if (row_reduction_) {
+    // each party additionally gets our shares of its output keys
+    const auto number_of_key_shares{number_of_wires * number_of_simd};
+    const auto block_size{motion::Block128::size()};
+    for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
+      if (party_i == my_id) continue;
+      std::vector<std::uint8_t> send_message_buffer(garbled_tables_.ByteSize() +
+                                                    number_of_key_shares * block_size);
+      std::copy_n(reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()),
+                  garbled_tables_.ByteSize(), send_message_buffer.data());
+      auto key_shares_buffer = send_message_buffer.data() + garbled_tables_.ByteSize();
+      for (auto key_i = 0ull; key_i < number_of_key_shares; ++key_i) {
+        const auto& key_share = key_shares_[key_i * number_of_parties + party_i];
+        std::copy_n(reinterpret_cast<const std::uint8_t*>(key_share.data()), block_size,
+                    key_shares_buffer + key_i * block_size);
+      }
+      communication_layer.SendMessage(
+          party_i, communication::BuildBmrAndMessage(static_cast<std::size_t>(gate_id_),
+                                                     std::move(send_message_buffer)));
+    }
+  } else {
+    const std::vector<std::uint8_t> send_message_buffer(
+        reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()),
+        reinterpret_cast<const std::uint8_t*>(garbled_tables_.data()) +
+            garbled_tables_.ByteSize());
+    communication_layer.BroadcastMessage(
+        communication::BuildBmrAndMessage(static_cast<std::size_t>(gate_id_), send_message_buffer));
+  }
 
   // finalize garbled tables
   for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
     if (party_i == my_id) continue;
     const auto ReceivedMessage = received_garbled_rows_.at(party_i).get();
-    assert(ReceivedMessage.size() == garbled_tables_.size());
-    garbled_tables_ ^= ReceivedMessage;
+    if (row_reduction_) {
+      assert(ReceivedMessage.size() == garbled_tables_.size() + number_of_wires * number_of_simd);
+      for (auto block_i = 0ull; block_i < garbled_tables_.size(); ++block_i) {
+        garbled_tables_[block_i] ^= ReceivedMessage[block_i];
+      }
+      for (auto key_i = 0ull; key_i < number_of_wires * number_of_simd; ++key_i) {
+        key_shares_[key_i * number_of_parties + my_id] ^=
+            ReceivedMessage[garbled_tables_.size() + key_i];
+      }
+    } else {
+      assert(ReceivedMessage.size() == garbled_tables_.size());
+      garbled_tables_ ^= ReceivedMessage;
+    }
+  }
+
+  if (row_reduction_) {
+    // now that our output keys are complete, the children can be garbled
+    for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
+      auto bmr_output{std::dynamic_pointer_cast<bmr::Wire>(output_wires_.at(wire_i))};
+      assert(bmr_output);
+      for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
+        bmr_output->GetMutableSecretKeys()[simd_i] =
+            key_shares_[GetKeyShareIndex(wire_i, simd_i, my_id)];
+      }
+      bmr_output->SetSetupIsReady();
+    }
   }
 
   // mark this gate as setup-ready to proceed with the online phase
@@ -1153,17 +1256,19 @@ void AndGate::EvaluateOnline() {
     return simd_i * number_of_parties + party_i;
   };
 
+  const auto number_of_rows{GetNumberOfGarbledRows()};
+
   // index function for the buffer of garbled tables
-  const auto GetGarbledTableIndex = [number_of_simd, number_of_parties](auto wire_i, auto simd_i,
-                                                                        auto row_i, auto party_i) {
-    return wire_i * number_of_simd * 4 * number_of_parties + simd_i * (4 * number_of_parties) +
-           row_i * number_of_parties + party_i;
+  const auto GetGarbledTableIndex = [number_of_simd, number_of_parties, number_of_rows](
+                                        auto wire_i, auto simd_i, auto row_i, auto party_i) {
+    return wire_i * number_of_simd * number_of_rows * number_of_parties +
+           simd_i * (number_of_rows * number_of_parties) + row_i * number_of_parties + party_i;
   };
 
   if constexpr (kVerboseDebug) {
     for (auto wire_i = 0ull; wire_i < number_of_wires; ++wire_i) {
       for (auto simd_j = 0ull; simd_j < number_of_simd; ++simd_j) {
-        for (auto row_l = 0ull; row_l < 4; ++row_l) {
+        for (auto row_l = 0ull; row_l < number_of_rows; ++row_l) {
           for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
             GetLogger().LogTrace(
                 fmt::format("Party#{}: reconstructed gr for Party#{} Wire#{} SIMD#{} Row#{}: {}\n",
@@ -1193,30 +1298,35 @@ void AndGate::EvaluateOnline() {
     wire_b->GetIsReadyCondition().Wait();
 
     for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
-      // TODO: fix gate id computation
-      const auto gate_id = static_cast<uint64_t>(bmr_output->GetWireId() + simd_i);
-
       // compute index of the correct row in the garbled table
       const bool alpha = wire_a->GetPublicValues()[simd_i],
                  beta = wire_b->GetPublicValues()[simd_i];
       const std::size_t row_index =
           static_cast<std::size_t>(alpha) * 2 + static_cast<std::size_t>(beta);
 
-      // decrypt that row of the garbled table
-      for (auto party_i = 0ull; party_i < number_of_parties; ++party_i) {
-        const auto& key_a = wire_a->GetPublicKeys().at(PublicKeyIndex(simd_i, party_i));
-        const auto& key_b = wire_b->GetPublicKeys().at(PublicKeyIndex(simd_i, party_i));
-        AesniBmrDkc(aes_round_keys, key_a.data(), key_b.data(), gate_id, number_of_parties,
-                    &garbled_tables_[GetGarbledTableIndex(wire_i, simd_i, row_index, 0)]);
+      // copy that row of the garbled table to the outgoing wire, row_00 is zero and omitted with
+      // row reduction
+      auto output_keys = std::begin(bmr_output->GetMutablePublicKeys()) + PublicKeyIndex(simd_i, 0);
+      if (row_reduction_ && row_index == 0) {
+        std::fill_n(output_keys, number_of_parties, motion::Block128::MakeZero());
+      } else {
+        const auto table_row_index = row_reduction_ ? row_index - 1 : row_index;
+        std::copy_n(std::begin(garbled_tables_) +
+                        GetGarbledTableIndex(wire_i, simd_i, table_row_index, 0),
+                    number_of_parties, output_keys);
       }
+    }  // for each simd
 
-      // copy decrypted public keys to outgoing wire
-      std::copy(
-          std::begin(garbled_tables_) + GetGarbledTableIndex(wire_i, simd_i, row_index, 0),
-          std::begin(garbled_tables_) + GetGarbledTableIndex(wire_i, simd_i, row_index + 1, 0),
-          std::begin(bmr_output->GetMutablePublicKeys()) + PublicKeyIndex(simd_i, 0));
+    // decrypt the public keys in the outgoing wire for all SIMD values at once, the public keys
+    // of the parent wires are already laid out as simd X parties
+    // TODO: fix gate id computation
+    AesniBmrDkcBatch(aes_round_keys, wire_a->GetPublicKeys().data(),
+                     wire_b->GetPublicKeys().data(),
+                     static_cast<uint64_t>(bmr_output->GetWireId()), number_of_simd,
+                     number_of_parties, bmr_output->GetMutablePublicKeys().data());
 
-      if constexpr (kVerboseDebug) {
+    if constexpr (kVerboseDebug) {
+      for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
         std::string s;
         s.append(fmt::format("Me#{}: wire#{} simd#{} result\n", my_id, wire_i, simd_i));
         s.append(fmt::format("Public values a {} b {} ", wire_a->GetPublicValues().AsString(),
@@ -1227,7 +1337,7 @@ void AndGate::EvaluateOnline() {
                              (bmr_output->GetSecretKeys().at(simd_i) ^ R).AsString()));
         GetLogger().LogTrace(s);
       }
-    }  // for each simd
+    }
 
     // figure out the public value of the outputs
     for (auto simd_i = 0ull; simd_i < number_of_simd; ++simd_i) {
@@ -1266,7 +1376,7 @@ void AndGate::EvaluateOnline() {
 }
 
 const bmr::SharePointer AndGate::GetOutputAsBmrShare() const {
-  auto result = std::make_shared<bmr::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<bmr::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -176,10 +176,20 @@ class AndGate final : public TwoGate {
 
   std::vector<motion::ReusableFiberFuture<motion::Block128Vector>> received_garbled_rows_;
 
+  // if set, row_00 of each garbled table is zero and omitted (GRR3)
+  bool row_reduction_;
+
   // buffer to store all garbled tables for all wires
-  // structure: wires X (simd X (row_00 || row_01 || row_10 || row_11))
+  // structure: wires X (simd X (row_00 || row_01 || row_10 || row_11)), where each row consists
+  // of one block per party and row_00 is omitted with row reduction
   motion::Block128Vector garbled_tables_;
 
+  // row reduction only: our shares of the output wires' 0-keys of each party
+  // structure: wires X simd X parties
+  motion::Block128Vector key_shares_;
+
+  std::size_t GetNumberOfGarbledRows() const { return row_reduction_ ? 3 : 4; }
+
   void GenerateRandomness();
 };
 
@@ -10,15 +10,18 @@ namespace encrypto::motion::proto::bmr {
 class MessageHandler : public communication::MessageHandler {
  public:
   MessageHandler(Data& data) : data_(data) {}
-  void ReceivedMessage(std::size_t, std::vector<std::uint8_t>&& message) override;
+  void ReceivedMessage(std::size_t party_id, std::vector<std::uint8_t>&& message) override {
+    ReceivedMessageView(party_id, communication::MessageView(std::move(message)));
+  }
+  void ReceivedMessageView(std::size_t, communication::MessageView&& message) override;
 
  private:
   Data& data_;
 };
 
-void MessageHandler::ReceivedMessage(std::size_t, std::vector<std::uint8_t>&& raw_message) {
+void MessageHandler::ReceivedMessageView(std::size_t, communication::MessageView&& raw_message) {
   assert(!raw_message.empty());
-  auto message = communication::GetMessage(reinterpret_cast<std::uint8_t*>(raw_message.data()));
+  auto message = communication::GetMessage(raw_message.data());
   auto message_type = message->message_type();
   switch (message_type) {
     case communication::MessageType::kBmrInputGate0: {
@@ -86,6 +86,13 @@ class Wire final : public BooleanWire {
  protected:
   void DynamicClear() final { setup_ready_ = false; }
 
+  void DynamicReleaseValues() final {
+    public_values_ = BitVector<>();
+    shared_permutation_bits_ = BitVector<>();
+    secret_0_keys_ = Block128Vector();
+    public_keys_ = Block128Vector();
+  }
+
  private:
   void InitializationHelperBmr();
 
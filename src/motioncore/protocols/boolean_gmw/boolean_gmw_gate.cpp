@@ -78,7 +78,7 @@ void InputGate::InitializationHelper() {
 
   output_wires_.reserve(input_.size());
   for (auto& v : input_) {
-    auto wire = std::make_shared<boolean_gmw::Wire>(v, backend_);
+    auto wire = GetRegister().MakeShared<boolean_gmw::Wire>(v, backend_);
     output_wires_.push_back(std::static_pointer_cast<motion::Wire>(wire));
   }
 
@@ -164,7 +164,7 @@ void InputGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer InputGate::GetOutputAsGmwShare() {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -213,7 +213,7 @@ OutputGate::OutputGate(const motion::SharePointer& parent, std::size_t output_ow
   output_wires_.reserve(number_of_wires);
   for (size_t i = 0; i < number_of_wires; ++i) {
     auto& w = output_wires_.emplace_back(std::static_pointer_cast<motion::Wire>(
-        std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
+        GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
     GetRegister().RegisterNextWire(w);
   }
 
@@ -353,7 +353,7 @@ void OutputGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer OutputGate::GetOutputAsGmwShare() const {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -396,7 +396,7 @@ XorGate::XorGate(const motion::SharePointer& a, const motion::SharePointer& b)
   output_wires_.reserve(number_of_wires);
   for (size_t i = 0; i < number_of_wires; ++i) {
     auto& w = output_wires_.emplace_back(std::static_pointer_cast<motion::Wire>(
-        std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
+        GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
     GetRegister().RegisterNextWire(w);
   }
 
@@ -449,7 +449,7 @@ void XorGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer XorGate::GetOutputAsGmwShare() const {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -484,7 +484,7 @@ InvGate::InvGate(const motion::SharePointer& parent) : OneGate(parent->GetBacken
   output_wires_.reserve(number_of_wires);
   for (size_t i = 0; i < number_of_wires; ++i) {
     auto& w = output_wires_.emplace_back(std::static_pointer_cast<motion::Wire>(
-        std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
+        GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
     GetRegister().RegisterNextWire(w);
   }
 
@@ -526,7 +526,7 @@ void InvGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer InvGate::GetOutputAsGmwShare() const {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -557,23 +557,26 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   auto& _register = GetRegister();
 
   for (auto& w : dummy_wires_d) {
-    w = std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values);
+    w = GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values);
     _register.RegisterNextWire(w);
   }
 
   for (auto& w : dummy_wires_e) {
-    w = std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values);
+    w = GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values);
     _register.RegisterNextWire(w);
   }
 
-  d_ = std::make_shared<boolean_gmw::Share>(dummy_wires_d);
-  e_ = std::make_shared<boolean_gmw::Share>(dummy_wires_e);
+  d_ = GetRegister().MakeShared<boolean_gmw::Share>(dummy_wires_d);
+  e_ = GetRegister().MakeShared<boolean_gmw::Share>(dummy_wires_e);
 
-  d_output_ = std::make_shared<OutputGate>(d_);
-  e_output_ = std::make_shared<OutputGate>(e_);
+  // d and e are opened together in a single message per peer
+  std::vector<motion::WirePointer> dummy_wires_de(dummy_wires_d);
+  dummy_wires_de.insert(dummy_wires_de.end(), dummy_wires_e.begin(), dummy_wires_e.end());
+  de_output_ = GetRegister().MakeShared<OutputGate>(
+      GetRegister().MakeShared<boolean_gmw::Share>(dummy_wires_de));
 
-  _register.RegisterNextGate(d_output_);
-  _register.RegisterNextGate(e_output_);
+  _register.RegisterNextGate(de_output_);
+  ConsumeOutputWiresOf(*de_output_);
 
   gate_id_ = _register.NextGateId();
 
@@ -591,7 +594,7 @@ AndGate::AndGate(const motion::SharePointer& a, const motion::SharePointer& b)
   output_wires_.reserve(number_of_wires);
   for (size_t i = 0; i < number_of_wires; ++i) {
     auto& w = output_wires_.emplace_back(std::static_pointer_cast<motion::Wire>(
-        std::make_shared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
+        GetRegister().MakeShared<boolean_gmw::Wire>(backend_, number_of_simd_values)));
     GetRegister().RegisterNextWire(w);
   }
 
@@ -650,23 +653,22 @@ void AndGate::EvaluateOnline() {
     e->SetOnlineFinished();
   }
 
-  d_output_->WaitOnline();
-  e_output_->WaitOnline();
+  de_output_->WaitOnline();
 
-  const auto& d_clear = d_output_->GetOutputWires();
-  const auto& e_clear = e_output_->GetOutputWires();
+  // the first half of the output wires holds d, the second half holds e
+  const auto& de_clear = de_output_->GetOutputWires();
+  const auto number_of_wires = parent_a_.size();
+  assert(de_clear.size() == 2 * number_of_wires);
 
-  for (auto& wire : d_clear) {
-    wire->GetIsReadyCondition().Wait();
-  }
-  for (auto& wire : e_clear) {
+  for (auto& wire : de_clear) {
     wire->GetIsReadyCondition().Wait();
   }
 
-  for (auto i = 0ull; i < d_clear.size(); ++i) {
-    const auto d_w = std::dynamic_pointer_cast<const boolean_gmw::Wire>(d_clear.at(i));
+  for (auto i = 0ull; i < number_of_wires; ++i) {
+    const auto d_w = std::dynamic_pointer_cast<const boolean_gmw::Wire>(de_clear.at(i));
     const auto x_i_w = std::dynamic_pointer_cast<const boolean_gmw::Wire>(parent_a_.at(i));
-    const auto e_w = std::dynamic_pointer_cast<const boolean_gmw::Wire>(e_clear.at(i));
+    const auto e_w =
+        std::dynamic_pointer_cast<const boolean_gmw::Wire>(de_clear.at(number_of_wires + i));
     const auto y_i_w = std::dynamic_pointer_cast<const boolean_gmw::Wire>(parent_b_.at(i));
 
     assert(d_w);
@@ -701,7 +703,7 @@ void AndGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer AndGate::GetOutputAsGmwShare() const {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
@@ -754,7 +756,7 @@ MuxGate::MuxGate(const motion::SharePointer& a, const motion::SharePointer& b,
   BitVector dummy_bv(number_of_simd_values);
   for (size_t i = 0; i < number_of_wires; ++i) {
     auto& w = output_wires_.emplace_back(std::static_pointer_cast<motion::Wire>(
-        std::make_shared<boolean_gmw::Wire>(dummy_bv, backend_)));
+        GetRegister().MakeShared<boolean_gmw::Wire>(dummy_bv, backend_)));
     GetRegister().RegisterNextWire(w);
   }
 
@@ -878,7 +880,7 @@ void MuxGate::EvaluateOnline() {
 }
 
 const boolean_gmw::SharePointer MuxGate::GetOutputAsGmwShare() const {
-  auto result = std::make_shared<boolean_gmw::Share>(output_wires_);
+  auto result = GetRegister().MakeShared<boolean_gmw::Share>(output_wires_);
   assert(result);
   return result;
 }
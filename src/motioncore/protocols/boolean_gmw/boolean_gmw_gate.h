@@ -26,6 +26,7 @@
 
 #include "boolean_gmw_share.h"
 
+#include "communication/message_view.h"
 #include "protocols/gate.h"
 #include "utility/bit_vector.h"
 #include "utility/reusable_future.h"
@@ -88,7 +89,7 @@ class OutputGate final : public motion::OutputGate {
   // indicates whether this party obtains the output
   bool is_my_output_ = false;
 
-  std::vector<ReusableFiberFuture<std::vector<std::uint8_t>>> output_message_futures_;
+  std::vector<ReusableFiberFuture<communication::MessageView>> output_message_futures_;
 
   std::mutex m_;
 };
@@ -154,7 +155,7 @@ class AndGate final : public TwoGate {
   std::size_t mt_bitlen_;
 
   std::shared_ptr<motion::Share> d_, e_;
-  std::shared_ptr<OutputGate> d_output_, e_output_;
+  std::shared_ptr<OutputGate> de_output_;
 };
 
 class MuxGate final : public ThreeGate {
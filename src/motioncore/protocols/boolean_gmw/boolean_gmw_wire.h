@@ -61,6 +61,9 @@ class Wire final : public BooleanWire {
 
   bool IsConstant() const noexcept final { return false; }
 
+ protected:
+  void DynamicReleaseValues() final { values_ = BitVector<>(); }
+
  private:
   BitVector<> values_;
 };
@@ -0,0 +1,175 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <type_traits>
+
+#include "base/register.h"
+#include "communication/communication_layer.h"
+#include "multiplication_triple/sb_provider.h"
+#include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
+#include "protocols/arithmetic_gmw/arithmetic_gmw_share.h"
+#include "protocols/arithmetic_gmw/arithmetic_gmw_wire.h"
+#include "protocols/boolean_gmw/boolean_gmw_share.h"
+#include "protocols/boolean_gmw/boolean_gmw_wire.h"
+#include "protocols/gate.h"
+#include "protocols/share.h"
+#include "utility/constants.h"
+#include "utility/logger.h"
+
+namespace encrypto::motion {
+
+/// \brief First step of the conversion of an arithmetic GMW share x to Boolean GMW using edaBits.
+///
+/// The parties open c = x - r for an edaBit r, such that x = c + r can be computed by a Boolean
+/// adder.  Since c is public, the gate outputs the generate bits g_i = c_i & r_i and propagate
+/// bits p_i = c_i ^ r_i of this addition without interaction, the carries are left to an adder
+/// for generate and propagate bits, see ShareWrapper::Convert.
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+class ArithmeticGmwToBooleanGmwGate final : public OneGate {
+ public:
+  ArithmeticGmwToBooleanGmwGate(const SharePointer& parent) : OneGate(parent->GetBackend()) {
+    assert(parent->GetProtocol() == MpcProtocol::kArithmeticGmw);
+    assert(parent->GetBitLength() == kBitLength);
+    parent_ = parent->GetWires();
+    assert(parent_.size() == 1);
+    const auto number_of_simd{parent->GetNumberOfSimdValues()};
+
+    requires_online_interaction_ = true;
+    gate_type_ = GateType::kInteractive;
+
+    // the generate bits followed by the propagate bits
+    output_wires_.reserve(2 * kBitLength);
+    for (std::size_t i = 0; i < 2 * kBitLength; ++i) {
+      output_wires_.emplace_back(
+          GetRegister().MakeShared<proto::boolean_gmw::Wire>(backend_, number_of_simd));
+      GetRegister().RegisterNextWire(output_wires_.back());
+    }
+
+    // c = x - r is opened by an inner output gate
+    c_ = GetRegister().MakeShared<proto::arithmetic_gmw::Wire<T>>(backend_, number_of_simd);
+    GetRegister().RegisterNextWire(c_);
+    c_output_ = GetRegister().MakeShared<proto::arithmetic_gmw::OutputGate<T>>(c_);
+    GetRegister().RegisterNextGate(c_output_);
+    ConsumeOutputWiresOf(*c_output_);
+
+    edabit_offset_ = GetSbProvider().template RequestEdaBits<T>(number_of_simd);
+
+    gate_id_ = GetRegister().NextGateId();
+
+    RegisterWaitingFor(parent_.at(0)->GetWireId());
+    parent_.at(0)->RegisterWaitingGate(gate_id_);
+
+    if constexpr (kDebug) {
+      GetLogger().LogDebug(fmt::format(
+          "Created an arithmetic GMW to Boolean GMW conversion gate with id {}, parent wire {}",
+          gate_id_, parent_.at(0)->GetWireId()));
+    }
+  }
+
+  ~ArithmeticGmwToBooleanGmwGate() final = default;
+
+  void EvaluateSetup() final {
+    SetSetupIsReady();
+    GetRegister().IncrementEvaluatedGatesSetupCounter();
+  }
+
+  void EvaluateOnline() final {
+    WaitSetup();
+    assert(setup_is_ready_);
+    parent_.at(0)->GetIsReadyCondition().Wait();
+
+    auto& sb_provider = GetSbProvider();
+    sb_provider.WaitFinished();
+
+    const auto number_of_simd{parent_.at(0)->GetNumberOfSimdValues()};
+    const auto edabits = sb_provider.template GetEdaBits<T>(edabit_offset_, number_of_simd);
+
+    // open c = x - r
+    const auto x = std::static_pointer_cast<const proto::arithmetic_gmw::Wire<T>>(parent_.at(0));
+    const auto& x_values = x->GetValues();
+    auto& c_values = c_->GetMutableValues();
+    c_values.resize(number_of_simd);
+    for (std::size_t j = 0; j < number_of_simd; ++j) {
+      c_values[j] = x_values[j] - edabits.values[j];
+    }
+    c_->SetOnlineFinished();
+
+    c_output_->WaitOnline();
+    const auto c_clear = std::static_pointer_cast<const proto::arithmetic_gmw::Wire<T>>(
+        c_output_->GetOutputWires().at(0));
+    const auto& c = c_clear->GetValues();
+
+    // only one party adds the public c to its share of the propagate bits
+    const bool add_c{GetCommunicationLayer().GetMyId() == 0};
+    BitVector<> c_bits(number_of_simd);
+    for (std::size_t bit_i = 0; bit_i < kBitLength; ++bit_i) {
+      for (std::size_t j = 0; j < number_of_simd; ++j) {
+        c_bits.Set(((c[j] >> bit_i) & 1) == 1, j);
+      }
+      const auto& r_bits = edabits.bits[bit_i];
+
+      auto generate =
+          std::static_pointer_cast<proto::boolean_gmw::Wire>(output_wires_.at(bit_i));
+      generate->GetMutableValues() = c_bits & r_bits;
+      generate->SetOnlineFinished();
+
+      auto propagate =
+          std::static_pointer_cast<proto::boolean_gmw::Wire>(output_wires_.at(kBitLength + bit_i));
+      propagate->GetMutableValues() = add_c ? c_bits ^ r_bits : r_bits;
+      propagate->SetOnlineFinished();
+    }
+
+    GetLogger().LogDebug(
+        fmt::format("Evaluated ArithmeticGmwToBooleanGmwGate with id#{}", gate_id_));
+    SetOnlineIsReady();
+    GetRegister().IncrementEvaluatedGatesOnlineCounter();
+  }
+
+  // the generate bits g_i = c_i & r_i
+  proto::boolean_gmw::SharePointer GetGenerateAsBooleanShare() {
+    return GetRegister().MakeShared<proto::boolean_gmw::Share>(std::vector<WirePointer>(
+        output_wires_.cbegin(), output_wires_.cbegin() + kBitLength));
+  }
+
+  // the propagate bits p_i = c_i ^ r_i
+  proto::boolean_gmw::SharePointer GetPropagateAsBooleanShare() {
+    return GetRegister().MakeShared<proto::boolean_gmw::Share>(std::vector<WirePointer>(
+        output_wires_.cbegin() + kBitLength, output_wires_.cend()));
+  }
+
+  ArithmeticGmwToBooleanGmwGate() = delete;
+
+  ArithmeticGmwToBooleanGmwGate(const Gate&) = delete;
+
+ private:
+  static constexpr std::size_t kBitLength{sizeof(T) * 8};
+
+  std::size_t edabit_offset_;
+  proto::arithmetic_gmw::WirePointer<T> c_;
+  std::shared_ptr<proto::arithmetic_gmw::OutputGate<T>> c_output_;
+};
+
+}  // namespace encrypto::motion
@@ -23,8 +23,16 @@
 #pragma once
 
 #include <type_traits>
+
+#include "base/motion_base_provider.h"
 #include "base/register.h"
+#include "communication/communication_layer.h"
+#include "communication/fbs_headers/message_generated.h"
+#include "communication/fbs_headers/output_message_generated.h"
+#include "communication/output_message.h"
 #include "multiplication_triple/sb_provider.h"
+#include "oblivious_transfer/ot_flavors.h"
+#include "oblivious_transfer/ot_provider.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_share.h"
 #include "protocols/boolean_gmw/boolean_gmw_gate.h"
 #include "protocols/boolean_gmw/boolean_gmw_share.h"
@@ -34,9 +42,15 @@
 #include "utility/constants.h"
 #include "utility/fiber_condition.h"
 #include "utility/logger.h"
+#include "utility/reusable_future.h"
 
 namespace encrypto::motion {
 
+/// \brief Converts a Boolean GMW share of bit length sizeof(T) * 8 to an arithmetic GMW share
+/// using one shared bit (SB) r per input bit b.
+///
+/// The masked bits t = b ^ r of all wires and SIMD values are packed into a single BitVector and
+/// opened in one message per party.  Afterwards, b = t + r - 2tr is recombined locally.
 template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
 class GmwToArithmeticGate final : public OneGate {
  public:
@@ -58,21 +72,9 @@ class GmwToArithmeticGate final : public OneGate {
 
     // create the output wire
     output_wires_.emplace_back(
-        std::make_shared<proto::arithmetic_gmw::Wire<T>>(backend_, number_of_simd));
+        GetRegister().MakeShared<proto::arithmetic_gmw::Wire<T>>(backend_, number_of_simd));
     GetRegister().RegisterNextWire(output_wires_.at(0));
 
-    std::vector<WirePointer> dummy_wires;
-    dummy_wires.reserve(number_of_simd);
-    for (std::size_t i = 0; i < bit_size; ++i) {
-      auto w = std::make_shared<proto::boolean_gmw::Wire>(backend_, number_of_simd);
-      GetRegister().RegisterNextWire(w);
-      dummy_wires.emplace_back(std::move(w));
-    }
-    ts_ = std::make_shared<proto::boolean_gmw::Share>(dummy_wires);
-    // also create an output gate for the ts
-    ts_output_ = std::make_shared<proto::boolean_gmw::OutputGate>(ts_);
-    GetRegister().RegisterNextGate(ts_output_);
-
     // register the required number of shared bits
     number_of_sbs_ = number_of_simd * bit_size;
     sb_offset_ = GetSbProvider().template RequestSbs<T>(number_of_sbs_);
@@ -80,6 +82,9 @@ class GmwToArithmeticGate final : public OneGate {
     // register this gate
     gate_id_ = GetRegister().NextGateId();
 
+    // the masked bits of the other parties are received as a single output message each
+    output_message_futures_ = GetBaseProvider().RegisterForOutputMessages(gate_id_);
+
     // register this gate with the parent wires
     for (auto& wire : parent_) {
       RegisterWaitingFor(wire->GetWireId());
@@ -116,51 +121,61 @@ class GmwToArithmeticGate final : public OneGate {
     auto& sb_provider = GetSbProvider();
     sb_provider.WaitFinished();
 
+    auto& communication_layer = GetCommunicationLayer();
+    const auto my_id{communication_layer.GetMyId()};
+    const auto number_of_parties{communication_layer.GetNumberOfParties()};
     const auto number_of_simd{parent_.at(0)->GetNumberOfSimdValues()};
     constexpr auto bit_size = sizeof(T) * 8;
 
-    // mask the input bits with the shared bits
-    // and assign the result to t
-    const auto& sbs = sb_provider.template GetSbsAll<T>();
-    auto& ts_wires = ts_->GetMutableWires();
-    for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
-      auto t_wire = std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(ts_wires.at(wire_i));
-      auto parent_gmw_wire =
-          std::dynamic_pointer_cast<const proto::boolean_gmw::Wire>(parent_.at(wire_i));
-      t_wire->GetMutableValues() = parent_gmw_wire->GetValues();
-      // xor them with the shared bits
-      for (std::size_t j = 0; j < number_of_simd; ++j) {
-        auto b = t_wire->GetValues().Get(j);
-        bool sb = sbs.at(sb_offset_ + wire_i * number_of_simd + j) & 1;
-        t_wire->GetMutableValues().Set(b ^ sb, j);
-      }
-      t_wire->SetOnlineFinished();
+    // pack the input bits wire by wire, such that bit k = wire_i * number_of_simd + j is masked
+    // with the least significant bit of the k-th shared bit
+    const T* sbs = sb_provider.template GetSbsAll<T>().data() + sb_offset_;
+    BitVector<> ts;
+    ts.Reserve(BitsToBytes(number_of_sbs_));
+    for (const auto& wire : parent_) {
+      ts.Append(std::static_pointer_cast<const proto::boolean_gmw::Wire>(wire)->GetValues());
+    }
+    BitVector<> sb_bits(number_of_sbs_);
+    for (std::size_t k = 0; k < number_of_sbs_; ++k) {
+      sb_bits.Set((sbs[k] & 1) == 1, k);
     }
+    ts ^= sb_bits;
 
-    // reconstruct t
-    ts_output_->WaitOnline();
-    const auto& ts_clear = ts_output_->GetOutputWires();
-    std::vector<std::shared_ptr<proto::boolean_gmw::Wire>> ts_clear_b;
-    ts_clear_b.reserve(ts_clear.size());
-    std::transform(ts_clear.cbegin(), ts_clear.cend(), std::back_inserter(ts_clear_b),
-                   [](auto& w) { return std::dynamic_pointer_cast<proto::boolean_gmw::Wire>(w); });
+    // open t with a single message per party
+    const auto ts_data = reinterpret_cast<const std::uint8_t*>(ts.GetData().data());
+    std::vector<std::vector<std::uint8_t>> payloads{
+        std::vector<std::uint8_t>(ts_data, ts_data + ts.GetData().size())};
+    communication_layer.BroadcastMessage(communication::BuildOutputMessage(gate_id_, payloads));
+    for (std::size_t party_id = 0; party_id < number_of_parties; ++party_id) {
+      if (party_id == my_id) continue;
+      const auto output_message = output_message_futures_.at(party_id).get();
+      auto message = communication::GetMessage(output_message.data());
+      auto output_message_pointer = communication::GetOutputMessage(message->payload()->data());
+      assert(output_message_pointer);
+      assert(output_message_pointer->wires()->size() == 1);
+      auto payload = output_message_pointer->wires()->Get(0)->payload();
+      auto payload_pointer = reinterpret_cast<const std::byte*>(payload->data());
+      assert(payload->size() == ts.GetData().size());
+      ts ^= BitVector<>(payload_pointer, number_of_sbs_);
+    }
 
-    auto output = std::dynamic_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
-    output->GetMutableValues().resize(number_of_simd);
-    for (std::size_t j = 0; j < number_of_simd; ++j) {
-      T output_value = 0;
-      for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
-        if (GetCommunicationLayer().GetMyId() == 0) {
-          T t(ts_clear_b.at(wire_i)->GetValues().Get(j));         // the masked bit
-          T r(sbs.at(sb_offset_ + wire_i * number_of_simd + j));  // the arithmetically shared bit
-          output_value += T(t + r - 2 * t * r) << wire_i;
-        } else {
-          T t(ts_clear_b.at(wire_i)->GetValues().Get(j));         // the masked bit
-          T r(sbs.at(sb_offset_ + wire_i * number_of_simd + j));  // the arithmetically shared bit
-          output_value += T(r - 2 * t * r) << wire_i;
-        }
+    // shift-accumulate b = t + r - 2tr, where only party 0 adds t, such that the other parties
+    // add r if t = 0 and -r if t = 1
+    auto output = std::static_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    auto& output_values = output->GetMutableValues();
+    output_values.assign(number_of_simd, 0);
+    const T add_t = my_id == 0 ? 1 : 0;
+    std::vector<T> t(number_of_simd);
+    for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
+      for (std::size_t j = 0; j < number_of_simd; ++j) {
+        t[j] = ts.Get(wire_i * number_of_simd + j);
+      }
+      const T* __restrict__ r = sbs + wire_i * number_of_simd;
+      T* __restrict__ out = output_values.data();
+      for (std::size_t j = 0; j < number_of_simd; ++j) {
+        const auto mask = static_cast<T>(-t[j]);
+        out[j] += T(((r[j] ^ mask) - mask + add_t * t[j]) << wire_i);
       }
-      output->GetMutableValues().at(j) = output_value;
     }
 
     GetLogger().LogDebug(fmt::format("Evaluated B2AGate with id#{}", gate_id_));
@@ -168,15 +183,14 @@ class GmwToArithmeticGate final : public OneGate {
     GetRegister().IncrementEvaluatedGatesOnlineCounter();
   }
 
-  const proto::arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() const {
+  const proto::arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
     auto arithmetic_wire =
         std::dynamic_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
     assert(arithmetic_wire);
-    auto result = std::make_shared<proto::arithmetic_gmw::Share<T>>(arithmetic_wire);
-    return result;
+    return GetRegister().MakeShared<proto::arithmetic_gmw::Share<T>>(arithmetic_wire);
   }
 
-  const SharePointer GetOutputAsShare() const {
+  const SharePointer GetOutputAsShare() {
     return std::dynamic_pointer_cast<Share>(GetOutputAsArithmeticShare());
   }
 
@@ -187,8 +201,151 @@ class GmwToArithmeticGate final : public OneGate {
  private:
   std::size_t number_of_sbs_;
   std::size_t sb_offset_;
-  proto::boolean_gmw::SharePointer ts_;
-  std::shared_ptr<proto::boolean_gmw::OutputGate> ts_output_;
+  std::vector<ReusableFiberFuture<communication::MessageView>> output_message_futures_;
+};
+
+/// \brief Two-party conversion of a Boolean GMW share to an arithmetic GMW share using one
+/// additively correlated OT per input bit instead of a shared bit.
+///
+/// For the shares b0 and b1 of bit i, party 0 sends the correlation 2^i * (1 - 2 * b0) and party 1
+/// chooses with b1.  If party 0 obtains s, party 1 obtains s + b1 * 2^i * (1 - 2 * b0), so
+/// 2^i * b0 - s and s + b1 * 2^i * (1 - 2 * b0) are arithmetic shares of 2^i * (b0 ^ b1).
+template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+class GmwToArithmeticOtGate final : public OneGate {
+ public:
+  GmwToArithmeticOtGate(const SharePointer& parent) : OneGate(parent->GetBackend()) {
+    parent_ = parent->GetWires();
+    const auto number_of_simd{parent->GetNumberOfSimdValues()};
+    constexpr auto bit_size = sizeof(T) * 8;
+
+    assert(parent_.size() == bit_size);
+    for ([[maybe_unused]] const auto& wire : parent_) {
+      assert(wire->GetBitLength() == 1);
+      assert(wire->GetNumberOfSimdValues() == number_of_simd);
+      assert(wire->GetProtocol() == MpcProtocol::kBooleanGmw);
+    }
+
+    const auto& communication_layer = GetCommunicationLayer();
+    if (communication_layer.GetNumberOfParties() != 2) {
+      throw std::runtime_error(
+          "OT-based Boolean GMW to Arithmetic GMW conversion is only implemented for two parties");
+    }
+
+    requires_online_interaction_ = true;
+    gate_type_ = GateType::kInteractive;
+
+    output_wires_.emplace_back(
+        GetRegister().MakeShared<proto::arithmetic_gmw::Wire<T>>(backend_, number_of_simd));
+    GetRegister().RegisterNextWire(output_wires_.at(0));
+
+    const auto number_of_ots{number_of_simd * bit_size};
+    if (communication_layer.GetMyId() == 0) {
+      ot_sender_ = GetOtProvider(1).template RegisterSendAcOt<T>(number_of_ots);
+    } else {
+      ot_receiver_ = GetOtProvider(0).template RegisterReceiveAcOt<T>(number_of_ots);
+    }
+
+    gate_id_ = GetRegister().NextGateId();
+
+    for (auto& wire : parent_) {
+      RegisterWaitingFor(wire->GetWireId());
+      wire->RegisterWaitingGate(gate_id_);
+    }
+
+    if constexpr (kDebug) {
+      auto gate_info = fmt::format("gate id {}, parent wires: ", gate_id_);
+      for (const auto& wire : parent_) gate_info.append(fmt::format("{} ", wire->GetWireId()));
+      gate_info.append(fmt::format(" output wire: {}", output_wires_.at(0)->GetWireId()));
+      GetLogger().LogDebug(fmt::format(
+          "Created an OT-based Boolean GMW to Arithmetic GMW conversion gate with following "
+          "properties: {}",
+          gate_info));
+    }
+  }
+
+  ~GmwToArithmeticOtGate() final = default;
+
+  void EvaluateSetup() final {
+    SetSetupIsReady();
+    GetRegister().IncrementEvaluatedGatesSetupCounter();
+  }
+
+  void EvaluateOnline() final {
+    WaitSetup();
+    assert(setup_is_ready_);
+
+    for (const auto& wire : parent_) {
+      wire->GetIsReadyCondition().Wait();
+    }
+
+    const auto number_of_simd{parent_.at(0)->GetNumberOfSimdValues()};
+    constexpr auto bit_size = sizeof(T) * 8;
+
+    // OT k = wire_i * number_of_simd + j converts bit wire_i of SIMD value j
+    BitVector<> bits;
+    bits.Reserve(BitsToBytes(number_of_simd * bit_size));
+    for (const auto& wire : parent_) {
+      bits.Append(std::static_pointer_cast<const proto::boolean_gmw::Wire>(wire)->GetValues());
+    }
+
+    auto output = std::static_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    auto& output_values = output->GetMutableValues();
+    output_values.assign(number_of_simd, 0);
+    T* __restrict__ out = output_values.data();
+
+    if (ot_sender_) {
+      std::vector<T> correlations(number_of_simd * bit_size);
+      for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
+        for (std::size_t j = 0; j < number_of_simd; ++j) {
+          const T b = bits.Get(wire_i * number_of_simd + j);
+          correlations[wire_i * number_of_simd + j] = T(T(1 - 2 * b) << wire_i);
+          out[j] += T(b << wire_i);
+        }
+      }
+      ot_sender_->WaitSetup();
+      ot_sender_->SetCorrelations(std::move(correlations));
+      ot_sender_->SendMessages();
+      ot_sender_->ComputeOutputs();
+      const auto& ot_outputs = ot_sender_->GetOutputs();
+      for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
+        const T* __restrict__ s = ot_outputs.data() + wire_i * number_of_simd;
+        for (std::size_t j = 0; j < number_of_simd; ++j) out[j] -= s[j];
+      }
+    } else {
+      ot_receiver_->WaitSetup();
+      ot_receiver_->SetChoices(std::move(bits));
+      ot_receiver_->SendCorrections();
+      ot_receiver_->ComputeOutputs();
+      const auto& ot_outputs = ot_receiver_->GetOutputs();
+      for (std::size_t wire_i = 0; wire_i < bit_size; ++wire_i) {
+        const T* __restrict__ s = ot_outputs.data() + wire_i * number_of_simd;
+        for (std::size_t j = 0; j < number_of_simd; ++j) out[j] += s[j];
+      }
+    }
+
+    GetLogger().LogDebug(fmt::format("Evaluated B2AOtGate with id#{}", gate_id_));
+    SetOnlineIsReady();
+    GetRegister().IncrementEvaluatedGatesOnlineCounter();
+  }
+
+  const proto::arithmetic_gmw::SharePointer<T> GetOutputAsArithmeticShare() {
+    auto arithmetic_wire =
+        std::dynamic_pointer_cast<proto::arithmetic_gmw::Wire<T>>(output_wires_.at(0));
+    assert(arithmetic_wire);
+    return GetRegister().MakeShared<proto::arithmetic_gmw::Share<T>>(arithmetic_wire);
+  }
+
+  const SharePointer GetOutputAsShare() {
+    return std::dynamic_pointer_cast<Share>(GetOutputAsArithmeticShare());
+  }
+
+  GmwToArithmeticOtGate() = delete;
+
+  GmwToArithmeticOtGate(const Gate&) = delete;
+
+ private:
+  std::unique_ptr<AcOtSender<T>> ot_sender_;
+  std::unique_ptr<AcOtReceiver<T>> ot_receiver_;
 };
 
 }  // namespace encrypto::motion
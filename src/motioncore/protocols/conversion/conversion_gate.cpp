@@ -144,8 +144,9 @@ BooleanGmwToBmrGate::BooleanGmwToBmrGate(const SharePointer& parent)
   for ([[maybe_unused]] const auto& wire : parent_)
     assert(wire->GetProtocol() == MpcProtocol::kBooleanGmw);
 
-  requires_online_interaction_ = false;
-  gate_type_ = GateType::kNonInteractive;
+  // the masked values are published in the online phase
+  requires_online_interaction_ = true;
+  gate_type_ = GateType::kInteractive;
   gate_id_ = GetRegister().NextGateId();
 
   for (auto& wire : parent_) {
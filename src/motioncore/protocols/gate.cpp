@@ -27,6 +27,7 @@
 
 #include "base/backend.h"
 #include "base/register.h"
+#include "executor/gate_executor.h"
 #include "oblivious_transfer/ot_provider.h"
 #include "utility/condition.h"
 #include "utility/fiber_condition.h"
@@ -40,7 +41,22 @@ void Gate::RegisterWaitingFor(std::size_t wire_id) {
 
 void Gate::SignalDependencyIsReady() {
   number_of_ready_dependencies_++;
-  IfReadyAddToProcessingQueue();
+  IfReadySchedule();
+}
+
+void Gate::ReleaseWireDependencies() {
+  auto& reg = GetRegister();
+  for (const auto wire_id : wire_dependencies_) {
+    reg.GetWire(wire_id)->ReleaseConsumer();
+  }
+  for (const auto& wire : consumed_inner_wires_) {
+    wire->ReleaseValues();
+  }
+}
+
+void Gate::ConsumeOutputWiresOf(const Gate& inner_gate) {
+  consumed_inner_wires_.insert(consumed_inner_wires_.end(), inner_gate.output_wires_.begin(),
+                               inner_gate.output_wires_.end());
 }
 
 void Gate::SetSetupIsReady() {
@@ -69,18 +85,22 @@ void Gate::WaitSetup() const { setup_is_ready_condition_.Wait(); }
 
 void Gate::WaitOnline() const { online_is_ready_condition_.Wait(); }
 
-void Gate::IfReadyAddToProcessingQueue() {
-  std::scoped_lock lock(mutex_);
-  if (AreDependenciesReady() && !added_to_active_queue_) {
-    GetRegister().AddToActiveQueue(gate_id_);
-    added_to_active_queue_ = true;
+void Gate::IfReadySchedule() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (!AreDependenciesReady() || is_scheduled_) {
+      return;
+    }
+    is_scheduled_ = true;
   }
+  // dispatch without holding the lock, since non-interactive gates are evaluated inline
+  backend_.GetGateExecutor().Schedule(*this);
 }
 
 void Gate::Clear() {
   setup_is_ready_ = false;
   online_is_ready_ = false;
-  added_to_active_queue_ = false;
+  is_scheduled_ = false;
   number_of_ready_dependencies_ = 0;
 }
 
@@ -93,7 +113,7 @@ communication::CommunicationLayer& Gate::GetCommunicationLayer() {
   return backend_.GetCommunicationLayer();
 }
 
-Register& Gate::GetRegister() { return *backend_.GetRegister(); }
+Register& Gate::GetRegister() const { return *backend_.GetRegister(); }
 
 Configuration& Gate::GetConfiguration() { return *backend_.GetConfiguration(); }
 
@@ -82,6 +82,14 @@ class Gate {
 
   bool AreDependenciesReady() { return wire_dependencies_.size() == number_of_ready_dependencies_; }
 
+  bool HasWireDependencies() const { return !wire_dependencies_.empty(); }
+
+  const std::unordered_set<std::size_t>& GetWireDependencies() const { return wire_dependencies_; }
+
+  /// \brief Signals the wires this gate waited for that it finished reading them, and releases the
+  /// output wires of its inner gates, see ConsumeOutputWiresOf.
+  void ReleaseWireDependencies();
+
   void SetSetupIsReady();
 
   void SetOnlineIsReady();
@@ -94,6 +102,8 @@ class Gate {
 
   std::int64_t GetId() const { return gate_id_; }
 
+  GateType GetGateType() const { return gate_type_; }
+
   Gate(Gate&) = delete;
 
  protected:
@@ -101,13 +111,15 @@ class Gate {
   Backend& backend_;
   std::int64_t gate_id_ = -1;
   std::unordered_set<std::size_t> wire_dependencies_;
+  // output wires of inner gates which are only read by this gate
+  std::vector<WirePointer> consumed_inner_wires_;
 
   GateType gate_type_ = GateType::kInvalid;
   std::atomic<bool> setup_is_ready_ = false;
   std::atomic<bool> online_is_ready_ = false;
   std::atomic<bool> requires_online_interaction_ = false;
 
-  std::atomic<bool> added_to_active_queue_ = false;
+  std::atomic<bool> is_scheduled_ = false;
 
   FiberCondition setup_is_ready_condition_;
   FiberCondition online_is_ready_condition_;
@@ -116,7 +128,12 @@ class Gate {
 
   Gate(Backend& backend);
 
-  Register& GetRegister();
+  /// \brief Marks the output wires of @param inner_gate, e.g., the opened d and e of a
+  /// multiplication, as read only by this gate. No gate waits for them, so they are released
+  /// together with the wire dependencies of this gate.
+  void ConsumeOutputWiresOf(const Gate& inner_gate);
+
+  Register& GetRegister() const;
   Configuration& GetConfiguration();
   Logger& GetLogger();
   BaseProvider& GetBaseProvider();
@@ -128,7 +145,7 @@ class Gate {
   bool own_output_wires_{true};
 
  private:
-  void IfReadyAddToProcessingQueue();
+  void IfReadySchedule();
 
   std::mutex mutex_;
 };
@@ -24,9 +24,12 @@
 
 #include "share_wrapper.h"
 
+#include <algorithm>
+#include <queue>
 #include <typeinfo>
 
 #include "algorithm/algorithm_description.h"
+#include "algorithm/layered_circuit.h"
 #include "algorithm/tree.h"
 #include "base/backend.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
@@ -41,8 +44,10 @@
 #include "protocols/constant/constant_gate.h"
 #include "protocols/constant/constant_share.h"
 #include "protocols/constant/constant_wire.h"
+#include "protocols/conversion/a2b_gate.h"
 #include "protocols/conversion/b2a_gate.h"
 #include "protocols/conversion/conversion_gate.h"
+#include "protocols/conversion/eqz_gate.h"
 #include "protocols/data_management/simdify_gate.h"
 #include "protocols/data_management/subset_gate.h"
 #include "protocols/data_management/unsimdify_gate.h"
@@ -62,13 +67,13 @@ ShareWrapper ShareWrapper::operator~() const {
   if (share_->GetProtocol() == MpcProtocol::kBooleanGmw) {
     auto gmw_share = std::dynamic_pointer_cast<proto::boolean_gmw::Share>(share_);
     assert(gmw_share);
-    auto inv_gate = std::make_shared<proto::boolean_gmw::InvGate>(gmw_share);
+    auto inv_gate = share_->GetRegister()->MakeShared<proto::boolean_gmw::InvGate>(gmw_share);
     share_->GetRegister()->RegisterNextGate(inv_gate);
     return ShareWrapper(inv_gate->GetOutputAsShare());
   } else {
     auto bmr_share = std::dynamic_pointer_cast<proto::bmr::Share>(share_);
     assert(bmr_share);
-    auto inv_gate = std::make_shared<proto::bmr::InvGate>(bmr_share);
+    auto inv_gate = share_->GetRegister()->MakeShared<proto::bmr::InvGate>(bmr_share);
     share_->GetRegister()->RegisterNextGate(inv_gate);
     return ShareWrapper(inv_gate->GetOutputAsShare());
   }
@@ -92,14 +97,14 @@ ShareWrapper ShareWrapper::operator^(const ShareWrapper& other) const {
     assert(this_b);
     assert(other_b);
 
-    auto xor_gate = std::make_shared<proto::boolean_gmw::XorGate>(this_b, other_b);
+    auto xor_gate = share_->GetRegister()->MakeShared<proto::boolean_gmw::XorGate>(this_b, other_b);
     share_->GetRegister()->RegisterNextGate(xor_gate);
     return ShareWrapper(xor_gate->GetOutputAsShare());
   } else {
     auto this_b = std::dynamic_pointer_cast<proto::bmr::Share>(share_);
     auto other_b = std::dynamic_pointer_cast<proto::bmr::Share>(*other);
 
-    auto xor_gate = std::make_shared<proto::bmr::XorGate>(this_b, other_b);
+    auto xor_gate = share_->GetRegister()->MakeShared<proto::bmr::XorGate>(this_b, other_b);
     share_->GetRegister()->RegisterNextGate(xor_gate);
     return ShareWrapper(xor_gate->GetOutputAsShare());
   }
@@ -120,14 +125,14 @@ ShareWrapper ShareWrapper::operator&(const ShareWrapper& other) const {
     auto this_b = std::dynamic_pointer_cast<proto::boolean_gmw::Share>(share_);
     auto other_b = std::dynamic_pointer_cast<proto::boolean_gmw::Share>(*other);
 
-    auto and_gate = std::make_shared<proto::boolean_gmw::AndGate>(this_b, other_b);
+    auto and_gate = share_->GetRegister()->MakeShared<proto::boolean_gmw::AndGate>(this_b, other_b);
     share_->GetRegister()->RegisterNextGate(and_gate);
     return ShareWrapper(and_gate->GetOutputAsShare());
   } else {
     auto this_b = std::dynamic_pointer_cast<proto::bmr::Share>(share_);
     auto other_b = std::dynamic_pointer_cast<proto::bmr::Share>(*other);
 
-    auto and_gate = std::make_shared<proto::bmr::AndGate>(this_b, other_b);
+    auto and_gate = share_->GetRegister()->MakeShared<proto::bmr::AndGate>(this_b, other_b);
     share_->GetRegister()->RegisterNextGate(and_gate);
     return ShareWrapper(and_gate->GetOutputAsShare());
   }
@@ -235,7 +240,43 @@ ShareWrapper ShareWrapper::operator*(const ShareWrapper& other) const {
   }
 }
 
+ShareWrapper ShareWrapper::MatMul(const ShareWrapper& other, std::size_t rows, std::size_t inner,
+                                  std::size_t columns) const {
+  assert(*other);
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw ||
+      other->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("Matrix multiplication is only supported for arithmetic GMW shares");
+  }
+  if (share_->GetBitLength() != other->GetBitLength()) {
+    throw std::invalid_argument(
+        fmt::format("Matrix multiplication of shares of different bit lengths: {} vs {} bits",
+                    share_->GetBitLength(), other->GetBitLength()));
+  }
+
+  if (share_->GetBitLength() == 8u) {
+    return MatMul<std::uint8_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 16u) {
+    return MatMul<std::uint16_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 32u) {
+    return MatMul<std::uint32_t>(share_, *other, rows, inner, columns);
+  } else if (share_->GetBitLength() == 64u) {
+    return MatMul<std::uint64_t>(share_, *other, rows, inner, columns);
+  } else {
+    throw std::bad_cast();
+  }
+}
+
+ShareWrapper ShareWrapper::DotProduct(const ShareWrapper& other) const {
+  assert(share_);
+  return MatMul(other, 1, share_->GetNumberOfSimdValues(), 1);
+}
+
 ShareWrapper ShareWrapper::operator==(const ShareWrapper& other) const {
+  if (share_->GetProtocol() == MpcProtocol::kArithmeticGmw) {
+    return (*this - other).EqualityToZero();
+  }
+
   if (other->GetBitLength() != share_->GetBitLength()) {
     share_->GetBackend().GetLogger()->LogError(
         fmt::format("Comparing shared bit strings of different bit lengths: this {} bits vs other "
@@ -279,6 +320,131 @@ ShareWrapper ShareWrapper::operator==(const ShareWrapper& other) const {
   }
 }
 
+ShareWrapper ShareWrapper::BitDecomposition() const {
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("Bit decomposition is only implemented for arithmetic GMW shares");
+  }
+  return ArithmeticGmwToBooleanGmw();
+}
+
+ShareWrapper ShareWrapper::LessThanZero() const {
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("LessThanZero is only implemented for arithmetic GMW shares");
+  }
+  const auto [generate, propagate]{GenerateAndPropagate()};
+
+  // the most significant bit is p_{l - 1} ^ c_{l - 1}, where the carry c_{l - 1} is the generate
+  // bit of the bits [0, l - 2].  It is computed by a tree, which combines the groups 2k and 2k + 1
+  // of a level to group k of the next level.
+  std::vector<ShareWrapper> group_generate(generate.cbegin(), generate.cend() - 1);
+  std::vector<ShareWrapper> group_propagate(propagate.cbegin(), propagate.cend() - 1);
+  while (group_generate.size() > 1) {
+    const std::size_t number_of_pairs{group_generate.size() / 2};
+
+    // all ANDs of a level are evaluated by a single gate, the propagate bit of the lowest group is
+    // never needed
+    std::vector<ShareWrapper> lhs, rhs;
+    for (std::size_t k = 0; k < number_of_pairs; ++k) {
+      lhs.emplace_back(group_propagate[2 * k + 1]);
+      rhs.emplace_back(group_generate[2 * k]);
+    }
+    for (std::size_t k = 1; k < number_of_pairs; ++k) {
+      lhs.emplace_back(group_propagate[2 * k + 1]);
+      rhs.emplace_back(group_propagate[2 * k]);
+    }
+    const auto products{(Concatenate(lhs) & Concatenate(rhs)).Split()};
+
+    std::vector<ShareWrapper> high_generate;
+    for (std::size_t k = 0; k < number_of_pairs; ++k) {
+      high_generate.emplace_back(group_generate[2 * k + 1]);
+    }
+    auto next_generate{(Concatenate(high_generate) ^
+                        Concatenate(products.cbegin(), products.cbegin() + number_of_pairs))
+                           .Split()};
+    std::vector<ShareWrapper> next_propagate{group_propagate.front()};
+    next_propagate.insert(next_propagate.end(), products.cbegin() + number_of_pairs,
+                          products.cend());
+    if (group_generate.size() % 2 == 1) {
+      next_generate.emplace_back(group_generate.back());
+      next_propagate.emplace_back(group_propagate.back());
+    }
+    group_generate = std::move(next_generate);
+    group_propagate = std::move(next_propagate);
+  }
+
+  return propagate.back() ^ group_generate.front();
+}
+
+ShareWrapper ShareWrapper::Truncate(std::size_t fractional_bits) const {
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("Truncation is only implemented for arithmetic GMW shares");
+  }
+  if (fractional_bits + 2 > share_->GetBitLength()) {
+    throw std::invalid_argument(
+        fmt::format("Cannot truncate {}-bit shares by {} bits, at most {} bits are supported",
+                    share_->GetBitLength(), fractional_bits, share_->GetBitLength() - 2));
+  }
+  if (share_->GetBitLength() == 8u) {
+    return Truncate<std::uint8_t>(share_, fractional_bits);
+  } else if (share_->GetBitLength() == 16u) {
+    return Truncate<std::uint16_t>(share_, fractional_bits);
+  } else if (share_->GetBitLength() == 32u) {
+    return Truncate<std::uint32_t>(share_, fractional_bits);
+  } else if (share_->GetBitLength() == 64u) {
+    return Truncate<std::uint64_t>(share_, fractional_bits);
+  } else {
+    throw std::bad_cast();
+  }
+}
+
+ShareWrapper ShareWrapper::EqualityToZero() const {
+  assert(share_);
+  if (share_->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::runtime_error("EqualityToZero is only implemented for arithmetic GMW shares");
+  }
+  ShareWrapper equal_bits;
+  const auto bitlength = share_->GetBitLength();
+  switch (bitlength) {
+    case 8u: {
+      auto equality_to_zero_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwEqualityToZeroGate<std::uint8_t>>(share_)};
+      share_->GetRegister()->RegisterNextGate(equality_to_zero_gate);
+      equal_bits = ShareWrapper(equality_to_zero_gate->GetOutputAsBooleanShare());
+      break;
+    }
+    case 16u: {
+      auto equality_to_zero_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwEqualityToZeroGate<std::uint16_t>>(
+              share_)};
+      share_->GetRegister()->RegisterNextGate(equality_to_zero_gate);
+      equal_bits = ShareWrapper(equality_to_zero_gate->GetOutputAsBooleanShare());
+      break;
+    }
+    case 32u: {
+      auto equality_to_zero_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwEqualityToZeroGate<std::uint32_t>>(
+              share_)};
+      share_->GetRegister()->RegisterNextGate(equality_to_zero_gate);
+      equal_bits = ShareWrapper(equality_to_zero_gate->GetOutputAsBooleanShare());
+      break;
+    }
+    case 64u: {
+      auto equality_to_zero_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwEqualityToZeroGate<std::uint64_t>>(
+              share_)};
+      share_->GetRegister()->RegisterNextGate(equality_to_zero_gate);
+      equal_bits = ShareWrapper(equality_to_zero_gate->GetOutputAsBooleanShare());
+      break;
+    }
+    default:
+      throw std::runtime_error(fmt::format("Invalid bitlength {}", bitlength));
+  }
+  return FullAndTree(equal_bits);
+}
+
 ShareWrapper ShareWrapper::Mux(const ShareWrapper& a, const ShareWrapper& b) const {
   assert(*a);
   assert(*b);
@@ -302,7 +468,8 @@ ShareWrapper ShareWrapper::Mux(const ShareWrapper& a, const ShareWrapper& b) con
     assert(a_gmw);
     assert(b_gmw);
 
-    auto mux_gate = std::make_shared<proto::boolean_gmw::MuxGate>(a_gmw, b_gmw, this_gmw);
+    auto mux_gate =
+        share_->GetRegister()->MakeShared<proto::boolean_gmw::MuxGate>(a_gmw, b_gmw, this_gmw);
     share_->GetRegister()->RegisterNextGate(mux_gate);
     return ShareWrapper(mux_gate->GetOutputAsShare());
   } else {
@@ -336,8 +503,8 @@ ShareWrapper ShareWrapper::Convert() const {
       return this->Convert<kBooleanGmw>().Convert<kArithmeticGmw>();
     }
   } else if constexpr (P == kBooleanGmw) {
-    if (share_->GetProtocol() == kArithmeticGmw) {  // kArithmeticGmw --(over kBmr)--> kBooleanGmw
-      return this->Convert<kBmr>().Convert<kBooleanGmw>();
+    if (share_->GetProtocol() == kArithmeticGmw) {  // kArithmeticGmw -> kBooleanGmw
+      return ArithmeticGmwToBooleanGmw();
     } else {  // kBmr -> kBooleanGmw
       return BmrToBooleanGmw();
     }
@@ -358,35 +525,138 @@ template ShareWrapper ShareWrapper::Convert<MpcProtocol::kBooleanGmw>() const;
 template ShareWrapper ShareWrapper::Convert<MpcProtocol::kBmr>() const;
 
 ShareWrapper ShareWrapper::ArithmeticGmwToBmr() const {
-  auto arithmetic_gmw_to_bmr_gate{std::make_shared<ArithmeticGmwToBmrGate>(share_)};
+  auto arithmetic_gmw_to_bmr_gate{
+      share_->GetRegister()->MakeShared<ArithmeticGmwToBmrGate>(share_)};
   share_->GetRegister()->RegisterNextGate(arithmetic_gmw_to_bmr_gate);
   return ShareWrapper(arithmetic_gmw_to_bmr_gate->GetOutputAsShare());
 }
 
+std::pair<std::vector<ShareWrapper>, std::vector<ShareWrapper>>
+ShareWrapper::GenerateAndPropagate() const {
+  assert(share_->GetProtocol() == MpcProtocol::kArithmeticGmw);
+  std::vector<ShareWrapper> generate, propagate;
+  const auto bitlength = share_->GetBitLength();
+  switch (bitlength) {
+    case 8u: {
+      auto arithmetic_gmw_to_boolean_gmw_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwToBooleanGmwGate<std::uint8_t>>(share_)};
+      share_->GetRegister()->RegisterNextGate(arithmetic_gmw_to_boolean_gmw_gate);
+      generate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetGenerateAsBooleanShare()).Split();
+      propagate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetPropagateAsBooleanShare()).Split();
+      break;
+    }
+    case 16u: {
+      auto arithmetic_gmw_to_boolean_gmw_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwToBooleanGmwGate<std::uint16_t>>(share_)};
+      share_->GetRegister()->RegisterNextGate(arithmetic_gmw_to_boolean_gmw_gate);
+      generate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetGenerateAsBooleanShare()).Split();
+      propagate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetPropagateAsBooleanShare()).Split();
+      break;
+    }
+    case 32u: {
+      auto arithmetic_gmw_to_boolean_gmw_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwToBooleanGmwGate<std::uint32_t>>(share_)};
+      share_->GetRegister()->RegisterNextGate(arithmetic_gmw_to_boolean_gmw_gate);
+      generate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetGenerateAsBooleanShare()).Split();
+      propagate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetPropagateAsBooleanShare()).Split();
+      break;
+    }
+    case 64u: {
+      auto arithmetic_gmw_to_boolean_gmw_gate{
+          share_->GetRegister()->MakeShared<ArithmeticGmwToBooleanGmwGate<std::uint64_t>>(share_)};
+      share_->GetRegister()->RegisterNextGate(arithmetic_gmw_to_boolean_gmw_gate);
+      generate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetGenerateAsBooleanShare()).Split();
+      propagate =
+          ShareWrapper(arithmetic_gmw_to_boolean_gmw_gate->GetPropagateAsBooleanShare()).Split();
+      break;
+    }
+    default:
+      throw std::runtime_error(fmt::format("Invalid bitlength {}", bitlength));
+  }
+
+  return {std::move(generate), std::move(propagate)};
+}
+
+ShareWrapper ShareWrapper::ArithmeticGmwToBooleanGmw() const {
+  const auto [generate, propagate]{GenerateAndPropagate()};
+  const auto bitlength{generate.size()};
+
+  // Kogge-Stone prefix network over the bits [0, bitlength - 1), after the round with distance d,
+  // (carry[j], carry_propagate[j]) are the generate and propagate bits of the bits [j - 2d + 1, j].
+  // Generate and propagate bits of a group are never both set, so XOR computes the OR.
+  const std::size_t number_of_carries{bitlength - 1};
+  std::vector<ShareWrapper> carry(generate.cbegin(), generate.cend() - 1);
+  std::vector<ShareWrapper> carry_propagate(propagate.cbegin(), propagate.cend() - 1);
+  for (std::size_t distance = 1; distance < number_of_carries; distance *= 2) {
+    // all ANDs of a round are evaluated by a single gate
+    std::vector<ShareWrapper> lhs, rhs;
+    for (std::size_t j = distance; j < number_of_carries; ++j) {
+      lhs.emplace_back(carry_propagate[j]);
+      rhs.emplace_back(carry[j - distance]);
+    }
+    for (std::size_t j = 2 * distance; j < number_of_carries; ++j) {
+      lhs.emplace_back(carry_propagate[j]);
+      rhs.emplace_back(carry_propagate[j - distance]);
+    }
+    const auto products{(Concatenate(lhs) & Concatenate(rhs)).Split()};
+
+    const std::size_t number_of_updated_carries{number_of_carries - distance};
+    const auto updated_carries{
+        (Concatenate(carry.cbegin() + distance, carry.cend()) ^
+         Concatenate(products.cbegin(), products.cbegin() + number_of_updated_carries))
+            .Split()};
+    for (std::size_t j = distance; j < number_of_carries; ++j) {
+      carry[j] = updated_carries[j - distance];
+    }
+    for (std::size_t j = 2 * distance; j < number_of_carries; ++j) {
+      carry_propagate[j] = products[number_of_updated_carries + j - 2 * distance];
+    }
+  }
+
+  // the sum bits are s_0 = p_0 and s_j = p_j ^ carry_{j - 1}
+  auto sum{(Concatenate(propagate.cbegin() + 1, propagate.cend()) ^ Concatenate(carry)).Split()};
+  sum.insert(sum.begin(), propagate.front());
+  return Concatenate(sum);
+}
+
 ShareWrapper ShareWrapper::BooleanGmwToArithmeticGmw() const {
   const auto bitlength = share_->GetBitLength();
   switch (bitlength) {
     case 8u: {
       auto boolean_gmw_to_arithmetic_gmw_gate =
-          std::make_shared<GmwToArithmeticGate<std::uint8_t>>(share_);
+          share_->GetRegister()->MakeShared<GmwToArithmeticGate<std::uint8_t>>(share_);
       share_->GetRegister()->RegisterNextGate(boolean_gmw_to_arithmetic_gmw_gate);
       return ShareWrapper(boolean_gmw_to_arithmetic_gmw_gate->GetOutputAsShare());
     }
     case 16u: {
       auto boolean_gmw_to_arithmetic_gmw_gate{
-          std::make_shared<GmwToArithmeticGate<std::uint16_t>>(share_)};
+          share_->GetRegister()->MakeShared<GmwToArithmeticGate<std::uint16_t>>(share_)};
       share_->GetRegister()->RegisterNextGate(boolean_gmw_to_arithmetic_gmw_gate);
       return ShareWrapper(boolean_gmw_to_arithmetic_gmw_gate->GetOutputAsShare());
     }
     case 32u: {
       auto boolean_gmw_to_arithmetic_gmw_gate{
-          std::make_shared<GmwToArithmeticGate<std::uint32_t>>(share_)};
+          share_->GetRegister()->MakeShared<GmwToArithmeticGate<std::uint32_t>>(share_)};
       share_->GetRegister()->RegisterNextGate(boolean_gmw_to_arithmetic_gmw_gate);
       return ShareWrapper(boolean_gmw_to_arithmetic_gmw_gate->GetOutputAsShare());
     }
     case 64u: {
+      // with two parties, one correlated OT per bit is much cheaper than 64 shared bits
+      if (share_->GetBackend().GetCommunicationLayer().GetNumberOfParties() == 2) {
+        auto boolean_gmw_to_arithmetic_gmw_gate{
+            share_->GetRegister()->MakeShared<GmwToArithmeticOtGate<std::uint64_t>>(share_)};
+        share_->GetRegister()->RegisterNextGate(boolean_gmw_to_arithmetic_gmw_gate);
+        return ShareWrapper(boolean_gmw_to_arithmetic_gmw_gate->GetOutputAsShare());
+      }
       auto boolean_gmw_to_arithmetic_gmw_gate{
-          std::make_shared<GmwToArithmeticGate<std::uint64_t>>(share_)};
+          share_->GetRegister()->MakeShared<GmwToArithmeticGate<std::uint64_t>>(share_)};
       share_->GetRegister()->RegisterNextGate(boolean_gmw_to_arithmetic_gmw_gate);
       return ShareWrapper(boolean_gmw_to_arithmetic_gmw_gate->GetOutputAsShare());
     }
@@ -398,7 +668,8 @@ ShareWrapper ShareWrapper::BooleanGmwToArithmeticGmw() const {
 ShareWrapper ShareWrapper::BooleanGmwToBmr() const {
   auto boolean_gmw_share = std::dynamic_pointer_cast<proto::boolean_gmw::Share>(share_);
   assert(boolean_gmw_share);
-  auto boolean_gmw_to_bmr_gate{std::make_shared<BooleanGmwToBmrGate>(boolean_gmw_share)};
+  auto boolean_gmw_to_bmr_gate{
+      share_->GetRegister()->MakeShared<BooleanGmwToBmrGate>(boolean_gmw_share)};
   share_->GetRegister()->RegisterNextGate(boolean_gmw_to_bmr_gate);
   return ShareWrapper(boolean_gmw_to_bmr_gate->GetOutputAsShare());
 }
@@ -406,7 +677,7 @@ ShareWrapper ShareWrapper::BooleanGmwToBmr() const {
 ShareWrapper ShareWrapper::BmrToBooleanGmw() const {
   auto bmr_share = std::dynamic_pointer_cast<proto::bmr::Share>(share_);
   assert(bmr_share);
-  auto bmr_to_boolean_gmw_gate = std::make_shared<BmrToBooleanGmwGate>(bmr_share);
+  auto bmr_to_boolean_gmw_gate = share_->GetRegister()->MakeShared<BmrToBooleanGmwGate>(bmr_share);
   share_->GetRegister()->RegisterNextGate(bmr_to_boolean_gmw_gate);
   return ShareWrapper(bmr_to_boolean_gmw_gate->GetOutputAsShare());
 }
@@ -520,7 +791,20 @@ ShareWrapper ShareWrapper::Concatenate(std::span<const ShareWrapper> input) {
   }
 }
 
-ShareWrapper ShareWrapper::Evaluate(const AlgorithmDescription& algorithm) const {
+ShareWrapper ShareWrapper::Evaluate(const AlgorithmDescription& algorithm,
+                                    CircuitEvaluationMode mode) const {
+  switch (mode) {
+    case CircuitEvaluationMode::kGateByGate:
+      return EvaluateGateByGate(algorithm);
+    case CircuitEvaluationMode::kLayerBatched:
+      return Evaluate(LayeredCircuit::FromAlgorithmDescription(algorithm));
+    default:
+      throw std::invalid_argument(
+          fmt::format("Invalid CircuitEvaluationMode with id {}", static_cast<uint>(mode)));
+  }
+}
+
+ShareWrapper ShareWrapper::EvaluateGateByGate(const AlgorithmDescription& algorithm) const {
   std::size_t number_of_input_wires = algorithm.number_of_input_wires_parent_a;
   if (algorithm.number_of_input_wires_parent_b)
     number_of_input_wires += *algorithm.number_of_input_wires_parent_b;
@@ -588,6 +872,84 @@ ShareWrapper ShareWrapper::Evaluate(const AlgorithmDescription& algorithm) const
   return ShareWrapper::Concatenate(output);
 }
 
+ShareWrapper ShareWrapper::Evaluate(const LayeredCircuit& circuit) const {
+  if (circuit.number_of_input_wires != share_->GetBitLength()) {
+    share_->GetRegister()->GetLogger()->LogError(fmt::format(
+        "ShareWrapper::Evaluate: expected a share of bit length {}, got a share of bit length {}",
+        circuit.number_of_input_wires, share_->GetBitLength()));
+  }
+
+  std::vector<ShareWrapper> wires(circuit.number_of_wires);
+  {
+    auto share_split_in_wires{Split()};
+    assert(share_split_in_wires.size() <= wires.size());
+    std::move(share_split_in_wires.begin(), share_split_in_wires.end(), wires.begin());
+  }
+
+  std::vector<ShareWrapper> a, b;
+  for (std::size_t batch_i = 0; batch_i < circuit.GetNumberOfBatches(); ++batch_i) {
+    const auto batch_begin{circuit.batch_offsets[batch_i]};
+    const auto batch_end{circuit.batch_offsets[batch_i + 1]};
+    const auto batch_type{circuit.types[batch_begin]};
+    a.clear();
+    b.clear();
+    for (auto gate_i = batch_begin; gate_i < batch_end; ++gate_i) {
+      a.emplace_back(wires[circuit.parents_a[gate_i]]);
+      if (batch_type != PrimitiveOperationType::kInv) {
+        b.emplace_back(wires[circuit.parents_b[gate_i]]);
+      }
+    }
+
+    std::vector<ShareWrapper> result;
+    if (circuit.IsInteractiveBatch(batch_i)) {
+      // OR operations are equal to NOT ( ( NOT a ) AND ( NOT b ) ), so the parents of all OR gates
+      // in this batch are inverted at once and evaluated in the same AND gate as the AND gates
+      const auto or_begin{static_cast<std::size_t>(
+          std::find(circuit.types.begin() + batch_begin, circuit.types.begin() + batch_end,
+                    PrimitiveOperationType::kOr) -
+          circuit.types.begin())};
+      const auto number_of_and_gates{or_begin - batch_begin};
+      const auto number_of_or_gates{batch_end - or_begin};
+      if (number_of_or_gates > 0) {
+        std::vector<ShareWrapper> or_parents(a.begin() + number_of_and_gates, a.end());
+        or_parents.insert(or_parents.end(), b.begin() + number_of_and_gates, b.end());
+        const auto inverted_parents{(~Concatenate(or_parents)).Split()};
+        std::copy_n(inverted_parents.begin(), number_of_or_gates, a.begin() + number_of_and_gates);
+        std::copy_n(inverted_parents.begin() + number_of_or_gates, number_of_or_gates,
+                    b.begin() + number_of_and_gates);
+      }
+      result = (Concatenate(a) & Concatenate(b)).Split();
+      if (number_of_or_gates > 0) {
+        const auto inverted_result{
+            (~Concatenate(result.cbegin() + number_of_and_gates, result.cend())).Split()};
+        std::copy(inverted_result.begin(), inverted_result.end(),
+                  result.begin() + number_of_and_gates);
+      }
+    } else if (batch_type == PrimitiveOperationType::kXor) {
+      result = (Concatenate(a) ^ Concatenate(b)).Split();
+    } else {
+      assert(batch_type == PrimitiveOperationType::kInv);
+      result = (~Concatenate(a)).Split();
+    }
+
+    assert(result.size() == batch_end - batch_begin);
+    for (auto gate_i = batch_begin; gate_i < batch_end; ++gate_i) {
+      wires[circuit.output_wires[gate_i]] = std::move(result[gate_i - batch_begin]);
+    }
+    // release the wires that are not read by later batches
+    for (auto gate_i = batch_begin; gate_i < batch_end; ++gate_i) {
+      if (circuit.last_use[circuit.parents_a[gate_i]] == batch_i) {
+        wires[circuit.parents_a[gate_i]] = ShareWrapper();
+      }
+      if (circuit.last_use[circuit.parents_b[gate_i]] == batch_i) {
+        wires[circuit.parents_b[gate_i]] = ShareWrapper();
+      }
+    }
+  }
+
+  return ShareWrapper::Concatenate(wires.end() - circuit.number_of_output_wires, wires.end());
+}
+
 void ShareWrapper::ShareConsistencyCheck() const {
   if (share_->GetWires().size() == 0) {
     throw std::invalid_argument("ShareWrapper::share_ has 0 wires");
@@ -745,7 +1107,8 @@ ShareWrapper ShareWrapper::Add(SharePointer share, SharePointer other) const {
     auto other_wire_a = other_a->GetArithmeticWire();
 
     auto addition_gate =
-        std::make_shared<proto::arithmetic_gmw::AdditionGate<T>>(this_wire_a, other_wire_a);
+        share_->GetRegister()->MakeShared<proto::arithmetic_gmw::AdditionGate<T>>(this_wire_a,
+                                                                                  other_wire_a);
     auto addition_gate_cast = std::static_pointer_cast<Gate>(addition_gate);
     share_->GetRegister()->RegisterNextGate(addition_gate_cast);
     auto result = std::static_pointer_cast<Share>(addition_gate->GetOutputAsArithmeticShare());
@@ -766,8 +1129,9 @@ ShareWrapper ShareWrapper::Add(SharePointer share, SharePointer other) const {
         non_constant_wire_original->GetWires()[0]);
     assert(non_constant_wire);
 
-    auto addition_gate = std::make_shared<proto::ConstantArithmeticAdditionGate<T>>(
-        non_constant_wire, constant_wire);
+    auto addition_gate =
+        share_->GetRegister()->MakeShared<proto::ConstantArithmeticAdditionGate<T>>(
+            non_constant_wire, constant_wire);
     share_->GetRegister()->RegisterNextGate(addition_gate);
     auto result = std::static_pointer_cast<Share>(addition_gate->GetOutputAsArithmeticShare());
 
@@ -794,7 +1158,8 @@ ShareWrapper ShareWrapper::Sub(SharePointer share, SharePointer other) const {
   auto other_wire_a = other_a->GetArithmeticWire();
 
   auto subtraction_gate =
-      std::make_shared<proto::arithmetic_gmw::SubtractionGate<T>>(this_wire_a, other_wire_a);
+      share_->GetRegister()->MakeShared<proto::arithmetic_gmw::SubtractionGate<T>>(this_wire_a,
+                                                                                   other_wire_a);
   auto addition_gate_cast = std::static_pointer_cast<Gate>(subtraction_gate);
   share_->GetRegister()->RegisterNextGate(addition_gate_cast);
   auto result = std::static_pointer_cast<Share>(subtraction_gate->GetOutputAsArithmeticShare());
@@ -822,7 +1187,8 @@ ShareWrapper ShareWrapper::Mul(SharePointer share, SharePointer other) const {
     auto other_wire_a = other_a->GetArithmeticWire();
 
     auto multiplication_gate =
-        std::make_shared<proto::arithmetic_gmw::MultiplicationGate<T>>(this_wire_a, other_wire_a);
+        share_->GetRegister()->MakeShared<proto::arithmetic_gmw::MultiplicationGate<T>>(
+            this_wire_a, other_wire_a);
     share_->GetRegister()->RegisterNextGate(multiplication_gate);
     auto result =
         std::static_pointer_cast<Share>(multiplication_gate->GetOutputAsArithmeticShare());
@@ -843,8 +1209,9 @@ ShareWrapper ShareWrapper::Mul(SharePointer share, SharePointer other) const {
         non_constant_wire_original->GetWires()[0]);
     assert(non_constant_wire);
 
-    auto multiplication_gate = std::make_shared<proto::ConstantArithmeticMultiplicationGate<T>>(
-        non_constant_wire, constant_wire);
+    auto multiplication_gate =
+        share_->GetRegister()->MakeShared<proto::ConstantArithmeticMultiplicationGate<T>>(
+            non_constant_wire, constant_wire);
     share_->GetRegister()->RegisterNextGate(multiplication_gate);
     auto result =
         std::static_pointer_cast<Share>(multiplication_gate->GetOutputAsArithmeticShare());
@@ -859,7 +1226,8 @@ ShareWrapper ShareWrapper::Square(SharePointer share) const {
   assert(this_a);
   auto this_wire_a = this_a->GetArithmeticWire();
 
-  auto square_gate = std::make_shared<proto::arithmetic_gmw::SquareGate<T>>(this_wire_a);
+  auto square_gate =
+      share_->GetRegister()->MakeShared<proto::arithmetic_gmw::SquareGate<T>>(this_wire_a);
   auto square_gate_cast = std::static_pointer_cast<Gate>(square_gate);
   share_->GetRegister()->RegisterNextGate(square_gate_cast);
   auto result = std::static_pointer_cast<Share>(square_gate->GetOutputAsArithmeticShare());
@@ -867,6 +1235,21 @@ ShareWrapper ShareWrapper::Square(SharePointer share) const {
   return ShareWrapper(result);
 }
 
+template <typename T>
+ShareWrapper ShareWrapper::Truncate(SharePointer share, std::size_t fractional_bits) const {
+  auto this_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(share);
+  assert(this_a);
+  auto this_wire_a = this_a->GetArithmeticWire();
+
+  auto truncation_gate =
+      share_->GetRegister()->MakeShared<proto::arithmetic_gmw::TruncationGate<T>>(
+          this_wire_a, fractional_bits);
+  share_->GetRegister()->RegisterNextGate(truncation_gate);
+  auto result = std::static_pointer_cast<Share>(truncation_gate->GetOutputAsArithmeticShare());
+
+  return ShareWrapper(result);
+}
+
 template ShareWrapper ShareWrapper::Mul<std::uint8_t>(SharePointer share, SharePointer other) const;
 template ShareWrapper ShareWrapper::Mul<std::uint16_t>(SharePointer share,
                                                        SharePointer other) const;
@@ -875,19 +1258,53 @@ template ShareWrapper ShareWrapper::Mul<std::uint32_t>(SharePointer share,
 template ShareWrapper ShareWrapper::Mul<std::uint64_t>(SharePointer share,
                                                        SharePointer other) const;
 
+template <typename T>
+ShareWrapper ShareWrapper::MatMul(SharePointer share, SharePointer other, std::size_t rows,
+                                  std::size_t inner, std::size_t columns) const {
+  if (share->IsConstant() || other->IsConstant()) {
+    throw std::runtime_error("Matrix multiplication is not supported for constant shares");
+  }
+  auto this_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(share);
+  assert(this_a);
+  auto other_a = std::dynamic_pointer_cast<proto::arithmetic_gmw::Share<T>>(other);
+  assert(other_a);
+
+  auto matrix_multiplication_gate =
+      share_->GetRegister()->MakeShared<proto::arithmetic_gmw::MatrixMultiplicationGate<T>>(
+          this_a->GetArithmeticWire(), other_a->GetArithmeticWire(), rows, inner, columns);
+  share_->GetRegister()->RegisterNextGate(matrix_multiplication_gate);
+  auto result =
+      std::static_pointer_cast<Share>(matrix_multiplication_gate->GetOutputAsArithmeticShare());
+
+  return ShareWrapper(result);
+}
+
+template ShareWrapper ShareWrapper::MatMul<std::uint8_t>(SharePointer share, SharePointer other,
+                                                         std::size_t rows, std::size_t inner,
+                                                         std::size_t columns) const;
+template ShareWrapper ShareWrapper::MatMul<std::uint16_t>(SharePointer share, SharePointer other,
+                                                          std::size_t rows, std::size_t inner,
+                                                          std::size_t columns) const;
+template ShareWrapper ShareWrapper::MatMul<std::uint32_t>(SharePointer share, SharePointer other,
+                                                          std::size_t rows, std::size_t inner,
+                                                          std::size_t columns) const;
+template ShareWrapper ShareWrapper::MatMul<std::uint64_t>(SharePointer share, SharePointer other,
+                                                          std::size_t rows, std::size_t inner,
+                                                          std::size_t columns) const;
+
 ShareWrapper ShareWrapper::Subset(std::vector<std::size_t>&& positions) {
   return Subset(std::span<const std::size_t>(positions));
 }
 
 ShareWrapper ShareWrapper::Subset(std::span<const std::size_t> positions) {
-  auto subset_gate = std::make_shared<SubsetGate>(share_, positions);
+  auto subset_gate = share_->GetRegister()->MakeShared<SubsetGate>(share_, positions);
   auto subset_gate_cast = std::static_pointer_cast<Gate>(subset_gate);
   share_->GetRegister()->RegisterNextGate(subset_gate_cast);
   return ShareWrapper(subset_gate->GetOutputAsShare());
 }
 
 std::vector<ShareWrapper> ShareWrapper::Unsimdify() {
-  auto unsimdify_gate = std::make_shared<UnsimdifyGate>(share_);
+  auto unsimdify_gate = share_->GetRegister()->MakeShared<UnsimdifyGate>(share_);
   auto unsimdify_gate_cast = std::static_pointer_cast<Gate>(unsimdify_gate);
   share_->GetRegister()->RegisterNextGate(unsimdify_gate_cast);
   std::vector<SharePointer> shares{unsimdify_gate->GetOutputAsVectorOfShares()};
@@ -906,7 +1323,7 @@ ShareWrapper ShareWrapper::Simdify(std::span<const ShareWrapper> input) {
 
 ShareWrapper ShareWrapper::Simdify(std::span<SharePointer> input) {
   if (input.empty()) throw std::invalid_argument("Empty inputs in ShareWrapper::Simdify");
-  auto simdify_gate = std::make_shared<SimdifyGate>(input);
+  auto simdify_gate = input[0]->GetRegister()->MakeShared<SimdifyGate>(input);
   auto simdify_gate_cast = std::static_pointer_cast<Gate>(simdify_gate);
   input[0]->GetRegister()->RegisterNextGate(simdify_gate_cast);
   return simdify_gate->GetOutputAsShare();
@@ -28,6 +28,7 @@
 #include <limits>
 #include <memory>
 #include <span>
+#include <utility>
 #include <vector>
 
 #include "share.h"
@@ -37,6 +38,7 @@
 namespace encrypto::motion {
 
 struct AlgorithmDescription;
+struct LayeredCircuit;
 
 class Share;
 using SharePointer = std::shared_ptr<Share>;
@@ -95,12 +97,43 @@ class ShareWrapper {
     return *this;
   }
 
+  /// \brief compares bit strings for Boolean shares and values for arithmetic GMW shares.
+  /// \returns a Boolean share with a single bit, which is a Boolean GMW share for arithmetic GMW.
   ShareWrapper operator==(const ShareWrapper& other) const;
 
+  /// \brief decomposes an arithmetic GMW share into Boolean GMW shares of its bits, least
+  /// significant bit first, with one opening and a log-depth prefix adder.
+  ShareWrapper BitDecomposition() const;
+
+  /// \brief computes the most significant bit of an arithmetic GMW share, i.e., whether it is
+  /// negative in the two's complement, as a Boolean GMW share.
+  ShareWrapper LessThanZero() const;
+
+  /// \brief truncates an arithmetic GMW share of a fixed-point value, interpreted as signed number
+  /// in [-2^(l-2), 2^(l-2)), by \p fractional_bits bits with one opening of a masked value.  The
+  /// result is probabilistic and may be one larger than the exact arithmetic shift.
+  /// \throws std::invalid_argument if \p fractional_bits is larger than the bit length minus 2
+  ShareWrapper Truncate(std::size_t fractional_bits) const;
+
+  /// \brief tests whether an arithmetic GMW share is zero with one opening and an AND tree.
+  /// \returns a Boolean GMW share with a single bit.
+  ShareWrapper EqualityToZero() const;
+
   // use this as the selection bit
   // returns this ? a : b
   ShareWrapper Mux(const ShareWrapper& a, const ShareWrapper& b) const;
 
+  /// \brief multiplies this row-major \p rows x \p inner matrix by the row-major \p inner x
+  /// \p columns matrix \p other, which only opens (rows + columns) * inner masked values.
+  /// Both shares need to be arithmetic GMW shares of the same bit length.
+  /// \throws std::invalid_argument if the numbers of SIMD values do not match the dimensions
+  ShareWrapper MatMul(const ShareWrapper& other, std::size_t rows, std::size_t inner,
+                      std::size_t columns) const;
+
+  /// \brief computes the inner product of the SIMD values of this and \p other, i.e., a 1 x n by
+  /// n x 1 matrix multiplication.
+  ShareWrapper DotProduct(const ShareWrapper& other) const;
+
   template <MpcProtocol P>
   ShareWrapper Convert() const;
 
@@ -141,13 +174,32 @@ class ShareWrapper {
 
   /// \brief evaluates AlgorithmDescription also on this->share_ as input.
   /// \returns the output share of the evaluated circuit as ShareWrapper.
-  ShareWrapper Evaluate(const std::shared_ptr<const AlgorithmDescription>& algo) const {
-    return Evaluate(*algo);
+  ShareWrapper Evaluate(
+      const std::shared_ptr<const AlgorithmDescription>& algo,
+      CircuitEvaluationMode mode = CircuitEvaluationMode::kLayerBatched) const {
+    return Evaluate(*algo, mode);
   }
 
   /// \brief constructs a circuit from AlgorithmDescription algo and sets this->share_ as input.
+  /// In CircuitEvaluationMode::kLayerBatched, the gates of algo are sorted into layers by their
+  /// AND depth and all AND/OR, XOR, and INV gates of a layer are constructed as one multi-wire gate
+  /// each, i.e., each layer of AND gates is opened with a single round of messages.
+  /// CircuitEvaluationMode::kGateByGate constructs a separate gate for each gate in algo.
+  /// \returns a share over the output wires of the constructed circuit.
+  /// \throws invalid_argument if mode is invalid.
+  ShareWrapper Evaluate(const AlgorithmDescription& algo,
+                        CircuitEvaluationMode mode = CircuitEvaluationMode::kLayerBatched) const;
+
+  /// \brief evaluates LayeredCircuit also on this->share_ as input.
+  /// \returns the output share of the evaluated circuit as ShareWrapper.
+  ShareWrapper Evaluate(const std::shared_ptr<const LayeredCircuit>& circuit) const {
+    return Evaluate(*circuit);
+  }
+
+  /// \brief constructs a circuit from the preprocessed LayeredCircuit circuit with one multi-wire
+  /// gate per batch in circuit and sets this->share_ as input.
   /// \returns a share over the output wires of the constructed circuit.
-  ShareWrapper Evaluate(const AlgorithmDescription& algo) const;
+  ShareWrapper Evaluate(const LayeredCircuit& circuit) const;
 
   /// \brief constructs a SubsetGate that returns values stored at positions in this->share_.
   /// Internally calls ShareWrapper Subset(std::span<std::size_t> positions).
@@ -213,14 +265,31 @@ class ShareWrapper {
   template <typename T>
   ShareWrapper Square(SharePointer share) const;
 
+  template <typename T>
+  ShareWrapper Truncate(SharePointer share, std::size_t fractional_bits) const;
+
+  template <typename T>
+  ShareWrapper MatMul(SharePointer share, SharePointer other, std::size_t rows, std::size_t inner,
+                      std::size_t columns) const;
+
   ShareWrapper ArithmeticGmwToBmr() const;
 
+  /// \brief converts with an edaBit r by adding the opened c = x - r to the Boolean shares of r.
+  /// The carries of the addition are computed by a Kogge-Stone adder in log2(l) AND layers.
+  ShareWrapper ArithmeticGmwToBooleanGmw() const;
+
+  // opens x - r for an edaBit r and returns the Boolean GMW generate and propagate bits of the
+  // addition of the opened value and r
+  std::pair<std::vector<ShareWrapper>, std::vector<ShareWrapper>> GenerateAndPropagate() const;
+
   ShareWrapper BooleanGmwToArithmeticGmw() const;
 
   ShareWrapper BooleanGmwToBmr() const;
 
   ShareWrapper BmrToBooleanGmw() const;
 
+  ShareWrapper EvaluateGateByGate(const AlgorithmDescription& algo) const;
+
   void ShareConsistencyCheck() const;
 };
 
@@ -68,6 +68,13 @@ void Wire::SetOnlineFinished() {
 
 const std::atomic<bool>& Wire::IsReady() const noexcept { return is_done_; }
 
+void Wire::ReleaseConsumer() {
+  // waiting_gate_ids_ does not change anymore once the gates are evaluated
+  if (++number_of_finished_consumers_ == waiting_gate_ids_.size()) {
+    ReleaseValues();
+  }
+}
+
 std::string Wire::PrintIds(const std::vector<std::shared_ptr<Wire>>& wires) {
   std::string result;
   for (auto& w : wires) {
@@ -72,9 +72,28 @@ class Wire {
 
   void Clear() {
     is_done_ = false;
+    number_of_finished_consumers_ = 0;
     DynamicClear();
   }
 
+  /// \brief Signals that a gate waiting for this wire finished its online phase. Once all waiting
+  /// gates finished, the values of this wire are released unless it is pinned.
+  /// The released values are not restored by Clear(), i.e., they are lost for repeated evaluations.
+  void ReleaseConsumer();
+
+  /// \brief Releases the values of a wire which no gate waits for, e.g., an opening inside a gate,
+  /// unless it is pinned.
+  void ReleaseValues() {
+    if (!is_pinned_) {
+      DynamicReleaseValues();
+    }
+  }
+
+  /// \brief Keeps the values of this wire after all waiting gates finished, e.g., for outputs.
+  void Pin() { is_pinned_ = true; }
+
+  bool IsPinned() const noexcept { return is_pinned_; }
+
   virtual bool IsConstant() const noexcept = 0;
 
   Wire(const Wire&) = delete;
@@ -95,12 +114,19 @@ class Wire {
 
   std::unordered_set<std::size_t> waiting_gate_ids_;
 
+  std::atomic<std::size_t> number_of_finished_consumers_ = 0;
+
+  std::atomic<bool> is_pinned_ = false;
+
   Wire(Backend& backend, std::size_t number_of_simd);
 
   static void SignalReadyToDependency(std::size_t gate_id, Backend& backend);
 
   virtual void DynamicClear(){};
 
+  // frees the memory of the values, which must not be read afterwards
+  virtual void DynamicReleaseValues(){};
+
  private:
   void InitializationHelper();
 
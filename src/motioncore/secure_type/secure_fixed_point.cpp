@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "secure_fixed_point.h"
+
+#include <fmt/format.h>
+
+#include "base/register.h"
+#include "utility/logger.h"
+
+namespace encrypto::motion {
+
+SecureFixedPoint::SecureFixedPoint(const SharePointer& other, std::size_t fractional_bits)
+    : share_(std::make_shared<ShareWrapper>(other)),
+      logger_(share_.get()->Get()->GetRegister()->GetLogger()),
+      fractional_bits_(fractional_bits) {
+  if (other->GetProtocol() != MpcProtocol::kArithmeticGmw) {
+    throw std::invalid_argument("SecureFixedPoint is only implemented for arithmetic GMW shares");
+  }
+  if (fractional_bits_ + 2 > other->GetBitLength()) {
+    throw std::invalid_argument(fmt::format("{} fractional bits do not fit into {}-bit shares",
+                                            fractional_bits_, other->GetBitLength()));
+  }
+}
+
+SecureFixedPoint::SecureFixedPoint(SharePointer&& other, std::size_t fractional_bits)
+    : SecureFixedPoint(static_cast<const SharePointer&>(other), fractional_bits) {
+  other.reset();
+}
+
+SecureFixedPoint SecureFixedPoint::operator+(const SecureFixedPoint& other) const {
+  CheckFractionalBits(other);
+  return SecureFixedPoint(*share_ + *other.share_, fractional_bits_);
+}
+
+SecureFixedPoint SecureFixedPoint::operator-(const SecureFixedPoint& other) const {
+  CheckFractionalBits(other);
+  return SecureFixedPoint(*share_ - *other.share_, fractional_bits_);
+}
+
+SecureFixedPoint SecureFixedPoint::operator*(const SecureFixedPoint& other) const {
+  CheckFractionalBits(other);
+  // the product has 2f fractional bits
+  return SecureFixedPoint((*share_ * *other.share_).Truncate(fractional_bits_), fractional_bits_);
+}
+
+ShareWrapper SecureFixedPoint::operator>(const SecureFixedPoint& other) const {
+  CheckFractionalBits(other);
+  return (*other.share_ - *share_).LessThanZero();
+}
+
+ShareWrapper SecureFixedPoint::operator==(const SecureFixedPoint& other) const {
+  CheckFractionalBits(other);
+  return *share_ == *other.share_;
+}
+
+void SecureFixedPoint::CheckFractionalBits(const SecureFixedPoint& other) const {
+  if (fractional_bits_ != other.fractional_bits_) {
+    throw std::invalid_argument(
+        fmt::format("Fixed-point numbers with {} and {} fractional bits are not compatible",
+                    fractional_bits_, other.fractional_bits_));
+  }
+}
+
+}  // namespace encrypto::motion
@@ -0,0 +1,148 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "protocols/share_wrapper.h"
+
+namespace encrypto::motion {
+
+class Logger;
+
+/// \brief Signed fixed-point numbers on arithmetic GMW shares, where x is represented by
+/// round(x * 2^f) in the two's complement for f fractional bits.
+///
+/// Additions and subtractions are local.  Multiplications truncate the product by f bits using
+/// ShareWrapper::Truncate, which opens one masked value and may be off by one in the last bit.
+/// The product of two values needs to lie in [-2^(l-2-f), 2^(l-2-f)) for bit length l.
+class SecureFixedPoint {
+ public:
+  static constexpr std::size_t kDefaultFractionalBits{16};
+
+  SecureFixedPoint() = default;
+
+  SecureFixedPoint(const SecureFixedPoint& other)
+      : SecureFixedPoint(*other.share_, other.fractional_bits_) {}
+
+  SecureFixedPoint(SecureFixedPoint&& other)
+      : SecureFixedPoint(std::move(*other.share_), other.fractional_bits_) {
+    other.share_->Get().reset();
+  }
+
+  SecureFixedPoint(const ShareWrapper& other,
+                   std::size_t fractional_bits = kDefaultFractionalBits)
+      : SecureFixedPoint(*other, fractional_bits) {}
+
+  SecureFixedPoint(ShareWrapper&& other, std::size_t fractional_bits = kDefaultFractionalBits)
+      : SecureFixedPoint(std::move(*other), fractional_bits) {
+    other.Get().reset();
+  }
+
+  /// \throws std::invalid_argument if \p other is not an arithmetic GMW share or has less than
+  /// fractional_bits + 2 bits
+  SecureFixedPoint(const SharePointer& other, std::size_t fractional_bits = kDefaultFractionalBits);
+
+  SecureFixedPoint(SharePointer&& other, std::size_t fractional_bits = kDefaultFractionalBits);
+
+  SecureFixedPoint& operator=(const SecureFixedPoint& other) {
+    this->share_ = other.share_;
+    this->logger_ = other.logger_;
+    this->fractional_bits_ = other.fractional_bits_;
+    return *this;
+  }
+
+  SecureFixedPoint& operator=(SecureFixedPoint&& other) {
+    this->share_ = std::move(other.share_);
+    this->logger_ = std::move(other.logger_);
+    this->fractional_bits_ = other.fractional_bits_;
+    return *this;
+  }
+
+  ShareWrapper& Get() { return *share_; }
+
+  const ShareWrapper& Get() const { return *share_; }
+
+  ShareWrapper& operator->() { return *share_; }
+
+  const ShareWrapper& operator->() const { return *share_; }
+
+  std::size_t GetFractionalBits() const { return fractional_bits_; }
+
+  SecureFixedPoint operator+(const SecureFixedPoint& other) const;
+
+  SecureFixedPoint& operator+=(const SecureFixedPoint& other) {
+    *this = *this + other;
+    return *this;
+  }
+
+  SecureFixedPoint operator-(const SecureFixedPoint& other) const;
+
+  SecureFixedPoint& operator-=(const SecureFixedPoint& other) {
+    *this = *this - other;
+    return *this;
+  }
+
+  SecureFixedPoint operator*(const SecureFixedPoint& other) const;
+
+  SecureFixedPoint& operator*=(const SecureFixedPoint& other) {
+    *this = *this * other;
+    return *this;
+  }
+
+  /// \brief compares the signed values via the most significant bit of other - this.
+  /// \pre both values lie in [-2^(l-2), 2^(l-2)) for bit length l, as required for
+  /// multiplications, such that other - this does not overflow.
+  /// \returns a Boolean GMW share with a single bit
+  ShareWrapper operator>(const SecureFixedPoint& other) const;
+
+  /// \returns a Boolean GMW share with a single bit
+  ShareWrapper operator==(const SecureFixedPoint& other) const;
+
+  /// \brief encodes \p value as fixed-point number with \p fractional_bits fractional bits.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  static T Encode(double value, std::size_t fractional_bits = kDefaultFractionalBits) {
+    const auto scaled{std::llround(std::ldexp(value, static_cast<int>(fractional_bits)))};
+    return static_cast<T>(static_cast<std::make_signed_t<T>>(scaled));
+  }
+
+  /// \brief decodes the fixed-point number \p value with \p fractional_bits fractional bits.
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  static double Decode(T value, std::size_t fractional_bits = kDefaultFractionalBits) {
+    return std::ldexp(static_cast<double>(static_cast<std::make_signed_t<T>>(value)),
+                      -static_cast<int>(fractional_bits));
+  }
+
+ private:
+  std::shared_ptr<ShareWrapper> share_{nullptr};
+  std::shared_ptr<Logger> logger_{nullptr};
+  std::size_t fractional_bits_{kDefaultFractionalBits};
+
+  // throws std::invalid_argument if the numbers of fractional bits differ
+  void CheckFractionalBits(const SecureFixedPoint& other) const;
+};
+
+}  // namespace encrypto::motion
@@ -24,9 +24,12 @@
 
 #include "secure_unsigned_integer.h"
 
+#include <numeric>
+
 #include <fmt/format.h>
 
-#include "algorithm/algorithm_description.h"
+#include "algorithm/circuit_loader.h"
+#include "algorithm/layered_circuit.h"
 #include "base/register.h"
 #include "utility/constants.h"
 #include "utility/logger.h"
@@ -47,7 +50,6 @@ SecureUnsignedInteger SecureUnsignedInteger::operator+(const SecureUnsignedInteg
     return *share_ + *other.share_;
   } else {  // BooleanCircuitType
     const auto bitlength = share_->Get()->GetBitLength();
-    std::shared_ptr<AlgorithmDescription> addition_algorithm;
     std::string path;
 
     if (share_->Get()->GetProtocol() == MpcProtocol::kBmr)  // BMR, use size-optimized circuit
@@ -55,18 +57,9 @@ SecureUnsignedInteger SecureUnsignedInteger::operator+(const SecureUnsignedInteg
     else  // GMW, use depth-optimized circuit
       path = ConstructPath(IntegerOperationType::kAdd, bitlength, "_depth");
 
-    if ((addition_algorithm = share_->Get()->GetRegister()->GetCachedAlgorithmDescription(path))) {
-      if constexpr (kDebug) {
-        logger_->LogDebug(
-            fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
-      }
-    } else {
-      addition_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
-      assert(addition_algorithm);
-      if constexpr (kDebug) {
-        logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
-      }
+    const auto addition_algorithm{CircuitLoader::GetInstance().GetLayeredCircuit(path)};
+    if constexpr (kDebug) {
+      logger_->LogDebug(fmt::format("Using Boolean integer addition circuit from file {}", path));
     }
     const auto share_input{ShareWrapper::Concatenate(std::vector{*share_, *other.share_})};
     return SecureUnsignedInteger(share_input.Evaluate(addition_algorithm));
@@ -79,7 +72,6 @@ SecureUnsignedInteger SecureUnsignedInteger::operator-(const SecureUnsignedInteg
     return *share_ - *other.share_;
   } else {  // BooleanCircuitType
     const auto bitlength = share_->Get()->GetBitLength();
-    std::shared_ptr<AlgorithmDescription> subtraction_algorithm;
     std::string path;
 
     if (share_->Get()->GetProtocol() == MpcProtocol::kBmr)  // BMR, use size-optimized circuit
@@ -87,19 +79,9 @@ SecureUnsignedInteger SecureUnsignedInteger::operator-(const SecureUnsignedInteg
     else  // GMW, use depth-optimized circuit
       path = ConstructPath(IntegerOperationType::kSub, bitlength, "_depth");
 
-    if ((subtraction_algorithm =
-             share_->Get()->GetRegister()->GetCachedAlgorithmDescription(path))) {
-      if constexpr (kDebug) {
-        logger_->LogDebug(
-            fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
-      }
-    } else {
-      subtraction_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
-      assert(subtraction_algorithm);
-      if constexpr (kDebug) {
-        logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
-      }
+    const auto subtraction_algorithm{CircuitLoader::GetInstance().GetLayeredCircuit(path)};
+    if constexpr (kDebug) {
+      logger_->LogDebug(fmt::format("Using Boolean integer subtraction circuit from file {}", path));
     }
     const auto share_input{ShareWrapper::Concatenate(std::vector{*share_, *other.share_})};
     return SecureUnsignedInteger(share_input.Evaluate(subtraction_algorithm));
@@ -112,7 +94,6 @@ SecureUnsignedInteger SecureUnsignedInteger::operator*(const SecureUnsignedInteg
     return *share_ * *other.share_;
   } else {  // BooleanCircuitType
     const auto bitlength = share_->Get()->GetBitLength();
-    std::shared_ptr<AlgorithmDescription> multiplication_algorithm;
     std::string path;
 
     if (share_->Get()->GetProtocol() == MpcProtocol::kBmr)  // BMR, use size-optimized circuit
@@ -120,19 +101,9 @@ SecureUnsignedInteger SecureUnsignedInteger::operator*(const SecureUnsignedInteg
     else  // GMW, use depth-optimized circuit
       path = ConstructPath(IntegerOperationType::kMul, bitlength, "_depth");
 
-    if ((multiplication_algorithm =
-             share_->Get()->GetRegister()->GetCachedAlgorithmDescription(path))) {
-      if constexpr (kDebug) {
-        logger_->LogDebug(
-            fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
-      }
-    } else {
-      multiplication_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
-      assert(multiplication_algorithm);
-      if constexpr (kDebug) {
-        logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
-      }
+    const auto multiplication_algorithm{CircuitLoader::GetInstance().GetLayeredCircuit(path)};
+    if constexpr (kDebug) {
+      logger_->LogDebug(fmt::format("Using Boolean integer multiplication circuit from file {}", path));
     }
     const auto share_input{ShareWrapper::Concatenate(std::vector{*share_, *other.share_})};
     return SecureUnsignedInteger(share_input.Evaluate(multiplication_algorithm));
@@ -145,7 +116,6 @@ SecureUnsignedInteger SecureUnsignedInteger::operator/(const SecureUnsignedInteg
     throw std::runtime_error("Integer division is not implemented for arithmetic GMW");
   } else {  // BooleanCircuitType
     const auto bitlength = share_->Get()->GetBitLength();
-    std::shared_ptr<AlgorithmDescription> division_algorithm;
     std::string path;
 
     if (share_->Get()->GetProtocol() == MpcProtocol::kBmr)  // BMR, use size-optimized circuit
@@ -153,18 +123,9 @@ SecureUnsignedInteger SecureUnsignedInteger::operator/(const SecureUnsignedInteg
     else  // GMW, use depth-optimized circuit
       path = ConstructPath(IntegerOperationType::kDiv, bitlength, "_depth");
 
-    if ((division_algorithm = share_->Get()->GetRegister()->GetCachedAlgorithmDescription(path))) {
-      if constexpr (kDebug) {
-        logger_->LogDebug(
-            fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
-      }
-    } else {
-      division_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
-      assert(division_algorithm);
-      if constexpr (kDebug) {
-        logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
-      }
+    const auto division_algorithm{CircuitLoader::GetInstance().GetLayeredCircuit(path)};
+    if constexpr (kDebug) {
+      logger_->LogDebug(fmt::format("Using Boolean integer division circuit from file {}", path));
     }
     const auto share_input{ShareWrapper::Concatenate(std::vector{*share_, *other.share_})};
     return SecureUnsignedInteger(share_input.Evaluate(division_algorithm));
@@ -173,11 +134,21 @@ SecureUnsignedInteger SecureUnsignedInteger::operator/(const SecureUnsignedInteg
 
 ShareWrapper SecureUnsignedInteger::operator>(const SecureUnsignedInteger& other) const {
   if (share_->Get()->GetCircuitType() != CircuitType::kBoolean) {
-    // use primitive operation in arithmetic GMW
-    throw std::runtime_error("Integer comparison is not implemented for arithmetic GMW");
+    // x > y iff the most significant bits a of x and b of y differ and a is set, or they are
+    // equal and y - x is negative in the two's complement, i.e., its most significant bit d is set
+    const auto number_of_simd{share_->Get()->GetNumberOfSimdValues()};
+    auto most_significant_bits{
+        ShareWrapper::Simdify(std::vector{*share_, *other.share_, *other.share_ - *share_})
+            .LessThanZero()};
+    const auto subset = [&most_significant_bits, number_of_simd](std::size_t i) {
+      std::vector<std::size_t> positions(number_of_simd);
+      std::iota(positions.begin(), positions.end(), i * number_of_simd);
+      return most_significant_bits.Subset(std::move(positions));
+    };
+    const auto a{subset(0)}, b{subset(1)}, d{subset(2)};
+    return d ^ ((a ^ b) & (a ^ d));
   } else {  // BooleanCircuitType
     const auto bitlength = share_->Get()->GetBitLength();
-    std::shared_ptr<AlgorithmDescription> is_greater_algorithm;
     std::string path;
 
     if (share_->Get()->GetProtocol() == MpcProtocol::kBmr)  // BMR, use size-optimized circuit
@@ -185,19 +156,9 @@ ShareWrapper SecureUnsignedInteger::operator>(const SecureUnsignedInteger& other
     else  // GMW, use depth-optimized circuit
       path = ConstructPath(IntegerOperationType::kGt, bitlength, "_depth");
 
-    if ((is_greater_algorithm =
-             share_->Get()->GetRegister()->GetCachedAlgorithmDescription(path))) {
-      if constexpr (kDebug) {
-        logger_->LogDebug(
-            fmt::format("Found in cache Boolean integer addition circuit with file path {}", path));
-      }
-    } else {
-      is_greater_algorithm =
-          std::make_shared<AlgorithmDescription>(AlgorithmDescription::FromBristol(path));
-      assert(is_greater_algorithm);
-      if constexpr (kDebug) {
-        logger_->LogDebug(fmt::format("Read Boolean integer addition circuit from file {}", path));
-      }
+    const auto is_greater_algorithm{CircuitLoader::GetInstance().GetLayeredCircuit(path)};
+    if constexpr (kDebug) {
+      logger_->LogDebug(fmt::format("Using Boolean integer comparison circuit from file {}", path));
     }
     const auto share_input{ShareWrapper::Concatenate(std::vector{*share_, *other.share_})};
     return share_input.Evaluate(is_greater_algorithm).Split().at(0);
@@ -206,8 +167,8 @@ ShareWrapper SecureUnsignedInteger::operator>(const SecureUnsignedInteger& other
 
 ShareWrapper SecureUnsignedInteger::operator==(const SecureUnsignedInteger& other) const {
   if (share_->Get()->GetCircuitType() != CircuitType::kBoolean) {
-    // use primitive operation in arithmetic GMW
-    throw std::runtime_error("Integer comparison is not implemented for arithmetic GMW");
+    // test x - y for zero in arithmetic GMW
+    return *share_ == *other.share_;
   } else {  // BooleanCircuitType
     if constexpr (kDebug) {
       if (other->GetProtocol() == MpcProtocol::kBmr) {
@@ -22,12 +22,16 @@
 
 #include "analysis.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <sstream>
+#include <string_view>
 
 #include <fmt/format.h>
 
 #include "communication/transport.h"
+#include "fbs_headers/message_generated.h"
 #include "utility/runtime_info.h"
 #include "utility/version.h"
 
@@ -153,4 +157,135 @@ std::string PrintStatistics(const std::string& experiment_name,
   return ss.str();
 }
 
+// indexed by RunTimeStatistics::StatisticsId
+static constexpr std::array<const char*, static_cast<std::size_t>(StatId::kMax)> kPhaseNames{
+    "MT Presetup",         "MT Setup",    "SB Presetup",  "SB Setup",
+    "SP Presetup",         "SP Setup",    "OT Extension Setup",
+    "Preprocessing Total", "Gates Setup", "Gates Online", "Circuit Evaluation",
+    "Base OTs"};
+
+static std::string EscapeJson(const std::string& string) {
+  std::string escaped;
+  escaped.reserve(string.size());
+  for (const char c : string) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+static double ToMilliseconds(RunTimeStatistics::ClockType::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+static bool IsRecorded(const RunTimeStatistics::TimePointPair& tpp) {
+  return tpp.first != RunTimeStatistics::TimePoint{};
+}
+
+std::string PrintJson(const RunTimeStatistics& statistics,
+                      const std::vector<communication::TransportStatistics>& transport_statistics) {
+  std::stringstream ss;
+  ss << "{\"phases\":{";
+  for (std::size_t i = 0; i < kPhaseNames.size(); ++i) {
+    ss << fmt::format("{}\"{}\":{:.3f}", i == 0 ? "" : ",", kPhaseNames[i],
+                      ToMilliseconds(statistics.data[i].second - statistics.data[i].first));
+  }
+
+  ss << "},\"gate_types\":{";
+  bool first = true;
+  for (const auto& [name, gate_type] : statistics.gate_types) {
+    ss << fmt::format(
+        "{}\"{}\":{{\"number_of_gates\":{},\"setup_ms\":{:.3f},\"setup_wait_ms\":{:.3f},"
+        "\"online_ms\":{:.3f},\"online_wait_ms\":{:.3f}}}",
+        first ? "" : ",", EscapeJson(name), gate_type.number_of_gates,
+        ToMilliseconds(gate_type.setup_time), ToMilliseconds(gate_type.setup_wait_time),
+        ToMilliseconds(gate_type.online_time), ToMilliseconds(gate_type.online_wait_time));
+    first = false;
+  }
+
+  ss << "},\"layers\":[";
+  for (std::size_t i = 0; i < statistics.layers.size(); ++i) {
+    const auto& layer = statistics.layers[i];
+    ss << fmt::format("{}{{\"number_of_gates\":{},\"critical_path_ms\":{:.3f}}}",
+                      i == 0 ? "" : ",", layer.number_of_gates,
+                      ToMilliseconds(layer.critical_path_latency));
+  }
+
+  ss << "],\"communication\":[";
+  for (std::size_t i = 0; i < transport_statistics.size(); ++i) {
+    const auto& transport = transport_statistics[i];
+    ss << fmt::format(
+        "{}{{\"messages_sent\":{},\"messages_received\":{},\"bytes_sent\":{},"
+        "\"bytes_received\":{},\"message_types\":{{",
+        i == 0 ? "" : ",", transport.number_of_messages_sent, transport.number_of_messages_received,
+        transport.number_of_bytes_sent, transport.number_of_bytes_received);
+    first = true;
+    for (std::size_t type = 0; type < transport.message_types.size(); ++type) {
+      const auto& message_type = transport.message_types[type];
+      if (message_type.number_of_messages_sent == 0 &&
+          message_type.number_of_messages_received == 0) {
+        continue;
+      }
+      ss << fmt::format(
+          "{}\"{}\":{{\"messages_sent\":{},\"messages_received\":{},\"bytes_sent\":{},"
+          "\"bytes_received\":{}}}",
+          first ? "" : ",",
+          communication::EnumNameMessageType(static_cast<communication::MessageType>(type)),
+          message_type.number_of_messages_sent, message_type.number_of_messages_received,
+          message_type.number_of_bytes_sent, message_type.number_of_bytes_received);
+      first = false;
+    }
+    ss << "}}";
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+std::string PrintChromeTrace(const RunTimeStatistics& statistics, std::size_t party_id) {
+  // the timestamps are given in microseconds relative to the first recorded phase
+  auto origin = RunTimeStatistics::TimePoint::max();
+  for (std::size_t i = 0; i < kPhaseNames.size(); ++i) {
+    if (IsRecorded(statistics.data[i])) {
+      origin = std::min(origin, statistics.data[i].first);
+    }
+  }
+  auto to_microseconds = [](RunTimeStatistics::ClockType::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+
+  std::stringstream ss;
+  ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto add_event = [&](std::string_view name, std::string_view category, std::size_t thread_id,
+                       RunTimeStatistics::TimePoint start, RunTimeStatistics::TimePoint end) {
+    ss << fmt::format(
+        "{}{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+        "\"pid\":{},\"tid\":{}}}",
+        first ? "" : ",", name, category, to_microseconds(start - origin),
+        to_microseconds(end - start), party_id, thread_id);
+    first = false;
+  };
+
+  // the phases overlap, so each one gets its own track
+  for (std::size_t i = 0; i < kPhaseNames.size(); ++i) {
+    if (IsRecorded(statistics.data[i])) {
+      add_event(kPhaseNames[i], "phase", i, statistics.data[i].first, statistics.data[i].second);
+    }
+  }
+  for (std::size_t i = 0; i < statistics.layers.size(); ++i) {
+    const auto& layer = statistics.layers[i];
+    add_event(fmt::format("Layer {} ({} gates)", i, layer.number_of_gates), "layer",
+              kPhaseNames.size(), layer.online_end - layer.critical_path_latency,
+              layer.online_end);
+  }
+  ss << "]}";
+  return ss.str();
+}
+
 }  // namespace encrypto::motion
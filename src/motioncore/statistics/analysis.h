@@ -84,4 +84,15 @@ class AccumulatedCommunicationStatistics {
 std::string PrintStatistics(const std::string& experiment_name, const AccumulatedRunTimeStatistics&,
                             const AccumulatedCommunicationStatistics&);
 
+/// \brief Formats a single evaluation as JSON object: the duration of the phases, the per-gate-type
+///        and per-layer profile if Configuration::SetProfiling was enabled, and the traffic with
+///        each other party per MessageType. Durations are given in milliseconds.
+std::string PrintJson(const RunTimeStatistics& statistics,
+                      const std::vector<communication::TransportStatistics>& transport_statistics);
+
+/// \brief Formats the phases and, if profiling was enabled, the layers of a single evaluation in
+///        the Chrome trace event format, e.g., for chrome://tracing or Perfetto. The events are
+///        assigned to the process \p party_id, such that the traces of all parties can be merged.
+std::string PrintChromeTrace(const RunTimeStatistics& statistics, std::size_t party_id);
+
 }  // namespace encrypto::motion
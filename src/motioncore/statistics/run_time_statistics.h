@@ -24,8 +24,10 @@
 
 #include <array>
 #include <chrono>
+#include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace encrypto::motion {
 
@@ -50,6 +52,27 @@ struct RunTimeStatistics {
     kMax  // maximal value of this Enum, use as size
   };
 
+  /// \brief Accumulated over all gates of one type, only recorded if profiling is enabled.
+  struct GateTypeStatistics {
+    std::size_t number_of_gates = 0;
+    ClockType::duration setup_time{0};
+    ClockType::duration online_time{0};
+    // parts of setup_time and online_time during which the gates were blocked in
+    // FiberCondition::Wait, e.g., waiting for messages or for preprocessing
+    ClockType::duration setup_wait_time{0};
+    ClockType::duration online_wait_time{0};
+  };
+
+  /// \brief A layer consists of the gates with the same number of interactive gates on their
+  /// longest path from the inputs, only recorded if profiling is enabled.
+  struct LayerStatistics {
+    std::size_t number_of_gates = 0;
+    // time between the last gate of the previous layer and the last gate of this layer finishing
+    // their online phase, i.e., the contribution of this layer to the critical path
+    ClockType::duration critical_path_latency{0};
+    TimePoint online_end;
+  };
+
   TimePoint GetTime() { return ClockType::now(); }
 
   template <StatisticsId Id>
@@ -69,6 +92,11 @@ struct RunTimeStatistics {
   std::string PrintHumanReadable() const;
 
   std::array<TimePointPair, static_cast<std::size_t>(StatisticsId::kMax) + 1> data;
+
+  // keyed by the demangled class name of the gates
+  std::map<std::string, GateTypeStatistics> gate_types;
+
+  std::vector<LayerStatistics> layers;
 };
 
 }  // namespace encrypto::motion
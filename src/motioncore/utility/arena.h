@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+
+namespace encrypto::motion {
+
+/// \brief Bump allocator for the gates, wires and shares of a circuit.
+///
+/// Allocations only advance a pointer into the current block, and deallocations are no-ops. The
+/// memory is released in bulk when the Arena is destroyed, i.e., once the Register started a new
+/// circuit and the last object allocated from this Arena is gone.
+class Arena final : public std::pmr::memory_resource {
+ public:
+  explicit Arena(std::size_t initial_block_size = kDefaultBlockSize);
+
+  ~Arena() final = default;
+
+  Arena(const Arena&) = delete;
+
+  Arena& operator=(const Arena&) = delete;
+
+  static constexpr std::size_t kDefaultBlockSize{1 << 20};
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) final;
+
+  void do_deallocate(void*, std::size_t, std::size_t) final {}
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final {
+    return this == &other;
+  }
+
+  std::mutex mutex_;
+  std::pmr::monotonic_buffer_resource buffer_;
+};
+
+/// \brief Allocator for std::allocate_shared which keeps its Arena alive, such that the objects
+/// may outlive the Register that created them.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(std::shared_ptr<Arena> arena) noexcept : arena_(std::move(arena)) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t n) noexcept {
+    arena_->deallocate(pointer, n * sizeof(T), alignof(T));
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  std::shared_ptr<Arena> arena_;
+};
+
+}  // namespace encrypto::motion
@@ -29,6 +29,7 @@
 #include <cmath>
 #include <iostream>
 
+#include "block.h"
 #include "helpers.h"
 #include "primitives/pseudo_random_generator.h"
 
@@ -513,21 +514,20 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
                                           std::vector<BitVector<>>& y1, const BitVector<> choices,
                                           primitives::Prg& prg_fixed_key,
                                           const std::size_t number_of_colums,
-                                          const std::vector<std::size_t>& bitlengths) {
+                                          const std::vector<std::size_t>& bitlengths,
+                                          const std::size_t column_offset) {
   constexpr std::size_t kKappa{128}, kNumberOfRows{128};
 #define INP(r, c)                                     \
   reinterpret_cast<const std::uint8_t* __restrict__>( \
       __builtin_assume_aligned(matrix.at(r), 16))[c / 8]
   assert(y0.size() == y1.size());
+  assert(y0.size() >= column_offset + number_of_colums);
 
-  const std::size_t original_size{y0.size()}, difference{number_of_colums - original_size};
-  if (difference) {
-    y0.resize(number_of_colums);
-    y1.resize(number_of_colums);
-  }
+  // only the first bitlengths.size() columns are real OTs, the rest is padding
+  const std::size_t original_size{bitlengths.size()};
 
-  for (auto& block_vector : y0)
-    block_vector = BitVector(std::vector<std::byte>(kKappa / 8), kKappa);
+  for (auto j = column_offset; j < column_offset + number_of_colums; ++j)
+    y0[j] = BitVector(std::vector<std::byte>(kKappa / 8), kKappa);
 
   std::uint64_t r{0}, c{0};
   int i{0};
@@ -599,18 +599,18 @@ void BitMatrix::SenderTransposeAndEncrypt(const std::array<const std::byte*, 128
                            INP(r + 0, c), INP(r + 1, c), INP(r + 2, c), INP(r + 3, c),
                            INP(r + 4, c), INP(r + 5, c), INP(r + 6, c), INP(r + 7, c));
         for (i = 0; i < 8; vec = _mm_slli_epi64(vec, 1), ++i) {
-          *reinterpret_cast<std::uint16_t* __restrict__>(y0[c + i].GetMutableData().data() +
-                                                         r / 8) = _mm_movemask_epi8(vec);
+          *reinterpret_cast<std::uint16_t* __restrict__>(
+              y0[column_offset + c + i].GetMutableData().data() + r / 8) = _mm_movemask_epi8(vec);
         }
       }
     }
     // XXX
-    for (; c_old < c && c_old < original_size; ++c_old) {
-      auto& out0 = y0[c_old];
-      auto& out1 = y1[c_old];
+    for (; c_old < c && column_offset + c_old < original_size; ++c_old) {
+      auto& out0 = y0[column_offset + c_old];
+      auto& out1 = y1[column_offset + c_old];
 
       // bit length of the OT
-      const auto bitlength = bitlengths[c_old];
+      const auto bitlength = bitlengths[column_offset + c_old];
 
       out1 = choices ^ out0;
       assert(out0.GetSize() == 128);
@@ -641,19 +641,20 @@ void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 1
                                             std::vector<BitVector<>>& output,
                                             primitives::Prg& prg_fixed_key,
                                             const std::size_t number_of_colums,
-                                            const std::vector<std::size_t>& bitlengths) {
+                                            const std::vector<std::size_t>& bitlengths,
+                                            const std::size_t column_offset) {
   constexpr std::size_t kKappa{128}, kNumberOfRows{128};
 #define INP(r, c)                                     \
   reinterpret_cast<const std::uint8_t* __restrict__>( \
       __builtin_assume_aligned(matrix.at(r), 16))[c / 8]
 
-  const std::size_t original_size{output.size()}, difference{number_of_colums - original_size};
-  if (difference) {
-    output.resize(number_of_colums);
-  }
+  assert(output.size() >= column_offset + number_of_colums);
 
-  for (auto& block_vector : output)
-    block_vector = BitVector(std::vector<std::byte>(kKappa / 8), kKappa);
+  // only the first bitlengths.size() columns are real OTs, the rest is padding
+  const std::size_t original_size{bitlengths.size()};
+
+  for (auto j = column_offset; j < column_offset + number_of_colums; ++j)
+    output[j] = BitVector(std::vector<std::byte>(kKappa / 8), kKappa);
 
   std::uint64_t r{0}, c{0};
   int i{0};
@@ -724,16 +725,17 @@ void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 1
                            INP(r + 0, c), INP(r + 1, c), INP(r + 2, c), INP(r + 3, c),
                            INP(r + 4, c), INP(r + 5, c), INP(r + 6, c), INP(r + 7, c));
         for (i = 0; i < 8; vec = _mm_slli_epi64(vec, 1), ++i) {
-          *reinterpret_cast<std::uint16_t* __restrict__>(output[c + i].GetMutableData().data() +
-                                                         r / 8) = _mm_movemask_epi8(vec);
+          *reinterpret_cast<std::uint16_t* __restrict__>(
+              output[column_offset + c + i].GetMutableData().data() + r / 8) =
+              _mm_movemask_epi8(vec);
         }
       }
     }
     // XXX
-    for (; c_old < c && c_old < original_size; ++c_old) {
-      auto& o = output[c_old];
+    for (; c_old < c && column_offset + c_old < original_size; ++c_old) {
+      auto& o = output[column_offset + c_old];
       assert(o.GetSize() == 128);
-      const std::size_t bitlength = bitlengths[c_old];
+      const std::size_t bitlength = bitlengths[column_offset + c_old];
 
       if (bitlength <= kKappa) {
         prg_fixed_key.Mmo(o.GetMutableData().data());
@@ -748,6 +750,31 @@ void BitMatrix::ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 1
 #endif
 }
 
+void BitMatrix::TransposeToBlocks(const std::array<const std::byte*, 128>& matrix,
+                                  Block128* output, const std::size_t number_of_colums) {
+  constexpr std::size_t kNumberOfRows{128};
+#define INP(r, c)                                     \
+  reinterpret_cast<const std::uint8_t* __restrict__>( \
+      __builtin_assume_aligned(matrix.at(r), 16))[c / 8]
+
+  assert(number_of_colums % 128 == 0);
+
+  __m128i vec;
+  for (std::uint64_t r = 0; r <= kNumberOfRows - 16; r += 16) {
+    for (std::uint64_t c = 0; c < number_of_colums; c += 8) {
+      vec = _mm_set_epi8(INP(r + 8, c), INP(r + 9, c), INP(r + 10, c), INP(r + 11, c),
+                         INP(r + 12, c), INP(r + 13, c), INP(r + 14, c), INP(r + 15, c),
+                         INP(r + 0, c), INP(r + 1, c), INP(r + 2, c), INP(r + 3, c), INP(r + 4, c),
+                         INP(r + 5, c), INP(r + 6, c), INP(r + 7, c));
+      for (int i = 0; i < 8; vec = _mm_slli_epi64(vec, 1), ++i) {
+        *reinterpret_cast<std::uint16_t* __restrict__>(output[c + i].data() + r / 8) =
+            _mm_movemask_epi8(vec);
+      }
+    }
+  }
+#undef INP
+}
+
 bool BitMatrix::operator==(const BitMatrix& other) {
   if (other.data_.size() != data_.size()) {
     return false;
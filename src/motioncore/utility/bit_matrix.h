@@ -39,6 +39,8 @@ class Prg;
 
 namespace encrypto::motion {
 
+struct Block128;
+
 class BitMatrix {
  public:
   BitMatrix() = default;
@@ -178,24 +180,42 @@ class BitMatrix {
   /// sender role. \param matrix \param y0 \todo description \param y1 \todo description \param
   /// number_of_columns \param choices \todo description \param prg_fixed_key \todo description
   /// \param bitlengths  \todo description
+  /// \param column_offset index of the OT that corresponds to the first column of matrix, i.e.,
+  /// matrix is the chunk of the bit matrix starting at this column.
   /// \pre - All rows must be of size equal to number_of_colums
-  ///      - y0 and y1 must be of equal size
+  ///      - y0 and y1 must be of equal size and contain at least column_offset + number_of_columns
+  ///        entries
   static void SenderTransposeAndEncrypt(const std::array<const std::byte*, 128>& matrix,
                                         std::vector<BitVector<>>& y0, std::vector<BitVector<>>& y1,
                                         const BitVector<> choices, primitives::Prg& prg_fixed_key,
                                         const std::size_t number_of_columns,
-                                        const std::vector<std::size_t>& bitlengths);
+                                        const std::vector<std::size_t>& bitlengths,
+                                        const std::size_t column_offset = 0);
 
   /// \brief Transposes a matrix of 128 rows and arbitrary column size and encrypts it for the
   /// recepient role. \param matrix \param[out] output \param number_of_columns \param choices \todo
-  /// description \param prg_fixed_key \todo description \param bitlengths  \todo description \pre -
-  /// All rows must be of size equal to number_of_colums
-  ///      - y0 and y1 must be of equal size
+  /// description \param prg_fixed_key \todo description \param bitlengths  \todo description
+  /// \param column_offset index of the OT that corresponds to the first column of matrix, i.e.,
+  /// matrix is the chunk of the bit matrix starting at this column.
+  /// \pre - All rows must be of size equal to number_of_colums
+  ///      - output must contain at least column_offset + number_of_columns entries
   static void ReceiverTransposeAndEncrypt(const std::array<const std::byte*, 128>& matrix,
                                           std::vector<BitVector<>>& output,
                                           primitives::Prg& prg_fixed_key,
                                           const std::size_t number_of_columns,
-                                          const std::vector<std::size_t>& bitlengths);
+                                          const std::vector<std::size_t>& bitlengths,
+                                          const std::size_t column_offset = 0);
+
+  /// \brief Transposes a matrix of 128 rows and arbitrary column size into one 128-bit block per
+  /// column without hashing, i.e., block j holds column j in the same layout as the blocks computed
+  /// by SenderTransposeAndEncrypt and ReceiverTransposeAndEncrypt before they are hashed.
+  /// \param matrix
+  /// \param[out] output must point to at least number_of_columns blocks
+  /// \param number_of_columns
+  /// \pre - All rows must be of size equal to number_of_columns
+  ///      - number_of_columns must be a multiple of 128
+  static void TransposeToBlocks(const std::array<const std::byte*, 128>& matrix, Block128* output,
+                                const std::size_t number_of_columns);
 
   /// \brief Compare with another BitMatrix for equality
   /// \param other
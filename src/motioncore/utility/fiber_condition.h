@@ -25,7 +25,11 @@
 #pragma once
 
 #include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fss.hpp>
 #include <boost/fiber/mutex.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 
 namespace encrypto::motion {
@@ -52,7 +56,15 @@ class FiberCondition {
   /// \brief Blocks until fiber is notified and condition_function_ returns true.
   void Wait() const {
     std::unique_lock<decltype(mutex_)> lock(mutex_);
-    condition_variable_.wait(lock, condition_function_);
+    RecordWaitTime([&] { condition_variable_.wait(lock, condition_function_); });
+  }
+
+  /// \brief Blocks until fiber is notified and \p predicate returns true. Can be used to wait
+  ///        for a weaker condition than condition_function_, e.g., partial progress.
+  template <typename Predicate>
+  void Wait(Predicate predicate) const {
+    std::unique_lock<decltype(mutex_)> lock(mutex_);
+    RecordWaitTime([&] { condition_variable_.wait(lock, predicate); });
   }
 
   /// \brief Blocks until fiber is notified and condition_function_ returns true
@@ -75,7 +87,45 @@ class FiberCondition {
   ///       only be modified under the locked mutex.
   boost::fibers::mutex& GetMutex() noexcept { return mutex_; }
 
+  /// \brief While \p wait_time is set for the calling fiber, the time it spends in Wait() is
+  ///        added to it. Pass nullptr to stop recording.
+  static void SetWaitTimeRecorder(std::chrono::steady_clock::duration* wait_time) {
+    const bool was_recording{wait_time_.get() != nullptr};
+    if (!was_recording && wait_time != nullptr) {
+      number_of_recorders_.fetch_add(1, std::memory_order_relaxed);
+    } else if (was_recording && wait_time == nullptr) {
+      number_of_recorders_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    wait_time_.reset(wait_time);
+  }
+
+  static std::chrono::steady_clock::duration* GetWaitTimeRecorder() { return wait_time_.get(); }
+
  private:
+  template <typename WaitFunction>
+  static void RecordWaitTime(WaitFunction&& wait) {
+    // skips the fiber-specific lookup unless some fiber records its wait time, i.e., profiling is
+    // enabled
+    if (number_of_recorders_.load(std::memory_order_relaxed) == 0) {
+      wait();
+      return;
+    }
+    auto* wait_time = wait_time_.get();
+    if (wait_time == nullptr) {
+      wait();
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    wait();
+    *wait_time += std::chrono::steady_clock::now() - start;
+  }
+
+  // points to a duration owned by the caller of SetWaitTimeRecorder, hence the no-op cleanup
+  static inline boost::fibers::fiber_specific_ptr<std::chrono::steady_clock::duration> wait_time_{
+      [](std::chrono::steady_clock::duration*) {}};
+  // number of fibers for which a recorder is set
+  static inline std::atomic<std::size_t> number_of_recorders_{0};
+
   mutable boost::fibers::condition_variable condition_variable_;
   mutable boost::fibers::mutex mutex_;
   const std::function<bool()> condition_function_;
@@ -42,11 +42,13 @@
 namespace encrypto::motion {
 
 FiberThreadPool::FiberThreadPool(std::size_t number_of_workers, std::size_t number_of_tasks,
-                                 bool suspend_scheduler)
+                                 bool suspend_scheduler, std::vector<std::size_t> cpu_affinity)
     : number_of_workers_(number_of_workers > 0 ? number_of_workers
                          : std::thread::hardware_concurrency()),
       running_(false),
       suspend_scheduler_(suspend_scheduler),
+      cpu_affinity_(std::move(cpu_affinity)),
+      number_of_pending_tasks_(0),
       task_queue_(std::make_unique<boost::fibers::buffered_channel<task_t>>(64)),
       worker_barrier_(std::make_unique<boost::fibers::barrier>(number_of_workers_)) {
     if (number_of_workers_ == 1) {
@@ -133,6 +135,9 @@ void FiberThreadPool::create_threads() {
         if constexpr (kDebug) {
             ThreadSetName(t, fmt::format("pool-worker-{}", i));
         }
+        if (!cpu_affinity_.empty()) {
+            ThreadSetAffinity(t, cpu_affinity_.at(i % cpu_affinity_.size()));
+        }
     }
     running_ = true;
 }
@@ -147,7 +152,23 @@ void FiberThreadPool::join() {
 
 void FiberThreadPool::post(std::function<void()> fctn) {
     assert(running_);
-    task_queue_->push(fctn);
+    {
+        std::scoped_lock lock(pending_tasks_mutex_);
+        ++number_of_pending_tasks_;
+    }
+    task_queue_->push([this, fctn = std::move(fctn)] {
+        fctn();
+        {
+            std::scoped_lock lock(pending_tasks_mutex_);
+            --number_of_pending_tasks_;
+        }
+        pending_tasks_condition_.notify_all();
+    });
+}
+
+void FiberThreadPool::wait_idle() {
+    std::unique_lock lock(pending_tasks_mutex_);
+    pending_tasks_condition_.wait(lock, [this] { return number_of_pending_tasks_ == 0; });
 }
 
 }  // namespace encrypto::motion
@@ -21,8 +21,10 @@
 #ifndef FIBER_THREAD_POOL_HPP
 #define FIBER_THREAD_POOL_HPP
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -50,8 +52,10 @@ public:
     //   number of tasks that are to be expected
     // - suspend_scheduler
     //   suspend if there is no work to be done
+    // - cpu_affinity
+    //   if not empty, worker i is pinned to CPU cpu_affinity[i % cpu_affinity.size()]
     FiberThreadPool(std::size_t number_of_workers, std::size_t number_of_tasks = 0,
-                    bool suspend_scheduler = true);
+                    bool suspend_scheduler = true, std::vector<std::size_t> cpu_affinity = {});
 
     // Destructor, calls join() if necessary
     ~FiberThreadPool();
@@ -60,6 +64,12 @@ public:
     // This may block if the task queue is currently full
     void post(task_t task);
 
+    // Block until all previously posted tasks have completed.  The pool stays
+    // open, so it can be reused for further tasks afterwards.
+    void wait_idle();
+
+    std::size_t get_number_of_workers() const noexcept { return number_of_workers_; }
+
     // Close the pool.  No new tasks can be posted to the pool.
     // Note: Be sure that all previously posted tasks has been completed before
     // you call this method.
@@ -75,6 +85,11 @@ private:
     std::size_t number_of_workers_;
     bool running_;
     bool suspend_scheduler_;
+    std::vector<std::size_t> cpu_affinity_;
+    // number of posted tasks that have not completed yet
+    std::size_t number_of_pending_tasks_;
+    std::mutex pending_tasks_mutex_;
+    std::condition_variable pending_tasks_condition_;
     std::unique_ptr<boost::fibers::buffered_channel<task_t>> task_queue_;
     std::unique_ptr<boost::fibers::barrier> worker_barrier_;
     std::vector<std::thread> worker_threads_;
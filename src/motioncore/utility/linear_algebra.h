@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2021 Oleksandr Tkachenko
+// Cryptography and Privacy Engineering Group (ENCRYPTO)
+// TU Darmstadt, Germany
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace encrypto::motion {
+
+/// \brief Adds the product of the row-major matrices \p a (\p rows x \p inner) and \p b (\p inner x
+///        \p columns) to the row-major matrix \p c (\p rows x \p columns).
+///
+/// The matrices are processed in blocks that fit into the L1 cache, and the innermost loop runs
+/// over a row of \p b and \p c so that the compiler can vectorize it.
+template <typename T>
+void MatrixMultiplyAccumulate(std::size_t rows, std::size_t inner, std::size_t columns,
+                              const T* __restrict__ a, const T* __restrict__ b,
+                              T* __restrict__ c) {
+  // std::uint8_t and std::uint16_t are promoted to int, whose multiplication may overflow, so the
+  // products are computed in the unsigned type of the promotion and truncated
+  using Product = std::make_unsigned_t<decltype(+T{})>;
+  constexpr std::size_t kBlockSize = 64;
+  for (std::size_t row_block = 0; row_block < rows; row_block += kBlockSize) {
+    const auto row_end = std::min(row_block + kBlockSize, rows);
+    for (std::size_t inner_block = 0; inner_block < inner; inner_block += kBlockSize) {
+      const auto inner_end = std::min(inner_block + kBlockSize, inner);
+      for (std::size_t column_block = 0; column_block < columns; column_block += kBlockSize) {
+        const auto column_end = std::min(column_block + kBlockSize, columns);
+        for (std::size_t i = row_block; i < row_end; ++i) {
+          T* __restrict__ c_row = c + i * columns;
+          for (std::size_t l = inner_block; l < inner_end; ++l) {
+            const Product a_il = a[i * inner + l];
+            const T* __restrict__ b_row = b + l * columns;
+            for (std::size_t j = column_block; j < column_end; ++j) {
+              c_row[j] += static_cast<T>(a_il * b_row[j]);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace encrypto::motion
@@ -24,6 +24,7 @@
 
 #include <boost/fiber/condition_variable.hpp>
 #include <boost/fiber/mutex.hpp>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <mutex>
@@ -39,8 +40,9 @@ namespace encrypto::motion {
  * such that items can be enqueued/dequeued by different threads.  The queue
  * can be customized with different synchronization primitives, e.g.,
  * std::mutex and fibers::mutex, via template parameters.  Elements can be
- * dequeued one-by-one (dequeue) or all at once (batch_dequeue).  The queue can
- * be closed which signals consumers that no further elements will be inserted.
+ * dequeued one-by-one (dequeue) or all at once (BatchDequeue, BatchDequeueUntil).
+ * The queue can be closed which signals consumers that no further elements will
+ * be inserted.
  * Dequeue operations return std::nullopt if the queue is closed and empty.
  */
 template <typename T, typename MutexType, typename ConditionVariableType>
@@ -150,6 +152,30 @@ class BasicSynchronizedQueue {
     return std::optional<std::queue<T>>(std::move(output));
   }
 
+  /**
+   * Extract all elements of the queue, waiting at most until timeout_time for
+   * elements to arrive.  The result is empty if the timeout expired.
+   */
+  template <typename Clock, typename Duration>
+  std::optional<std::queue<T>> BatchDequeueUntil(
+      const std::chrono::time_point<Clock, Duration>& timeout_time) noexcept {
+    std::queue<T> output;
+    std::unique_lock lock(mutex_);
+    if (queue_.empty() && closed_) {
+      return std::nullopt;
+    }
+    if (queue_.empty() && !closed_) {
+      condition_variable_.wait_until(
+          lock, timeout_time, [this] { return !this->queue_.empty() || this->closed_; });
+    }
+    if (queue_.empty() && closed_) {
+      return std::nullopt;
+    }
+    std::swap(queue_, output);
+    lock.unlock();
+    return std::optional<std::queue<T>>(std::move(output));
+  }
+
  private:
   bool closed_ = false;
   std::queue<T> queue_;
@@ -21,9 +21,13 @@
 #include "thread.h"
 #include <pthread.h>
 #include <cassert>
+#include <cstring>
+#include <stdexcept>
 #include <string>
 #include <thread>
 
+#include <fmt/format.h>
+
 namespace encrypto::motion {
 
 void ThreadSetName(std::thread& thread, const std::string& name) {
@@ -32,4 +36,18 @@ void ThreadSetName(std::thread& thread, const std::string& name) {
   pthread_setname_np(handle, name.c_str());
 }
 
+void ThreadSetAffinity(std::thread& thread, std::size_t cpu_id) {
+  if (cpu_id >= CPU_SETSIZE) {
+    throw std::runtime_error(fmt::format("Invalid CPU id {}", cpu_id));
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu_id, &cpu_set);
+  auto result = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set);
+  if (result != 0) {
+    throw std::runtime_error(
+        fmt::format("Failed to pin thread to CPU {}: {}", cpu_id, std::strerror(result)));
+  }
+}
+
 }  // namespace encrypto::motion
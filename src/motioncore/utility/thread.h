@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <thread>
 
@@ -29,4 +30,8 @@ namespace encrypto::motion {
 // - name.size() <= 16
 void ThreadSetName(std::thread& thread, const std::string& name);
 
+// Pins a given thread to the CPU with the given id using pthread_setaffinity_np.
+// Throws a std::runtime_error if this fails, e.g., if the CPU does not exist.
+void ThreadSetAffinity(std::thread& thread, std::size_t cpu_id);
+
 }  // namespace encrypto::motion
@@ -181,4 +181,16 @@ enum class GateType : unsigned int {
   kInvalid = 3
 };
 
+enum class CircuitEvaluationMode : unsigned int {
+  kGateByGate,    // one gate per primitive operation of the circuit
+  kLayerBatched,  // one multi-wire gate per operation type and topological layer
+  kInvalid        // for checking whether the value is valid
+};
+
+enum class OtBackend : unsigned int {
+  kOtExtension,  // IKNP-style OT extension, communication linear in the number of OTs
+  kSilentOt,     // LPN-based pseudorandom correlation generator, sublinear communication
+  kInvalid       // for checking whether the value is valid
+};
+
 }  // namespace encrypto::motion
@@ -20,6 +20,11 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "test_constants.h"
@@ -173,3 +178,46 @@ TEST(AesNi128, MmoSingle) {
   AesniMmoSingle(round_keys.data(), output.data());
   EXPECT_EQ(output, kExpectedOutput);
 }
+
+TEST(AesNi128, BmrDkcBatch) {
+  constexpr std::size_t kNumberOfParties = 3;
+  constexpr std::size_t kNumberOfSimd = 13;
+  constexpr std::size_t kNumberOfKeys = kNumberOfParties * kNumberOfSimd;
+  constexpr std::uint64_t kGateId = 42;
+  std::mt19937_64 random_generator(0);
+  auto random_blocks = [&random_generator](std::size_t number_of_bytes) {
+    std::vector<std::uint8_t> blocks(number_of_bytes);
+    std::generate(blocks.begin(), blocks.end(), [&random_generator] {
+      return static_cast<std::uint8_t>(random_generator());
+    });
+    return blocks;
+  };
+
+  alignas(kAesBlockSize) std::array<std::uint8_t, kAesRoundKeysSize128> round_keys;
+  const auto key = random_blocks(kAesKeySize128);
+  std::copy(std::begin(key), std::end(key), std::begin(round_keys));
+  AesniKeyExpansion128(round_keys.data());
+
+  alignas(kAesBlockSize) std::array<std::uint8_t, kNumberOfKeys * kAesBlockSize> keys_a;
+  alignas(kAesBlockSize) std::array<std::uint8_t, kNumberOfKeys * kAesBlockSize> keys_b;
+  alignas(kAesBlockSize) std::array<std::uint8_t, kNumberOfKeys * kAesBlockSize> output;
+  const auto random_keys_a = random_blocks(keys_a.size());
+  const auto random_keys_b = random_blocks(keys_b.size());
+  const auto random_output = random_blocks(output.size());
+  std::copy(std::begin(random_keys_a), std::end(random_keys_a), std::begin(keys_a));
+  std::copy(std::begin(random_keys_b), std::end(random_keys_b), std::begin(keys_b));
+  std::copy(std::begin(random_output), std::end(random_output), std::begin(output));
+  auto expected_output = output;
+
+  for (std::size_t simd_i = 0; simd_i < kNumberOfSimd; ++simd_i) {
+    for (std::size_t party_i = 0; party_i < kNumberOfParties; ++party_i) {
+      const auto offset = (simd_i * kNumberOfParties + party_i) * kAesBlockSize;
+      AesniBmrDkc(round_keys.data(), keys_a.data() + offset, keys_b.data() + offset,
+                  kGateId + simd_i, kNumberOfParties,
+                  expected_output.data() + simd_i * kNumberOfParties * kAesBlockSize);
+    }
+  }
+  AesniBmrDkcBatch(round_keys.data(), keys_a.data(), keys_b.data(), kGateId, kNumberOfSimd,
+                   kNumberOfParties, output.data());
+  EXPECT_EQ(output, expected_output);
+}
@@ -27,6 +27,7 @@
 #include "protocols/arithmetic_gmw/arithmetic_gmw_gate.h"
 #include "protocols/arithmetic_gmw/arithmetic_gmw_wire.h"
 #include "protocols/share_wrapper.h"
+#include "secure_type/secure_fixed_point.h"
 #include "test_constants.h"
 #include "test_helpers.h"
 
@@ -489,6 +490,154 @@ TEST(ArithmeticGmw, Multiplication_1_100_Simd_2_3_parties) {
   }
 }
 
+TEST(ArithmeticGmw, ReclaimWireStorageInMultiplicationChain_2_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr std::size_t kNumberOfParties = 2, kNumberOfSimd = 100, kDepth = 20;
+  using Wire = encrypto::motion::proto::arithmetic_gmw::Wire<std::uint32_t>;
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    const std::vector<std::uint32_t> input_x = ::RandomVector<std::uint32_t>(kNumberOfSimd);
+    const std::vector<std::uint32_t> input_y = ::RandomVector<std::uint32_t>(kNumberOfSimd);
+    const std::vector<std::uint32_t> dummy_input(kNumberOfSimd, 0);
+    try {
+      std::vector<PartyPointer> motion_parties(
+          std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+      for (auto& party : motion_parties) {
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+        party->GetConfiguration()->SetReclaimWireStorage(true);
+      }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+      for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+        auto& party = motion_parties.at(party_id);
+        encrypto::motion::ShareWrapper share_product(
+            party->In<kArithmeticGmw>(party_id == 0 ? input_x : dummy_input, 0));
+        const encrypto::motion::ShareWrapper share_y(
+            party->In<kArithmeticGmw>(party_id == 1 ? input_y : dummy_input, 1));
+        for (auto j = 0ull; j < kDepth; ++j) {
+          share_product *= share_y;
+        }
+        auto share_output = share_product.Out();
+
+        party->Run();
+
+        // the inputs, the intermediate products and the opened d and e of every multiplication
+        // were released, only the output is left
+        std::size_t number_of_wires_with_values = 0;
+        for (const auto& wire : party->GetBackend()->GetRegister()->GetWires()) {
+          const auto arithmetic_wire = std::dynamic_pointer_cast<Wire>(wire);
+          if (arithmetic_wire && !arithmetic_wire->GetValues().empty()) {
+            ++number_of_wires_with_values;
+          }
+        }
+        EXPECT_EQ(number_of_wires_with_values, 1);
+
+        auto wire = std::dynamic_pointer_cast<Wire>(share_output->GetWires().at(0));
+        for (auto k = 0ull; k < kNumberOfSimd; ++k) {
+          std::uint32_t expected = input_x.at(k);
+          for (auto j = 0ull; j < kDepth; ++j) {
+            expected *= input_y.at(k);
+          }
+          EXPECT_EQ(wire->GetValues().at(k), expected);
+        }
+        party->Finish();
+      }
+    } catch (std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    }
+  }
+}
+
+TEST(ArithmeticGmw, MatrixMultiplication_2_3_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr std::size_t kRows{3}, kInner{5}, kColumns{4};
+  std::srand(std::time(nullptr));
+  auto template_test = [](auto template_variable) {
+    using T = decltype(template_variable);
+    for (auto number_of_parties : {2u, 3u}) {
+      std::size_t output_owner = std::rand() % number_of_parties;
+      const std::vector<T> input_a = ::RandomVector<T>(kRows * kInner);
+      const std::vector<T> input_b = ::RandomVector<T>(kInner * kColumns);
+      const std::vector<T> input_c = ::RandomVector<T>(kInner);
+
+      std::vector<T> expected_product(kRows * kColumns, 0);
+      for (auto i = 0u; i < kRows; ++i) {
+        for (auto l = 0u; l < kInner; ++l) {
+          for (auto j = 0u; j < kColumns; ++j) {
+            expected_product.at(i * kColumns + j) +=
+                input_a.at(i * kInner + l) * input_b.at(l * kColumns + j);
+          }
+        }
+      }
+      T expected_dot_product = 0;
+      for (auto l = 0u; l < kInner; ++l) {
+        expected_dot_product += input_a.at(l) * input_c.at(l);
+      }
+
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(std::random_device{}() % 2 == 1);
+        }
+#pragma omp parallel num_threads(motion_parties.size() + 1) default(shared)
+#pragma omp single
+#pragma omp taskloop num_tasks(motion_parties.size())
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          // party 0 inputs a and the first row of a, the last party inputs b and c
+          const auto last_party = number_of_parties - 1;
+          const std::vector<T> my_input_a =
+              party_id == 0 ? input_a : std::vector<T>(kRows * kInner, 0);
+          const std::vector<T> my_row_a(my_input_a.begin(), my_input_a.begin() + kInner);
+          const std::vector<T> my_input_b =
+              party_id == last_party ? input_b : std::vector<T>(kInner * kColumns, 0);
+          const std::vector<T> my_input_c =
+              party_id == last_party ? input_c : std::vector<T>(kInner, 0);
+
+          encrypto::motion::ShareWrapper share_a =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_input_a, 0);
+          encrypto::motion::ShareWrapper share_row_a =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_row_a, 0);
+          encrypto::motion::ShareWrapper share_b =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_input_b, last_party);
+          encrypto::motion::ShareWrapper share_c =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_input_c, last_party);
+
+          auto share_product = share_a.MatMul(share_b, kRows, kInner, kColumns);
+          auto share_dot_product = share_row_a.DotProduct(share_c);
+
+          auto share_output_product = share_product.Out(output_owner);
+          auto share_output_dot_product = share_dot_product.Out(output_owner);
+
+          motion_parties.at(party_id)->Run();
+
+          if (party_id == output_owner) {
+            auto wire_product =
+                std::dynamic_pointer_cast<encrypto::motion::proto::arithmetic_gmw::Wire<T>>(
+                    share_output_product->GetWires().at(0));
+            auto wire_dot_product =
+                std::dynamic_pointer_cast<encrypto::motion::proto::arithmetic_gmw::Wire<T>>(
+                    share_output_dot_product->GetWires().at(0));
+
+            EXPECT_EQ(wire_product->GetValues(), expected_product);
+            EXPECT_EQ(wire_dot_product->GetValues().at(0), expected_dot_product);
+          }
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  };
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    // lambdas don't support templates, but only auto types. So, let's try to trick them.
+    template_test(static_cast<std::uint8_t>(0));
+    template_test(static_cast<std::uint16_t>(0));
+    template_test(static_cast<std::uint32_t>(0));
+    template_test(static_cast<std::uint64_t>(0));
+  }
+}
+
 TEST(ArithmeticGmw, ConstantMultiplication_1_1K_Simd_2_3_4_5_10_parties) {
   constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
   constexpr auto kArithmeticConstant = encrypto::motion::MpcProtocol::kArithmeticConstant;
@@ -605,3 +754,90 @@ TEST(ArithmeticGmw, ConstantMultiplication_1_1K_Simd_2_3_4_5_10_parties) {
     template_test(static_cast<std::uint64_t>(0));
   }
 }
+
+TEST(ArithmeticGmw, FixedPointTruncationAndMultiplication_1_100_Simd_2_3_parties) {
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  using encrypto::motion::SecureFixedPoint;
+  std::srand(std::time(nullptr));
+  auto template_test = [](auto template_variable, std::size_t fractional_bits) {
+    using T = decltype(template_variable);
+    using SignedT = std::make_signed_t<T>;
+    std::mt19937_64 random_generator(std::random_device{}());
+    std::uniform_real_distribution<double> distribution(-8.0, 8.0);
+    for (auto number_of_parties : {2u, 3u}) {
+      std::size_t output_owner = std::rand() % number_of_parties;
+      std::vector<T> input_a(100), input_b(100);
+      for (auto i = 0u; i < input_a.size(); ++i) {
+        input_a.at(i) =
+            SecureFixedPoint::Encode<T>(distribution(random_generator), fractional_bits);
+        input_b.at(i) =
+            SecureFixedPoint::Encode<T>(distribution(random_generator), fractional_bits);
+      }
+      try {
+        std::vector<PartyPointer> motion_parties(
+            std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+        for (auto& party : motion_parties) {
+          party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+          party->GetConfiguration()->SetOnlineAfterSetup(std::random_device{}() % 2 == 1);
+        }
+#pragma omp parallel num_threads(motion_parties.size() + 1) default(shared)
+#pragma omp single
+#pragma omp taskloop num_tasks(motion_parties.size())
+        for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+          // party 0 inputs a, the last party inputs b
+          const auto last_party = number_of_parties - 1;
+          const std::vector<T> my_input_a = party_id == 0 ? input_a : std::vector<T>(100, 0);
+          const std::vector<T> my_input_b =
+              party_id == last_party ? input_b : std::vector<T>(100, 0);
+
+          encrypto::motion::ShareWrapper share_a =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_input_a, 0);
+          encrypto::motion::ShareWrapper share_b =
+              motion_parties.at(party_id)->In<kArithmeticGmw>(my_input_b, last_party);
+
+          auto share_truncated = share_a.Truncate(fractional_bits);
+          SecureFixedPoint fixed_point_a(share_a, fractional_bits);
+          SecureFixedPoint fixed_point_b(share_b, fractional_bits);
+          auto fixed_point_product = fixed_point_a * fixed_point_b;
+
+          auto share_output_truncated = share_truncated.Out(output_owner);
+          auto share_output_product = fixed_point_product.Get().Out(output_owner);
+
+          motion_parties.at(party_id)->Run();
+
+          if (party_id == output_owner) {
+            auto wire_truncated =
+                std::dynamic_pointer_cast<encrypto::motion::proto::arithmetic_gmw::Wire<T>>(
+                    share_output_truncated->GetWires().at(0));
+            auto wire_product =
+                std::dynamic_pointer_cast<encrypto::motion::proto::arithmetic_gmw::Wire<T>>(
+                    share_output_product->GetWires().at(0));
+
+            // probabilistic truncation may round up by one in the last bit
+            for (auto i = 0u; i < input_a.size(); ++i) {
+              const SignedT expected_truncated{
+                  static_cast<SignedT>(static_cast<SignedT>(input_a.at(i)) >> fractional_bits)};
+              const SignedT truncated{static_cast<SignedT>(wire_truncated->GetValues().at(i))};
+              EXPECT_LE(expected_truncated, truncated);
+              EXPECT_LE(truncated, expected_truncated + 1);
+
+              const SignedT expected_product{static_cast<SignedT>(
+                  static_cast<SignedT>(static_cast<T>(input_a.at(i) * input_b.at(i))) >>
+                  fractional_bits)};
+              const SignedT product{static_cast<SignedT>(wire_product->GetValues().at(i))};
+              EXPECT_LE(expected_product, product);
+              EXPECT_LE(product, expected_product + 1);
+            }
+          }
+          motion_parties.at(party_id)->Finish();
+        }
+      } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    }
+  };
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    template_test(static_cast<std::uint32_t>(0), 8);
+    template_test(static_cast<std::uint64_t>(0), SecureFixedPoint::kDefaultFractionalBits);
+  }
+}
@@ -24,9 +24,11 @@
 
 #include <gtest/gtest.h>
 #include "base/party.h"
+#include "communication/communication_layer.h"
 #include "protocols/boolean_gmw/boolean_gmw_gate.h"
 #include "protocols/boolean_gmw/boolean_gmw_wire.h"
 #include "protocols/share_wrapper.h"
+#include "statistics/analysis.h"
 #include "test_constants.h"
 #include "test_helpers.h"
 
@@ -217,6 +219,184 @@ TEST(BooleanGmw, Xor_64_bit_200_Simd_2_3_4_5_10_parties) {
   }
 }
 
+// a long chain of non-interactive gates is evaluated inline without one fiber per gate
+TEST(BooleanGmw, XorChain_10K_gates_2_parties) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2, kChainLength = 10'000;
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    std::srand(std::time(nullptr));
+    std::vector<bool> global_input(kNumberOfParties);
+    for (auto j = 0ull; j < global_input.size(); ++j) {
+      global_input.at(j) = (std::rand() % 2) == 1;
+    }
+    try {
+      std::vector<PartyPointer> motion_parties(
+          std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+      for (auto& party : motion_parties) {
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+      }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+      for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+        std::vector<encrypto::motion::ShareWrapper> share_input;
+        for (auto j = 0ull; j < kNumberOfParties; ++j) {
+          const bool input = j == party_id ? static_cast<bool>(global_input.at(j)) : false;
+          share_input.push_back(motion_parties.at(party_id)->In<kBooleanGmw>(input, j));
+        }
+
+        // an even number of XORs with the first input and INVs leaves a ^ b
+        auto share_chain = share_input.at(0) ^ share_input.at(1);
+        for (auto j = 0ull; j < kChainLength; ++j) {
+          share_chain = j % 4 < 2 ? share_chain ^ share_input.at(0) : ~share_chain;
+        }
+        auto share_output = (share_chain & share_input.at(1)).Out();
+
+        motion_parties.at(party_id)->Run();
+
+        auto wire = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_output->GetWires().at(0));
+        assert(wire);
+        EXPECT_EQ(wire->GetValues().Get(0),
+                  (global_input.at(0) != global_input.at(1)) && global_input.at(1));
+
+        motion_parties.at(party_id)->Finish();
+      }
+    } catch (std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    }
+  }
+}
+
+TEST(BooleanGmw, ReclaimWireStorage_1K_Simd_2_parties) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2, kNumberOfSimd = 1000;
+  for (auto i = 0ull; i < kTestIterations; ++i) {
+    const std::vector<encrypto::motion::BitVector<>> global_input{
+        encrypto::motion::BitVector<>::SecureRandom(kNumberOfSimd),
+        encrypto::motion::BitVector<>::SecureRandom(kNumberOfSimd)};
+    const encrypto::motion::BitVector<> dummy_input(kNumberOfSimd, false);
+    try {
+      std::vector<PartyPointer> motion_parties(
+          std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+      for (auto& party : motion_parties) {
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        party->GetConfiguration()->SetOnlineAfterSetup(i % 2 == 1);
+        party->GetConfiguration()->SetReclaimWireStorage(true);
+      }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+      for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+        std::vector<encrypto::motion::ShareWrapper> share_input;
+        for (auto j = 0ull; j < kNumberOfParties; ++j) {
+          const auto& input = j == party_id ? global_input.at(j) : dummy_input;
+          share_input.push_back(motion_parties.at(party_id)->In<kBooleanGmw>(input, j));
+        }
+
+        auto share_xor = share_input.at(0) ^ share_input.at(1);
+        auto share_output = (share_xor & share_input.at(1)).Out();
+
+        motion_parties.at(party_id)->Run();
+
+        // the intermediate wire was released after the AND gate consumed it
+        auto xor_wire = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_xor->GetWires().at(0));
+        assert(xor_wire);
+        EXPECT_TRUE(xor_wire->GetValues().Empty());
+
+        auto wire = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_output->GetWires().at(0));
+        assert(wire);
+        EXPECT_EQ(wire->GetValues(),
+                  (global_input.at(0) ^ global_input.at(1)) & global_input.at(1));
+
+        motion_parties.at(party_id)->Finish();
+      }
+    } catch (std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    }
+  }
+}
+
+TEST(BooleanGmw, ReclaimWireStorageRejectsRepetitions_2_parties) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2;
+  const encrypto::motion::BitVector<> input(10, true);
+  std::vector<PartyPointer> motion_parties(
+      std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+  for (auto& party : motion_parties) {
+    party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+    party->GetConfiguration()->SetReclaimWireStorage(true);
+  }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+  for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+    encrypto::motion::ShareWrapper share_input(
+        motion_parties.at(party_id)->In<kBooleanGmw>(input, 0));
+    auto share_output = (share_input ^ share_input).Out();
+
+    // the released wire values would be missing in the second repetition
+    EXPECT_THROW(motion_parties.at(party_id)->Run(2), std::logic_error);
+
+    motion_parties.at(party_id)->Run();
+    motion_parties.at(party_id)->Finish();
+  }
+}
+
+TEST(BooleanGmw, Profiling_2_parties) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfParties = 2, kNumberOfSimd = 100;
+  const encrypto::motion::BitVector<> input(kNumberOfSimd, true);
+  try {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetProfiling(true);
+    }
+#pragma omp parallel for num_threads(motion_parties.size() + 1)
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      encrypto::motion::ShareWrapper share_a =
+          motion_parties.at(party_id)->In<kBooleanGmw>(input, 0);
+      encrypto::motion::ShareWrapper share_b =
+          motion_parties.at(party_id)->In<kBooleanGmw>(input, 1);
+      auto share_output = ((share_a ^ share_b) & share_b).Out();
+
+      motion_parties.at(party_id)->Run();
+
+      const auto& statistics =
+          motion_parties.at(party_id)->GetBackend()->GetRunTimeStatistics().back();
+      // inputs and XOR, AND, output
+      EXPECT_EQ(statistics.layers.size(), 3u);
+      std::size_t number_of_and_gates = 0;
+      for (const auto& [name, gate_type] : statistics.gate_types) {
+        if (name.find("boolean_gmw::AndGate") != std::string::npos) {
+          number_of_and_gates += gate_type.number_of_gates;
+          EXPECT_GE(gate_type.online_time, gate_type.online_wait_time);
+        }
+      }
+      EXPECT_EQ(number_of_and_gates, 1u);
+
+      // the output gate waited for the output message of the other party
+      const auto transport_statistics =
+          motion_parties.at(party_id)->GetCommunicationLayer().GetTransportStatistics();
+      const auto output_message_index =
+          static_cast<std::size_t>(encrypto::motion::communication::MessageType::kOutputMessage);
+      EXPECT_GE(transport_statistics.at(0)
+                    .message_types.at(output_message_index)
+                    .number_of_messages_received,
+                1u);
+
+      const auto json = encrypto::motion::PrintJson(statistics, transport_statistics);
+      EXPECT_EQ(json.front(), '{');
+      EXPECT_NE(json.find("\"kOutputMessage\""), std::string::npos);
+      const auto trace = encrypto::motion::PrintChromeTrace(statistics, party_id);
+      EXPECT_NE(trace.find("\"Circuit Evaluation\""), std::string::npos);
+
+      motion_parties.at(party_id)->Finish();
+    }
+  } catch (std::exception& e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+
 TEST(BooleanGmw, Mux_1K_Simd_2_3_parties) {
   constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
   std::srand(std::time(nullptr));
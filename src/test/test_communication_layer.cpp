@@ -158,3 +158,82 @@ TEST_P(CommunicationLayerTest, Tcp) {
 
 INSTANTIATE_TEST_SUITE_P(CommunicationLayerTcpTests, CommunicationLayerTest, testing::Bool(),
                          [](auto& info) { return info.param ? "ipv6" : "ipv4"; });
+
+TEST(CommunicationLayer, CoalescesQueuedMessages) {
+  constexpr std::size_t kNumberOfMessages = 200;
+  auto communication_layers =
+      encrypto::motion::communication::MakeLocalTcpCommunicationLayers(2, false);
+  auto& communication_layer_alice = communication_layers.at(0);
+  auto& communication_layer_bob = communication_layers.at(1);
+
+  communication_layer_bob->RegisterFallbackMessageHandler([](auto party_id) {
+    return std::make_shared<encrypto::motion::communication::QueueHandler>();
+  });
+  auto& queue_handler_bob = dynamic_cast<encrypto::motion::communication::QueueHandler&>(
+      communication_layer_bob->GetFallbackMessageHandler(0));
+
+  // small messages with a large one in between, which is not copied by the transport. They are
+  // all queued before the send thread starts, so it finds them in the queue at once and the test
+  // does not depend on scheduling.
+  std::vector<std::vector<std::uint8_t>> messages;
+  for (std::size_t i = 0; i < kNumberOfMessages; ++i) {
+    std::size_t message_size = i == kNumberOfMessages / 2 ? 100000 : 1 + i % 64;
+    messages.emplace_back(message_size, static_cast<std::uint8_t>(i));
+    communication_layer_alice->SendMessage(1, messages.back());
+  }
+
+  std::for_each(std::begin(communication_layers), std::end(communication_layers),
+                [](auto& cl) { cl->Start(); });
+
+  for (std::size_t i = 0; i < kNumberOfMessages; ++i) {
+    auto received_message = queue_handler_bob.GetQueue().dequeue();
+    EXPECT_EQ(received_message, messages.at(i));
+  }
+
+  // shutdown all commmunication layers
+  std::vector<std::future<void>> futures;
+  for (auto& cl : communication_layers) {
+    futures.emplace_back(std::async(std::launch::async, [&cl] { cl->Shutdown(); }));
+  }
+  std::for_each(std::begin(futures), std::end(futures), [](auto& f) { f.get(); });
+
+  const auto statistics_alice = communication_layer_alice->GetTransportStatistics().at(0);
+  const auto statistics_bob = communication_layer_bob->GetTransportStatistics().at(0);
+  EXPECT_GE(statistics_alice.number_of_messages_sent, kNumberOfMessages);
+  EXPECT_LT(statistics_alice.number_of_write_operations, kNumberOfMessages / 10);
+  EXPECT_LT(statistics_bob.number_of_read_operations, kNumberOfMessages / 4);
+}
+
+TEST(ReceiveBufferPool, ReusesReleasedSlabs) {
+  encrypto::motion::communication::ReceiveBufferPool pool(1024, 2);
+  auto slab = pool.GetSlab();
+  ASSERT_EQ(slab->size(), 1024);
+  const auto* slab_data = slab->data();
+  std::fill(slab->begin(), slab->end(), 0x42);
+
+  // the slab is only released once the last view into it is gone
+  encrypto::motion::communication::MessageView view(slab, 100, 10);
+  slab.reset();
+  EXPECT_EQ(view.size(), 10);
+  EXPECT_EQ(view.data(), slab_data + 100);
+  EXPECT_EQ(std::move(view).ToVector(), std::vector<std::uint8_t>(10, 0x42));
+  EXPECT_TRUE(view.empty());
+
+  auto reused_slab = pool.GetSlab();
+  EXPECT_EQ(reused_slab->data(), slab_data);
+
+  // slabs for larger frames are rounded up to a multiple of the slab size and reused by size
+  auto large_slab = pool.GetSlab(2500);
+  ASSERT_EQ(large_slab->size(), 3 * 1024);
+  const auto* large_slab_data = large_slab->data();
+  large_slab.reset();
+  EXPECT_NE(pool.GetSlab()->data(), large_slab_data);
+  EXPECT_EQ(pool.GetSlab(3 * 1024)->data(), large_slab_data);
+
+  // a view covering a whole buffer it owns exclusively moves the buffer out
+  std::vector<std::uint8_t> message(100, 0x23);
+  const auto* message_data = message.data();
+  encrypto::motion::communication::MessageView message_view(std::move(message));
+  auto moved_message = std::move(message_view).ToVector();
+  EXPECT_EQ(moved_message.data(), message_data);
+}
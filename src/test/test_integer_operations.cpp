@@ -22,12 +22,17 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <cstddef>
+#include <filesystem>
 #include <fstream>
 #include <random>
 
 #include <gtest/gtest.h>
 
 #include "algorithm/algorithm_description.h"
+#include "algorithm/binary_circuit.h"
+#include "algorithm/circuit_loader.h"
+#include "algorithm/layered_circuit.h"
 #include "base/party.h"
 #include "protocols/bmr/bmr_wire.h"
 #include "protocols/boolean_gmw/boolean_gmw_wire.h"
@@ -79,6 +84,230 @@ TEST(AlgorithmDescription, FromBristolFormatIntAdd8Size) {
   EXPECT_EQ(gate33.selection_bit.has_value(), false);
 }
 
+TEST(LayeredCircuit, FromBristolFormatIntAdd8Size) {
+  const auto int_add8 = encrypto::motion::AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol");
+  const auto circuit{encrypto::motion::LayeredCircuit::FromAlgorithmDescription(int_add8)};
+  EXPECT_EQ(circuit.number_of_input_wires, 16);
+  EXPECT_EQ(circuit.number_of_output_wires, 8);
+  EXPECT_EQ(circuit.number_of_wires, 50);
+  EXPECT_EQ(circuit.number_of_gates, 34);
+  EXPECT_EQ(circuit.number_of_and_gates, 7);
+  EXPECT_EQ(circuit.and_depth, 7);
+  EXPECT_EQ(circuit.GetNumberOfLayers(), 8);
+  EXPECT_EQ(circuit.types.size(), 34);
+  EXPECT_EQ(circuit.batch_offsets.back(), 34);
+
+  std::vector<bool> is_computed(circuit.number_of_wires, false);
+  for (std::size_t i = 0; i < circuit.number_of_input_wires; ++i) is_computed.at(i) = true;
+  for (std::size_t batch_i = 0; batch_i < circuit.GetNumberOfBatches(); ++batch_i) {
+    const auto begin{circuit.batch_offsets.at(batch_i)}, end{circuit.batch_offsets.at(batch_i + 1)};
+    EXPECT_LT(begin, end);
+    // all gates of a batch only depend on the previous batches
+    for (auto gate_i = begin; gate_i < end; ++gate_i) {
+      EXPECT_TRUE(is_computed.at(circuit.parents_a.at(gate_i)));
+      EXPECT_TRUE(is_computed.at(circuit.parents_b.at(gate_i)));
+      EXPECT_GE(circuit.last_use.at(circuit.parents_a.at(gate_i)), batch_i);
+      if (!circuit.IsInteractiveBatch(batch_i)) {
+        EXPECT_EQ(circuit.types.at(gate_i), circuit.types.at(begin));
+      }
+    }
+    for (auto gate_i = begin; gate_i < end; ++gate_i) {
+      is_computed.at(circuit.output_wires.at(gate_i)) = true;
+    }
+  }
+  for (std::size_t i = circuit.number_of_wires - circuit.number_of_output_wires;
+       i < circuit.number_of_wires; ++i) {
+    EXPECT_EQ(circuit.last_use.at(i), encrypto::motion::LayeredCircuit::kPinned);
+  }
+}
+
+TEST(BinaryCircuit, RoundTripIntAdd8Size) {
+  const auto int_add8 = encrypto::motion::AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol");
+  const auto path{(std::filesystem::temp_directory_path() / "motion_test_int_add8_size.mbc")};
+  encrypto::motion::WriteBinaryCircuit(int_add8, path.string());
+
+  const auto expected{encrypto::motion::LayeredCircuit::FromAlgorithmDescription(int_add8)};
+  {
+    const encrypto::motion::MappedCircuit mapped_circuit(path.string());
+    EXPECT_EQ(mapped_circuit.GetHeader().number_of_input_wires_parent_a, 8);
+    EXPECT_EQ(mapped_circuit.GetHeader().number_of_input_wires_parent_b, 8);
+    EXPECT_EQ(mapped_circuit.GetGates().size(), 34);
+    EXPECT_EQ(mapped_circuit.GetLayerOffsets().size(), expected.layer_offsets.size());
+
+    const auto circuit{mapped_circuit.ToLayeredCircuit()};
+    EXPECT_EQ(circuit.number_of_input_wires, expected.number_of_input_wires);
+    EXPECT_EQ(circuit.number_of_output_wires, expected.number_of_output_wires);
+    EXPECT_EQ(circuit.number_of_wires, expected.number_of_wires);
+    EXPECT_EQ(circuit.and_depth, expected.and_depth);
+    EXPECT_EQ(circuit.types, expected.types);
+    EXPECT_EQ(circuit.parents_a, expected.parents_a);
+    EXPECT_EQ(circuit.parents_b, expected.parents_b);
+    EXPECT_EQ(circuit.output_wires, expected.output_wires);
+    EXPECT_EQ(circuit.batch_offsets, expected.batch_offsets);
+    EXPECT_EQ(circuit.layer_offsets, expected.layer_offsets);
+    EXPECT_EQ(circuit.last_use, expected.last_use);
+  }
+
+  const auto algorithm{encrypto::motion::AlgorithmDescription::FromBinary(path.string())};
+  EXPECT_EQ(algorithm.number_of_gates, int_add8.number_of_gates);
+  EXPECT_EQ(algorithm.number_of_wires, int_add8.number_of_wires);
+  EXPECT_EQ(algorithm.number_of_output_wires, int_add8.number_of_output_wires);
+  ASSERT_TRUE(algorithm.number_of_input_wires_parent_b.has_value());
+  EXPECT_EQ(*algorithm.number_of_input_wires_parent_b, 8);
+  EXPECT_EQ(algorithm.gates.size(), int_add8.gates.size());
+
+  // truncated files are rejected
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  EXPECT_THROW(encrypto::motion::MappedCircuit{path.string()}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(BinaryCircuit, RejectsInconsistentSections) {
+  const auto int_add8 = encrypto::motion::AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol");
+  const auto path{(std::filesystem::temp_directory_path() / "motion_test_valid.mbc")};
+  const auto corrupted_path{(std::filesystem::temp_directory_path() / "motion_test_corrupted.mbc")};
+  encrypto::motion::WriteBinaryCircuit(int_add8, path.string());
+
+  // overwrites the bytes at offset in a copy of the valid file
+  const auto expect_rejected = [&path, &corrupted_path](std::size_t offset, auto value) {
+    std::filesystem::copy_file(path, corrupted_path,
+                               std::filesystem::copy_options::overwrite_existing);
+    {
+      std::fstream stream(corrupted_path, std::ios::binary | std::ios::in | std::ios::out);
+      stream.seekp(offset);
+      stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    EXPECT_THROW(encrypto::motion::MappedCircuit{corrupted_path.string()}, std::runtime_error);
+  };
+
+  const encrypto::motion::MappedCircuit mapped_circuit(path.string());
+  const auto& header{mapped_circuit.GetHeader()};
+  const auto gates{mapped_circuit.GetGates()};
+  const auto batch_offsets{mapped_circuit.GetBatchOffsets()};
+  ASSERT_GE(batch_offsets.size(), 3);
+  const std::size_t gates_offset{sizeof(encrypto::motion::BinaryCircuitHeader)};
+  const std::size_t batch_offsets_offset{gates_offset +
+                                         gates.size() * sizeof(encrypto::motion::BinaryGateRecord)};
+  const std::size_t layer_offsets_offset{batch_offsets_offset +
+                                         batch_offsets.size() * sizeof(std::uint64_t)};
+  const std::size_t last_use_offset{
+      layer_offsets_offset + mapped_circuit.GetLayerOffsets().size() * sizeof(std::uint64_t)};
+
+  // more input wires than wires
+  expect_rejected(offsetof(encrypto::motion::BinaryCircuitHeader, number_of_input_wires_parent_a),
+                  std::uint64_t{header.number_of_wires + 1});
+  expect_rejected(offsetof(encrypto::motion::BinaryCircuitHeader, number_of_and_gates),
+                  std::uint64_t{header.number_of_and_gates + 1});
+  // the first gate reads its own output wire
+  expect_rejected(gates_offset + offsetof(encrypto::motion::BinaryGateRecord, parent_a),
+                  std::uint32_t{gates.front().output_wire});
+  // an empty batch
+  expect_rejected(batch_offsets_offset + sizeof(std::uint64_t), std::uint64_t{batch_offsets[2]});
+  expect_rejected(layer_offsets_offset, std::uint64_t{1});
+  // an output wire that is released
+  expect_rejected(last_use_offset + (header.number_of_wires - 1) * sizeof(std::uint32_t),
+                  std::uint32_t{0});
+  // a wire that is released before the last batch reads it
+  expect_rejected(last_use_offset + gates.back().parent_a * sizeof(std::uint32_t),
+                  std::uint32_t{0});
+
+  std::filesystem::remove(corrupted_path);
+  std::filesystem::remove(path);
+}
+
+TEST(CircuitLoader, ParsesEachCircuitOnce) {
+  auto& circuit_loader{encrypto::motion::CircuitLoader::GetInstance()};
+  const auto path{std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol"};
+  const auto algorithm_0{circuit_loader.GetAlgorithmDescription(path)};
+  const auto algorithm_1{circuit_loader.GetAlgorithmDescription(path)};
+  const auto circuit_0{circuit_loader.GetLayeredCircuit(path)};
+  const auto circuit_1{circuit_loader.GetLayeredCircuit(path)};
+  EXPECT_EQ(algorithm_0, algorithm_1);
+  EXPECT_EQ(circuit_0, circuit_1);
+  EXPECT_EQ(algorithm_0->number_of_gates, 34);
+  EXPECT_EQ(circuit_0->number_of_gates, 34);
+  EXPECT_GE(circuit_loader.GetNumberOfCachedCircuits(), 1);
+  EXPECT_THROW(circuit_loader.GetLayeredCircuit(path + ".missing"), std::runtime_error);
+}
+
+TEST(CircuitLoader, CachesEachFormatSeparately) {
+  auto& circuit_loader{encrypto::motion::CircuitLoader::GetInstance()};
+  const auto path{std::string(encrypto::motion::kRootDir) + "/circuits/int/int_add8_size.bristol"};
+  const auto circuit{circuit_loader.GetLayeredCircuit(path)};
+  EXPECT_EQ(circuit->number_of_gates, 34);
+  // the Bristol parse must not be handed out for a request of another format
+  EXPECT_THROW(circuit_loader.GetLayeredCircuit(path, encrypto::motion::CircuitFormat::kBinary),
+               std::runtime_error);
+  EXPECT_THROW(
+      circuit_loader.GetAlgorithmDescription(path, encrypto::motion::CircuitFormat::kBinary),
+      std::runtime_error);
+  EXPECT_EQ(circuit_loader.GetLayeredCircuit(path), circuit);
+}
+
+TEST(ShareWrapper, LayerBatchedEvaluationEqualsGateByGateEvaluation) {
+  constexpr auto kBooleanGmw = encrypto::motion::MpcProtocol::kBooleanGmw;
+  constexpr std::size_t kNumberOfSimd{3};
+  using T = std::uint16_t;
+  constexpr auto kNumberOfWires{sizeof(T) * 8};
+  // the division circuit contains AND, OR, XOR, and INV gates
+  const auto algorithm{encrypto::motion::AlgorithmDescription::FromBristol(
+      std::string(encrypto::motion::kRootDir) + "/circuits/int/int_div16_size.bristol")};
+  std::mt19937 mersenne_twister(kNumberOfSimd);
+  std::uniform_int_distribution<T> distribution(1, std::numeric_limits<T>::max());
+  auto random = std::bind(distribution, mersenne_twister);
+  const std::vector<std::vector<T>> raw_global_input(
+      2, std::vector<T>{random(), random(), random()});
+  std::vector<std::vector<encrypto::motion::BitVector<>>> global_input{
+      encrypto::motion::ToInput(raw_global_input.at(0)),
+      encrypto::motion::ToInput(raw_global_input.at(1))};
+  std::vector<encrypto::motion::BitVector<>> dummy_input(
+      kNumberOfWires, encrypto::motion::BitVector<>(kNumberOfSimd, false));
+
+  std::vector<PartyPointer> motion_parties(std::move(MakeLocallyConnectedParties(2, kPortOffset)));
+  for (auto& party : motion_parties) {
+    party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+    party->GetConfiguration()->SetOnlineAfterSetup(true);
+  }
+  std::vector<std::thread> threads;
+  for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+    threads.emplace_back([party_id, &motion_parties, &algorithm, &global_input, &dummy_input,
+                          &raw_global_input]() {
+      const bool party_0 = motion_parties.at(party_id)->GetConfiguration()->GetMyId() == 0;
+      encrypto::motion::ShareWrapper
+          share_0 = party_0 ? motion_parties.at(party_id)->In<kBooleanGmw>(global_input.at(0), 0)
+                            : motion_parties.at(party_id)->In<kBooleanGmw>(dummy_input, 0),
+          share_1 = party_0 ? motion_parties.at(party_id)->In<kBooleanGmw>(dummy_input, 1)
+                            : motion_parties.at(party_id)->In<kBooleanGmw>(global_input.at(1), 1);
+      const auto input{encrypto::motion::ShareWrapper::Concatenate(
+          std::vector<encrypto::motion::ShareWrapper>{share_0, share_1})};
+
+      auto share_output_batched =
+          input.Evaluate(algorithm, encrypto::motion::CircuitEvaluationMode::kLayerBatched).Out();
+      auto share_output_gate_by_gate =
+          input.Evaluate(algorithm, encrypto::motion::CircuitEvaluationMode::kGateByGate).Out();
+
+      motion_parties.at(party_id)->Run();
+
+      std::vector<T> result_check(kNumberOfSimd);
+      for (auto i = 0ull; i < kNumberOfSimd; ++i) {
+        result_check.at(i) = raw_global_input.at(0).at(i) / raw_global_input.at(1).at(i);
+      }
+      const auto result_batched{encrypto::motion::ToVectorOutput<T>(
+          share_output_batched.As<std::vector<encrypto::motion::BitVector<>>>())};
+      const auto result_gate_by_gate{encrypto::motion::ToVectorOutput<T>(
+          share_output_gate_by_gate.As<std::vector<encrypto::motion::BitVector<>>>())};
+      EXPECT_EQ(result_batched, result_check);
+      EXPECT_EQ(result_gate_by_gate, result_check);
+      motion_parties.at(party_id)->Finish();
+    });
+  }
+  for (auto& t : threads)
+    if (t.joinable()) t.join();
+}
+
 // TODO: rewrite as generic tests
 template <typename T>
 class SecureUintTest : public ::testing::Test {
@@ -909,4 +1138,211 @@ TYPED_TEST(SecureUintTest, GreaterThanInBmr) {
     if (t.joinable()) t.join();
 }
 
+TYPED_TEST(SecureUintTest, EqualityInArithmeticGmw) {
+  using T = TypeParam;
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  std::mt19937 mersenne_twister(sizeof(T));
+  std::uniform_int_distribution<T> distribution(0, std::numeric_limits<T>::max());
+  auto random = std::bind(distribution, mersenne_twister);
+  constexpr T kMax{std::numeric_limits<T>::max()};
+  const T equal_value{random()};
+  const std::vector<std::vector<T>> raw_global_input{{random(), kMax, 0, equal_value, 1},
+                                                     {random(), 0, kMax, equal_value, 0}};
+  const std::vector<T> dummy_input(raw_global_input.at(0).size(), 0);
+
+  for (auto number_of_parties : {2u, 3u}) {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(true);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &raw_global_input, &dummy_input]() {
+        const auto my_id = motion_parties.at(party_id)->GetConfiguration()->GetMyId();
+        encrypto::motion::SecureUnsignedInteger
+            share_0 = motion_parties.at(party_id)->In<kArithmeticGmw>(
+                my_id == 0 ? raw_global_input.at(0) : dummy_input, 0),
+            share_1 = motion_parties.at(party_id)->In<kArithmeticGmw>(
+                my_id == 1 ? raw_global_input.at(1) : dummy_input, 1);
+
+        const auto share_equal = share_0 == share_1;
+        EXPECT_EQ(share_equal->GetProtocol(), encrypto::motion::MpcProtocol::kBooleanGmw);
+        auto share_output = share_equal.Out();
+        assert(share_output->GetBitLength() == 1);
+
+        motion_parties.at(party_id)->Run();
+
+        auto wire_single = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_output->GetWires().at(0));
+        assert(wire_single);
+        for (auto simd_i = 0ull; simd_i < raw_global_input.at(0).size(); ++simd_i) {
+          const bool result_check{raw_global_input.at(0).at(simd_i) ==
+                                  raw_global_input.at(1).at(simd_i)};
+          EXPECT_EQ(wire_single->GetValues()[simd_i], result_check);
+        }
+
+        motion_parties.at(party_id)->Finish();
+      });
+    }
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+  }
+}
+
+TYPED_TEST(SecureUintTest, GreaterThanInArithmeticGmw) {
+  using T = TypeParam;
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  std::mt19937 mersenne_twister(sizeof(T));
+  std::uniform_int_distribution<T> distribution(0, std::numeric_limits<T>::max());
+  auto random = std::bind(distribution, mersenne_twister);
+  constexpr T kMax{std::numeric_limits<T>::max()};
+  constexpr T kHalf{kMax / 2};
+  const T equal_value{random()};
+  // the full range of T is allowed, including differences that overflow the signed range
+  const std::vector<std::vector<T>> raw_global_input{
+      {random(), random(), kMax, 0, equal_value, kHalf + 1, kHalf, 1},
+      {random(), random(), 0, kMax, equal_value, kHalf, kHalf + 1, 0}};
+  const std::vector<T> dummy_input(raw_global_input.at(0).size(), 0);
+
+  for (auto number_of_parties : {2u, 3u}) {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(true);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &raw_global_input, &dummy_input]() {
+        const auto my_id = motion_parties.at(party_id)->GetConfiguration()->GetMyId();
+        encrypto::motion::SecureUnsignedInteger
+            share_0 = motion_parties.at(party_id)->In<kArithmeticGmw>(
+                my_id == 0 ? raw_global_input.at(0) : dummy_input, 0),
+            share_1 = motion_parties.at(party_id)->In<kArithmeticGmw>(
+                my_id == 1 ? raw_global_input.at(1) : dummy_input, 1);
+
+        const auto share_greater = share_0 > share_1;
+        EXPECT_EQ(share_greater->GetProtocol(), encrypto::motion::MpcProtocol::kBooleanGmw);
+        auto share_output = share_greater.Out();
+        assert(share_output->GetBitLength() == 1);
+
+        motion_parties.at(party_id)->Run();
+
+        auto wire_single = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_output->GetWires().at(0));
+        assert(wire_single);
+        for (auto simd_i = 0ull; simd_i < raw_global_input.at(0).size(); ++simd_i) {
+          const bool result_check{raw_global_input.at(0).at(simd_i) >
+                                  raw_global_input.at(1).at(simd_i)};
+          EXPECT_EQ(wire_single->GetValues()[simd_i], result_check);
+        }
+
+        motion_parties.at(party_id)->Finish();
+      });
+    }
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+  }
+}
+
+TYPED_TEST(SecureUintTest, LessThanZeroInArithmeticGmw) {
+  using T = TypeParam;
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  std::mt19937 mersenne_twister(sizeof(T));
+  std::uniform_int_distribution<T> distribution(0, std::numeric_limits<T>::max());
+  auto random = std::bind(distribution, mersenne_twister);
+  constexpr T kMax{std::numeric_limits<T>::max()};
+  constexpr T kHalf{kMax / 2};
+  // the values around the boundaries of the signed range
+  const std::vector<T> raw_global_input{random(), random(), 0, 1, kHalf, kHalf + 1, kMax};
+  const std::vector<T> dummy_input(raw_global_input.size(), 0);
+
+  for (auto number_of_parties : {2u, 3u}) {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(true);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &raw_global_input, &dummy_input]() {
+        const auto my_id = motion_parties.at(party_id)->GetConfiguration()->GetMyId();
+        encrypto::motion::ShareWrapper share_input{motion_parties.at(party_id)->In<kArithmeticGmw>(
+            my_id == 0 ? raw_global_input : dummy_input, 0)};
+
+        const auto share_negative = share_input.LessThanZero();
+        EXPECT_EQ(share_negative->GetProtocol(), encrypto::motion::MpcProtocol::kBooleanGmw);
+        auto share_output = share_negative.Out();
+        assert(share_output->GetBitLength() == 1);
+
+        motion_parties.at(party_id)->Run();
+
+        auto wire_single = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+            share_output->GetWires().at(0));
+        assert(wire_single);
+        for (auto simd_i = 0ull; simd_i < raw_global_input.size(); ++simd_i) {
+          const bool result_check{raw_global_input.at(simd_i) > kHalf};
+          EXPECT_EQ(wire_single->GetValues()[simd_i], result_check);
+        }
+
+        motion_parties.at(party_id)->Finish();
+      });
+    }
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+  }
+}
+
+TYPED_TEST(SecureUintTest, BitDecompositionInArithmeticGmw) {
+  using T = TypeParam;
+  constexpr auto kArithmeticGmw = encrypto::motion::MpcProtocol::kArithmeticGmw;
+  constexpr auto kNumberOfWires{sizeof(T) * 8};
+  std::mt19937 mersenne_twister(sizeof(T));
+  std::uniform_int_distribution<T> distribution(0, std::numeric_limits<T>::max());
+  auto random = std::bind(distribution, mersenne_twister);
+  constexpr T kMax{std::numeric_limits<T>::max()};
+  const std::vector<T> raw_global_input{random(), random(), 0, 1, kMax / 2 + 1, kMax};
+  const std::vector<T> dummy_input(raw_global_input.size(), 0);
+
+  for (auto number_of_parties : {2u, 3u}) {
+    std::vector<PartyPointer> motion_parties(
+        std::move(MakeLocallyConnectedParties(number_of_parties, kPortOffset)));
+    for (auto& party : motion_parties) {
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetConfiguration()->SetOnlineAfterSetup(true);
+    }
+    std::vector<std::thread> threads;
+    for (auto party_id = 0u; party_id < motion_parties.size(); ++party_id) {
+      threads.emplace_back([party_id, &motion_parties, &raw_global_input, &dummy_input]() {
+        const auto my_id = motion_parties.at(party_id)->GetConfiguration()->GetMyId();
+        encrypto::motion::ShareWrapper share_input{motion_parties.at(party_id)->In<kArithmeticGmw>(
+            my_id == 0 ? raw_global_input : dummy_input, 0)};
+
+        const auto share_bits = share_input.BitDecomposition();
+        EXPECT_EQ(share_bits->GetProtocol(), encrypto::motion::MpcProtocol::kBooleanGmw);
+        auto share_output = share_bits.Out();
+        assert(share_output->GetBitLength() == kNumberOfWires);
+
+        motion_parties.at(party_id)->Run();
+
+        std::vector<encrypto::motion::BitVector<>> output;
+        for (auto i = 0ull; i < kNumberOfWires; ++i) {
+          auto wire_single = std::dynamic_pointer_cast<encrypto::motion::proto::boolean_gmw::Wire>(
+              share_output->GetWires().at(i));
+          assert(wire_single);
+          output.emplace_back(wire_single->GetValues());
+        }
+        EXPECT_EQ(encrypto::motion::ToVectorOutput<T>(output), raw_global_input);
+
+        motion_parties.at(party_id)->Finish();
+      });
+    }
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+  }
+}
+
 }  // namespace
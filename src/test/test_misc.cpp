@@ -22,15 +22,20 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <array>
+#include <atomic>
 #include <future>
 #include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <boost/fiber/operations.hpp>
 
 #include "test_constants.h"
+#include "utility/arena.h"
 #include "utility/bit_vector.h"
 #include "utility/condition.h"
+#include "utility/fiber_thread_pool/fiber_thread_pool.hpp"
 
 namespace {
 TEST(Condition, WaitNotifyOne) {
@@ -262,4 +267,45 @@ TEST(InputOutputUnVectorization, VectorsOfUnsignedIntegers) {
   EXPECT_EQ(kV64, v64_check);
 }
 
-}  // namespace
\ No newline at end of file
+TEST(FiberThreadPool, ReusedAcrossRuns) {
+  constexpr std::size_t kNumberOfTasks = 100;
+  encrypto::motion::FiberThreadPool fiber_pool(2);
+  EXPECT_EQ(fiber_pool.get_number_of_workers(), 2);
+
+  std::atomic<std::size_t> counter = 0;
+  for (std::size_t run = 1; run <= 3; ++run) {
+    for (std::size_t i = 0; i < kNumberOfTasks; ++i) {
+      fiber_pool.post([&counter] {
+        boost::this_fiber::yield();
+        ++counter;
+      });
+    }
+    // all tasks of this run are done, but the pool stays open for the next one
+    fiber_pool.wait_idle();
+    EXPECT_EQ(counter, run * kNumberOfTasks);
+  }
+  fiber_pool.join();
+}
+
+TEST(Arena, ObjectsOutliveTheirOwner) {
+  auto arena = std::make_shared<encrypto::motion::Arena>(64);
+  auto first = std::allocate_shared<std::vector<std::uint64_t>>(
+      encrypto::motion::ArenaAllocator<std::vector<std::uint64_t>>(arena), 10, 42);
+  // exceeds the first block, so the arena has to allocate another one
+  auto second = std::allocate_shared<std::array<std::uint64_t, 32>>(
+      encrypto::motion::ArenaAllocator<std::array<std::uint64_t, 32>>(arena));
+  second->fill(7);
+  std::weak_ptr<encrypto::motion::Arena> weak_arena(arena);
+  arena.reset();
+
+  // the allocators in the control blocks keep the arena alive
+  EXPECT_FALSE(weak_arena.expired());
+  EXPECT_EQ(first->at(9), 42);
+  EXPECT_EQ(second->at(31), 7);
+  first.reset();
+  EXPECT_FALSE(weak_arena.expired());
+  second.reset();
+  EXPECT_TRUE(weak_arena.expired());
+}
+
+}  // namespace
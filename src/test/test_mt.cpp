@@ -26,8 +26,22 @@
 
 #include "test_constants.h"
 
+#include <array>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+
+#include <fmt/format.h>
+#include <unistd.h>
+
 #include "base/party.h"
 #include "multiplication_triple/mt_provider.h"
+#include "multiplication_triple/preprocessing_service.h"
+#include "multiplication_triple/preprocessing_store.h"
+#include "protocols/arithmetic_gmw/arithmetic_gmw_wire.h"
+#include "protocols/share_wrapper.h"
+#include "utility/helpers.h"
+
 namespace {
 
 constexpr auto kNumberOfPartiesList = {2u, 3u};
@@ -154,4 +168,433 @@ TEST(MultiplicationTriples, Integer) {
   TemplateTestInteger<std::uint64_t>();
 }
 
+std::string MakeStoreDirectory(const std::string& name) {
+  const auto directory{std::filesystem::temp_directory_path() /
+                       fmt::format("motion_test_{}_{}", name, ::getpid())};
+  std::filesystem::remove_all(directory);
+  return directory.string();
+}
+
+TEST(PreprocessingStore, PersistsConsumedMaterial) {
+  constexpr std::size_t kNumberOfMts = 100;
+  const auto directory{MakeStoreDirectory("store")};
+  encrypto::motion::IntegerMtVector<std::uint32_t> mts;
+  mts.a = encrypto::motion::RandomVector<std::uint32_t>(kNumberOfMts);
+  mts.b = encrypto::motion::RandomVector<std::uint32_t>(kNumberOfMts);
+  mts.c = encrypto::motion::RandomVector<std::uint32_t>(kNumberOfMts);
+  encrypto::motion::BinaryMtVector bit_mts{
+      encrypto::motion::BitVector<>::SecureRandom(kNumberOfMts),
+      encrypto::motion::BitVector<>::SecureRandom(kNumberOfMts),
+      encrypto::motion::BitVector<>::SecureRandom(kNumberOfMts)};
+  {
+    encrypto::motion::PreprocessingStore store(directory, 0, 2);
+    store.AppendMts(mts, kNumberOfMts);
+    store.AppendBinaryMts(bit_mts, kNumberOfMts);
+    const auto consumed{store.ConsumeMts<std::uint32_t>(30)};
+    EXPECT_EQ(consumed.a, std::vector(mts.a.begin(), mts.a.begin() + 30));
+    EXPECT_EQ(consumed.c, std::vector(mts.c.begin(), mts.c.begin() + 30));
+    EXPECT_EQ(store.ConsumeBinaryMts(16).b, bit_mts.b.Subset(0, 16));
+    // another store must not hand out the same material concurrently
+    EXPECT_THROW(encrypto::motion::PreprocessingStore(directory, 0, 2)
+                     .GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kMt32),
+                 std::runtime_error);
+  }
+  {
+    encrypto::motion::PreprocessingStore store(directory, 0, 2);
+    EXPECT_EQ(store.GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kMt32),
+              kNumberOfMts - 30);
+    const auto consumed{store.ConsumeMts<std::uint32_t>(kNumberOfMts - 30)};
+    EXPECT_EQ(consumed.b, std::vector(mts.b.begin() + 30, mts.b.end()));
+    EXPECT_THROW(store.ConsumeMts<std::uint32_t>(1), std::runtime_error);
+    EXPECT_EQ(store.ConsumeBinaryMts(4).a, bit_mts.a.Subset(16, 20));
+    EXPECT_EQ(store.ConsumeBinaryMts(80).c, bit_mts.c.Subset(20, kNumberOfMts));
+    EXPECT_THROW(store.ConsumeBinaryMts(1), std::runtime_error);
+  }
+  // the files of party 0 must not be used by party 1
+  std::filesystem::copy_file(std::filesystem::path(directory) / "mts_32_0_of_2.mpp",
+                             std::filesystem::path(directory) / "mts_32_1_of_2.mpp");
+  EXPECT_THROW(encrypto::motion::PreprocessingStore(directory, 1, 2)
+                   .CheckAvailable(encrypto::motion::PreprocessingMaterial::kMt32, 0),
+               std::runtime_error);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PreprocessingStore, ConsumesBinaryMtsBitExact) {
+  // neither append fills whole bytes, so a byte-wise store would pad them with zero MTs
+  constexpr std::array<std::size_t, 2> kNumberOfMts{5, 11};
+  const auto directory{MakeStoreDirectory("binary_mts")};
+  std::vector<encrypto::motion::BinaryMtVector> bit_mts;
+  for (const auto number_of_mts : kNumberOfMts) {
+    bit_mts.push_back({encrypto::motion::BitVector<>::SecureRandom(number_of_mts),
+                       encrypto::motion::BitVector<>::SecureRandom(number_of_mts),
+                       encrypto::motion::BitVector<>::SecureRandom(number_of_mts)});
+  }
+  {
+    encrypto::motion::PreprocessingStore store(directory, 0, 2);
+    for (std::size_t i = 0; i < kNumberOfMts.size(); ++i) {
+      store.AppendBinaryMts(bit_mts[i], kNumberOfMts[i]);
+    }
+    EXPECT_EQ(store.GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kBinaryMt),
+              kNumberOfMts[0] + kNumberOfMts[1]);
+    // 8 MTs span the end of the first append
+    const auto consumed{store.ConsumeBinaryMts(8)};
+    auto expected_a{bit_mts[0].a}, expected_b{bit_mts[0].b}, expected_c{bit_mts[0].c};
+    expected_a.Append(bit_mts[1].a.Subset(0, 3));
+    expected_b.Append(bit_mts[1].b.Subset(0, 3));
+    expected_c.Append(bit_mts[1].c.Subset(0, 3));
+    EXPECT_EQ(consumed.a, expected_a);
+    EXPECT_EQ(consumed.b, expected_b);
+    EXPECT_EQ(consumed.c, expected_c);
+  }
+  {
+    encrypto::motion::PreprocessingStore store(directory, 0, 2);
+    EXPECT_EQ(store.GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kBinaryMt),
+              kNumberOfMts[0] + kNumberOfMts[1] - 8);
+    const auto consumed{store.ConsumeBinaryMts(kNumberOfMts[0] + kNumberOfMts[1] - 8)};
+    EXPECT_EQ(consumed.a, bit_mts[1].a.Subset(3, kNumberOfMts[1]));
+    EXPECT_EQ(consumed.b, bit_mts[1].b.Subset(3, kNumberOfMts[1]));
+    EXPECT_EQ(consumed.c, bit_mts[1].c.Subset(3, kNumberOfMts[1]));
+    EXPECT_THROW(store.ConsumeBinaryMts(1), std::runtime_error);
+  }
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PreprocessingStore, GenerateAndConsumeMts) {
+  constexpr std::size_t kNumberOfMts = 1024;
+  constexpr std::size_t kNumberOfParties = 2;
+  const auto directory{MakeStoreDirectory("generate")};
+  std::vector<std::shared_ptr<encrypto::motion::PreprocessingStore>> stores;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    stores.emplace_back(std::make_shared<encrypto::motion::PreprocessingStore>(
+        directory, party_id, kNumberOfParties));
+  }
+
+  {
+    encrypto::motion::PreprocessingAmounts amounts;
+    amounts.number_of_binary_mts = kNumberOfMts;
+    amounts.number_of_mts_64 = kNumberOfMts;
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(
+          std::async(std::launch::async, [&party = motion_parties.at(party_id),
+                                          &store = *stores.at(party_id), &amounts] {
+            party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+            party->GetBackend()->GeneratePreprocessing(store, amounts);
+            party->Finish();
+          }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+
+  // two online jobs consume disjoint parts of the stored MTs without any OTs
+  for (std::size_t job = 0; job < 2; ++job) {
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      auto& backend = motion_parties.at(party_id)->GetBackend();
+      backend->SetPreprocessingStore(stores.at(party_id));
+      backend->GetMtProvider()->RequestBinaryMts(kNumberOfMts / 2);
+      backend->GetMtProvider()->RequestArithmeticMts<std::uint64_t>(kNumberOfMts / 2);
+      backend->GetMtProvider()->PreSetup();
+      backend->GetMtProvider()->Setup();
+      EXPECT_EQ(stores.at(party_id)->GetNumberOfAvailable(
+                    encrypto::motion::PreprocessingMaterial::kMt64),
+                kNumberOfMts / 2 * (1 - job));
+    }
+
+    const auto& mt_provider_0 = motion_parties.at(0)->GetBackend()->GetMtProvider();
+    const auto& mt_provider_1 = motion_parties.at(1)->GetBackend()->GetMtProvider();
+    const auto& bit_mts_0 = mt_provider_0->GetBinaryAll();
+    const auto& bit_mts_1 = mt_provider_1->GetBinaryAll();
+    EXPECT_EQ(bit_mts_0.c ^ bit_mts_1.c, (bit_mts_0.a ^ bit_mts_1.a) & (bit_mts_0.b ^ bit_mts_1.b));
+    const auto& mts_0 = mt_provider_0->GetIntegerAll<std::uint64_t>();
+    const auto& mts_1 = mt_provider_1->GetIntegerAll<std::uint64_t>();
+    ASSERT_EQ(mts_0.a.size(), kNumberOfMts / 2);
+    for (std::size_t k = 0; k < kNumberOfMts / 2; ++k) {
+      EXPECT_EQ(mts_0.c.at(k) + mts_1.c.at(k),
+                (mts_0.a.at(k) + mts_1.a.at(k)) * (mts_0.b.at(k) + mts_1.b.at(k)));
+    }
+
+    std::vector<std::future<void>> futures;
+    for (auto& party : motion_parties) {
+      futures.emplace_back(std::async(std::launch::async, [&party] { party->Finish(); }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+  stores.clear();
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PreprocessingStore, RejectsStoresOfOtherGenerationsOrOffsets) {
+  constexpr std::size_t kNumberOfMts = 64;
+  constexpr std::size_t kNumberOfParties = 2;
+  const auto directory{MakeStoreDirectory("generation")};
+  const auto other_directory{MakeStoreDirectory("other_generation")};
+  std::vector<std::shared_ptr<encrypto::motion::PreprocessingStore>> stores, other_stores;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    stores.emplace_back(std::make_shared<encrypto::motion::PreprocessingStore>(
+        directory, party_id, kNumberOfParties));
+    other_stores.emplace_back(std::make_shared<encrypto::motion::PreprocessingStore>(
+        other_directory, party_id, kNumberOfParties));
+  }
+
+  // runs job in all parties, which either all succeed or all throw
+  using Job = std::function<void(encrypto::motion::Backend&, std::size_t)>;
+  const auto run_parties = [](const Job& job, bool expect_throw) {
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+        auto& party = motion_parties.at(party_id);
+        party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        if (expect_throw) {
+          EXPECT_THROW(job(*party->GetBackend(), party_id), std::runtime_error);
+        } else {
+          job(*party->GetBackend(), party_id);
+        }
+        party->Finish();
+      }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  };
+  encrypto::motion::PreprocessingAmounts amounts;
+  amounts.number_of_mts_32 = kNumberOfMts;
+  const auto generate = [&amounts](auto& stores) {
+    return [&stores, &amounts](encrypto::motion::Backend& backend, std::size_t party_id) {
+      backend.GeneratePreprocessing(*stores.at(party_id), amounts);
+    };
+  };
+  const auto consume = [](auto& stores) {
+    return [&stores](encrypto::motion::Backend& backend, std::size_t party_id) {
+      backend.SetPreprocessingStore(stores.at(party_id));
+      backend.GetMtProvider()->RequestArithmeticMts<std::uint32_t>(kNumberOfMts / 4);
+      backend.RunPreprocessing();
+    };
+  };
+
+  run_parties(generate(stores), false);
+  const auto generation_id{
+      stores.at(0)->GetState(encrypto::motion::PreprocessingMaterial::kMt32).generation_id};
+  EXPECT_NE(generation_id, 0);
+  EXPECT_EQ(stores.at(1)->GetState(encrypto::motion::PreprocessingMaterial::kMt32).generation_id,
+            generation_id);
+
+  // a store that was filled again by a single party is not extended
+  const std::vector mixed_stores{stores.at(0), other_stores.at(1)};
+  run_parties(generate(mixed_stores), true);
+  EXPECT_EQ(other_stores.at(1)->GetState(encrypto::motion::PreprocessingMaterial::kMt32)
+                .number_of_records,
+            0);
+
+  // stores of different generations are not consumed, even if their offsets match
+  run_parties(generate(other_stores), false);
+  EXPECT_NE(
+      other_stores.at(0)->GetState(encrypto::motion::PreprocessingMaterial::kMt32).generation_id,
+      generation_id);
+  run_parties(consume(mixed_stores), true);
+
+  // neither are stores whose offsets differ, e.g., after a crash of a single party
+  run_parties(consume(stores), false);
+  stores.at(1)->ConsumeMts<std::uint32_t>(1);
+  run_parties(consume(stores), true);
+  EXPECT_EQ(stores.at(0)->GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kMt32),
+            kNumberOfMts - kNumberOfMts / 4);
+
+  stores.clear();
+  other_stores.clear();
+  std::filesystem::remove_all(directory);
+  std::filesystem::remove_all(other_directory);
+}
+
+TEST(PreprocessingStore, StreamingEvaluationConsumesMtsPerChunk) {
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfChunks = 4;
+  constexpr std::size_t kChunkSize = 64;
+  const auto directory{MakeStoreDirectory("streaming")};
+  std::vector<std::shared_ptr<encrypto::motion::PreprocessingStore>> stores;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    stores.emplace_back(std::make_shared<encrypto::motion::PreprocessingStore>(
+        directory, party_id, kNumberOfParties));
+  }
+
+  {
+    encrypto::motion::PreprocessingAmounts amounts;
+    amounts.number_of_mts_32 = kNumberOfChunks * kChunkSize;
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(
+          std::async(std::launch::async, [&party = motion_parties.at(party_id),
+                                          &store = *stores.at(party_id), &amounts] {
+            party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+            party->GetBackend()->GeneratePreprocessing(store, amounts);
+            party->Finish();
+          }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+
+  // party 0 inputs the chunks of a and party 1 the chunks of b
+  const auto input_a{encrypto::motion::RandomVector<std::uint32_t>(kNumberOfChunks * kChunkSize)};
+  const auto input_b{encrypto::motion::RandomVector<std::uint32_t>(kNumberOfChunks * kChunkSize)};
+  std::vector<std::uint32_t> output(kNumberOfChunks * kChunkSize);
+
+  auto motion_parties =
+      encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+  std::vector<std::future<void>> futures;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    futures.emplace_back(std::async(std::launch::async, [&, party_id] {
+      auto& party = motion_parties.at(party_id);
+      party->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+      party->GetBackend()->SetPreprocessingStore(stores.at(party_id));
+      party->RunStreaming(kNumberOfChunks, [&, party_id](std::size_t chunk_id) {
+        const auto chunk_begin = chunk_id * kChunkSize;
+        const auto& my_input = party_id == 0 ? input_a : input_b;
+        const std::vector<std::uint32_t> chunk(my_input.begin() + chunk_begin,
+                                               my_input.begin() + chunk_begin + kChunkSize);
+        const std::vector<std::uint32_t> dummy(kChunkSize, 0);
+        encrypto::motion::ShareWrapper a{
+            party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(
+                party_id == 0 ? chunk : dummy, 0)};
+        encrypto::motion::ShareWrapper b{
+            party->In<encrypto::motion::MpcProtocol::kArithmeticGmw>(
+                party_id == 1 ? chunk : dummy, 1)};
+        auto share_output = (a * b).Out(0);
+        return std::function<void()>([&, party_id, chunk_begin, share_output] {
+          if (party_id == 0) {
+            auto wire = std::dynamic_pointer_cast<
+                encrypto::motion::proto::arithmetic_gmw::Wire<std::uint32_t>>(
+                share_output->GetWires().at(0));
+            std::copy(wire->GetValues().begin(), wire->GetValues().end(),
+                      output.begin() + chunk_begin);
+          }
+        });
+      });
+      // every chunk consumed its own MTs
+      EXPECT_EQ(stores.at(party_id)->GetNumberOfAvailable(
+                    encrypto::motion::PreprocessingMaterial::kMt32),
+                0);
+      EXPECT_EQ(party->GetBackend()->GetRegister()->GetTotalNumberOfGates(), 0);
+      party->Finish();
+    }));
+  }
+  std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+
+  for (std::size_t i = 0; i < kNumberOfChunks * kChunkSize; ++i) {
+    EXPECT_EQ(output.at(i), static_cast<std::uint32_t>(input_a.at(i) * input_b.at(i)));
+  }
+  stores.clear();
+  std::filesystem::remove_all(directory);
+}
+
+// runs jobs that each consume number_of_mts_per_job MTs of a service that keeps between two and
+// three jobs' worth of binary MTs and between one and two jobs' worth of 32-bit MTs in stock
+void TestRefillsBetweenWatermarks(std::size_t number_of_mts_per_job, const std::string& name) {
+  constexpr std::size_t kNumberOfParties = 2;
+  constexpr std::size_t kNumberOfJobs = 5;
+  const auto directory{MakeStoreDirectory(name)};
+
+  // the services' parties are created pairwise, such that the i-th parties are connected
+  std::mutex parties_mutex;
+  std::array<std::deque<encrypto::motion::PartyPointer>, kNumberOfParties> parties;
+  const auto make_party = [&parties_mutex, &parties](std::size_t party_id) {
+    std::scoped_lock lock(parties_mutex);
+    if (parties.at(party_id).empty()) {
+      auto new_parties{
+          encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset)};
+      for (std::size_t i = 0; i < kNumberOfParties; ++i) {
+        new_parties.at(i)->GetLogger()->SetEnabled(kDetailedLoggingEnabled);
+        parties.at(i).push_back(std::move(new_parties.at(i)));
+      }
+    }
+    auto party{std::move(parties.at(party_id).front())};
+    parties.at(party_id).pop_front();
+    return party;
+  };
+
+  encrypto::motion::PreprocessingAmounts low_watermarks, high_watermarks;
+  low_watermarks.number_of_binary_mts = 2 * number_of_mts_per_job;
+  low_watermarks.number_of_mts_32 = number_of_mts_per_job;
+  high_watermarks.number_of_binary_mts = 3 * number_of_mts_per_job;
+  high_watermarks.number_of_mts_32 = 2 * number_of_mts_per_job;
+  std::vector<std::shared_ptr<encrypto::motion::PreprocessingStore>> stores;
+  std::vector<std::shared_ptr<encrypto::motion::PreprocessingService>> services;
+  for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+    stores.emplace_back(std::make_shared<encrypto::motion::PreprocessingStore>(
+        directory, party_id, kNumberOfParties));
+    services.emplace_back(std::make_shared<encrypto::motion::PreprocessingService>(
+        stores.back(), [&make_party, party_id] { return make_party(party_id); },
+        low_watermarks, high_watermarks));
+    services.back()->Start();
+  }
+
+  for (std::size_t job = 0; job < kNumberOfJobs; ++job) {
+    auto motion_parties =
+        encrypto::motion::MakeLocallyConnectedParties(kNumberOfParties, kPortOffset);
+    std::vector<std::future<void>> futures;
+    for (std::size_t party_id = 0; party_id < kNumberOfParties; ++party_id) {
+      futures.emplace_back(std::async(std::launch::async, [&party = motion_parties.at(party_id),
+                                                           &service = services.at(party_id),
+                                                           number_of_mts_per_job] {
+        auto& backend = party->GetBackend();
+        backend->SetPreprocessingService(service);
+        backend->GetMtProvider()->RequestBinaryMts(number_of_mts_per_job);
+        backend->GetMtProvider()->RequestArithmeticMts<std::uint32_t>(number_of_mts_per_job);
+        backend->GetMtProvider()->PreSetup();
+        backend->GetMtProvider()->Setup();
+      }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+
+    const auto& mt_provider_0 = motion_parties.at(0)->GetBackend()->GetMtProvider();
+    const auto& mt_provider_1 = motion_parties.at(1)->GetBackend()->GetMtProvider();
+    const auto& bit_mts_0 = mt_provider_0->GetBinaryAll();
+    const auto& bit_mts_1 = mt_provider_1->GetBinaryAll();
+    EXPECT_EQ(bit_mts_0.c ^ bit_mts_1.c, (bit_mts_0.a ^ bit_mts_1.a) & (bit_mts_0.b ^ bit_mts_1.b));
+    const auto& mts_0 = mt_provider_0->GetIntegerAll<std::uint32_t>();
+    const auto& mts_1 = mt_provider_1->GetIntegerAll<std::uint32_t>();
+    ASSERT_EQ(mts_0.a.size(), number_of_mts_per_job);
+    for (std::size_t k = 0; k < number_of_mts_per_job; ++k) {
+      EXPECT_EQ(static_cast<std::uint32_t>(mts_0.c.at(k) + mts_1.c.at(k)),
+                static_cast<std::uint32_t>((mts_0.a.at(k) + mts_1.a.at(k)) *
+                                           (mts_0.b.at(k) + mts_1.b.at(k))));
+    }
+
+    futures.clear();
+    for (auto& party : motion_parties) {
+      futures.emplace_back(std::async(std::launch::async, [&party] { party->Finish(); }));
+    }
+    std::for_each(futures.begin(), futures.end(), [](auto& f) { f.get(); });
+  }
+
+  // the services compute their queued refills before they are destroyed, after which the stores
+  // hold exactly what the services projected, which is always between the watermarks
+  services.clear();
+  for (const auto& store : stores) {
+    const auto binary_mts{
+        store->GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kBinaryMt)};
+    EXPECT_GE(binary_mts, low_watermarks.number_of_binary_mts);
+    EXPECT_LE(binary_mts, high_watermarks.number_of_binary_mts);
+    const auto mts_32{
+        store->GetNumberOfAvailable(encrypto::motion::PreprocessingMaterial::kMt32)};
+    EXPECT_GE(mts_32, low_watermarks.number_of_mts_32);
+    EXPECT_LE(mts_32, high_watermarks.number_of_mts_32);
+  }
+  stores.clear();
+  std::filesystem::remove_all(directory);
+}
+
+TEST(PreprocessingService, RefillsBetweenWatermarks) {
+  TestRefillsBetweenWatermarks(400, "service");
+}
+
+// none of the amounts is a multiple of 8, which a store of whole bytes of binary MTs would round
+TEST(PreprocessingService, RefillsOddAmountsBetweenWatermarks) {
+  TestRefillsBetweenWatermarks(101, "service_odd");
+}
+
 }  // namespace
@@ -22,14 +22,17 @@
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <array>
 #include <future>
 #include <memory>
 
 #include "base/motion_base_provider.h"
 #include "communication/communication_layer.h"
+#include "data_storage/ot_extension_data.h"
 #include "oblivious_transfer/base_ots/base_ot_provider.h"
 #include "oblivious_transfer/ot_flavors.h"
 #include "oblivious_transfer/ot_provider.h"
+#include "oblivious_transfer/silent_ot_provider.h"
 #include "utility/block.h"
 
 class OtFlavorTest : public ::testing::Test {
@@ -151,6 +154,171 @@ TEST_F(OtFlavorTest, XcOtBit) {
   ASSERT_EQ(receiver_output, sender_output ^ (choice_bits & correlations));
 }
 
+TEST_F(OtFlavorTest, XcOtBitAcrossOtExtensionChunks) {
+  // the second batch spans multiple chunks of the OT extension and ends in a partial chunk
+  constexpr std::array<std::size_t, 2> kNumberOfOts{
+      100, 2 * encrypto::motion::kOtExtensionChunkSize + 1000};
+  std::vector<encrypto::motion::BitVector<>> correlations, choice_bits;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitSender>> ot_senders;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitReceiver>> ot_receivers;
+  for (const auto number_of_ots : kNumberOfOts) {
+    correlations.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    choice_bits.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    ot_senders.emplace_back(GetSenderProvider().RegisterSendXcOtBit(number_of_ots));
+    ot_receivers.emplace_back(GetReceiverProvider().RegisterReceiveXcOtBit(number_of_ots));
+  }
+
+  RunOtExtensionSetup();
+
+  for (std::size_t i = 0; i < kNumberOfOts.size(); ++i) {
+    ot_senders[i]->SetCorrelations(correlations[i]);
+    ot_senders[i]->SendMessages();
+
+    ot_receivers[i]->SetChoices(choice_bits[i]);
+    ot_receivers[i]->SendCorrections();
+
+    ot_senders[i]->ComputeOutputs();
+    ot_receivers[i]->ComputeOutputs();
+    const auto sender_output = ot_senders[i]->GetOutputs();
+    const auto receiver_output = ot_receivers[i]->GetOutputs();
+
+    ASSERT_EQ(receiver_output, sender_output ^ (choice_bits[i] & correlations[i]));
+  }
+}
+
+TEST_F(OtFlavorTest, XcOtBitWithMultipleWorkers) {
+  // 3 workers do not divide the number of 128-column tiles of the chunks evenly
+  constexpr std::size_t kNumberOfWorkers = 3;
+  constexpr std::array<std::size_t, 2> kNumberOfOts{
+      1000, encrypto::motion::kOtExtensionChunkSize + 1000};
+  std::vector<encrypto::motion::BitVector<>> correlations, choice_bits;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitSender>> ot_senders;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitReceiver>> ot_receivers;
+  for (const auto number_of_ots : kNumberOfOts) {
+    correlations.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    choice_bits.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    ot_senders.emplace_back(GetSenderProvider().RegisterSendXcOtBit(number_of_ots));
+    ot_receivers.emplace_back(GetReceiverProvider().RegisterReceiveXcOtBit(number_of_ots));
+  }
+
+  GetSenderProvider().SetNumberOfWorkers(kNumberOfWorkers);
+  GetReceiverProvider().SetNumberOfWorkers(kNumberOfWorkers);
+  RunOtExtensionSetup();
+
+  for (std::size_t i = 0; i < kNumberOfOts.size(); ++i) {
+    ot_senders[i]->SetCorrelations(correlations[i]);
+    ot_senders[i]->SendMessages();
+
+    ot_receivers[i]->SetChoices(choice_bits[i]);
+    ot_receivers[i]->SendCorrections();
+
+    ot_senders[i]->ComputeOutputs();
+    ot_receivers[i]->ComputeOutputs();
+    const auto sender_output = ot_senders[i]->GetOutputs();
+    const auto receiver_output = ot_receivers[i]->GetOutputs();
+
+    ASSERT_EQ(receiver_output, sender_output ^ (choice_bits[i] & correlations[i]));
+  }
+}
+
+class SilentOtFlavorTest : public OtFlavorTest {
+ protected:
+  void SetUp() override {
+    OtFlavorTest::SetUp();
+    for (auto& ot_provider_wrapper : ot_provider_wrappers_) {
+      ot_provider_wrapper->SetOtBackend(encrypto::motion::OtBackend::kSilentOt);
+    }
+  }
+};
+
+TEST_F(SilentOtFlavorTest, FixedXcOt128) {
+  constexpr std::size_t kNumberOfOts = 1000;
+  const auto correlation = encrypto::motion::Block128::MakeRandom();
+  const auto choice_bits = encrypto::motion::BitVector<>::SecureRandom(kNumberOfOts);
+  auto ot_sender = GetSenderProvider().RegisterSendFixedXcOt128(kNumberOfOts);
+  auto ot_receiver = GetReceiverProvider().RegisterReceiveFixedXcOt128(kNumberOfOts);
+
+  RunOtExtensionSetup();
+
+  ot_sender->SetCorrelation(correlation);
+  ot_sender->SendMessages();
+
+  ot_receiver->SetChoices(choice_bits);
+  ot_receiver->SendCorrections();
+
+  ot_sender->ComputeOutputs();
+  ot_receiver->ComputeOutputs();
+  const auto sender_output = ot_sender->GetOutputs();
+  const auto receiver_output = ot_receiver->GetOutputs();
+
+  for (std::size_t ot_i = 0; ot_i < kNumberOfOts; ++ot_i) {
+    if (choice_bits.Get(ot_i)) {
+      ASSERT_EQ(receiver_output[ot_i], sender_output[ot_i] ^ correlation);
+    } else {
+      ASSERT_EQ(receiver_output[ot_i], sender_output[ot_i]);
+    }
+  }
+}
+
+TEST_F(SilentOtFlavorTest, XcOtBitAcrossIterations) {
+  // the second batch needs more than one iteration of the silent OT expansion
+  constexpr std::array<std::size_t, 2> kNumberOfOts{
+      100, encrypto::motion::kSilentOtNumberOfOutputs + 1000};
+  std::vector<encrypto::motion::BitVector<>> correlations, choice_bits;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitSender>> ot_senders;
+  std::vector<std::unique_ptr<encrypto::motion::XcOtBitReceiver>> ot_receivers;
+  for (const auto number_of_ots : kNumberOfOts) {
+    correlations.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    choice_bits.emplace_back(encrypto::motion::BitVector<>::SecureRandom(number_of_ots));
+    ot_senders.emplace_back(GetSenderProvider().RegisterSendXcOtBit(number_of_ots));
+    ot_receivers.emplace_back(GetReceiverProvider().RegisterReceiveXcOtBit(number_of_ots));
+  }
+
+  RunOtExtensionSetup();
+
+  for (std::size_t i = 0; i < kNumberOfOts.size(); ++i) {
+    ot_senders[i]->SetCorrelations(correlations[i]);
+    ot_senders[i]->SendMessages();
+
+    ot_receivers[i]->SetChoices(choice_bits[i]);
+    ot_receivers[i]->SendCorrections();
+
+    ot_senders[i]->ComputeOutputs();
+    ot_receivers[i]->ComputeOutputs();
+    const auto sender_output = ot_senders[i]->GetOutputs();
+    const auto receiver_output = ot_receivers[i]->GetOutputs();
+
+    ASSERT_EQ(receiver_output, sender_output ^ (choice_bits[i] & correlations[i]));
+  }
+}
+
+TEST_F(SilentOtFlavorTest, GOt128) {
+  constexpr std::size_t kNumberOfOts = 1000;
+  const auto sender_input = encrypto::motion::Block128Vector::MakeRandom(2 * kNumberOfOts);
+  const auto choice_bits = encrypto::motion::BitVector<>::SecureRandom(kNumberOfOts);
+  auto ot_sender = GetSenderProvider().RegisterSendGOt128(kNumberOfOts);
+  auto ot_receiver = GetReceiverProvider().RegisterReceiveGOt128(kNumberOfOts);
+
+  RunOtExtensionSetup();
+
+  ot_receiver->SetChoices(choice_bits);
+  ot_receiver->SendCorrections();
+
+  ot_sender->SetInputs(sender_input);
+  ot_sender->SendMessages();
+
+  ot_receiver->ComputeOutputs();
+  const auto receiver_output = ot_receiver->GetOutputs();
+
+  for (std::size_t ot_i = 0; ot_i < kNumberOfOts; ++ot_i) {
+    if (choice_bits.Get(ot_i)) {
+      ASSERT_EQ(receiver_output[ot_i], sender_input[2 * ot_i + 1]);
+    } else {
+      ASSERT_EQ(receiver_output[ot_i], sender_input[2 * ot_i]);
+    }
+  }
+}
+
 template <typename T>
 class AcOtTest : public OtFlavorTest {
   using is_enabled_t_ = encrypto::motion::IsUnsignedInt<T>;
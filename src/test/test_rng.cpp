@@ -20,11 +20,15 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <numeric>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "test_constants.h"
 
 #include "primitives/random/aes128_ctr_rng.h"
+#include "primitives/sharing_randomness_generator.h"
 
 // Test vectors from NIST FIPS 197, Appendix A
 
@@ -53,3 +57,32 @@ TEST(Aes128CtrRng, NoTrivialOutput) {
   rngt.RandomBlocksAligned(output_1.data(), 10);
   EXPECT_NE(output_0, output_1);
 }
+
+TEST(SharingRandomnessGenerator, FillUnsigned) {
+  using encrypto::motion::primitives::SharingRandomnessGenerator;
+  std::array<std::uint8_t, SharingRandomnessGenerator::kMasterSeedByteLength> seed;
+  std::iota(std::begin(seed), std::end(seed), 0);
+  SharingRandomnessGenerator my_generator(0), their_generator(1);
+  my_generator.Initialize(seed.data());
+  their_generator.Initialize(seed.data());
+
+  constexpr std::size_t kNumberOfValues = 100, kSplit = 37, kSharingId = 3;
+  std::vector<std::uint32_t> values_0(kNumberOfValues), values_1(kNumberOfValues);
+  my_generator.FillUnsigned<std::uint32_t>(kSharingId, std::span(values_0));
+  // the values do not depend on how the range is split or on the alignment of the output
+  their_generator.FillUnsigned<std::uint32_t>(kSharingId, std::span(values_1).first(kSplit));
+  their_generator.FillUnsigned<std::uint32_t>(kSharingId + kSplit,
+                                              std::span(values_1).subspan(kSplit));
+  EXPECT_EQ(values_0, values_1);
+
+  // different sharing ids result in different values
+  their_generator.FillUnsigned<std::uint32_t>(kSharingId + 1, std::span(values_1));
+  EXPECT_NE(values_0, values_1);
+
+  // the same sharing ids for a different type result in different values
+  std::vector<std::uint64_t> values_2(kNumberOfValues);
+  my_generator.FillUnsigned<std::uint64_t>(kSharingId, std::span(values_2));
+  for (auto i = 0ull; i < kNumberOfValues; ++i) {
+    EXPECT_NE(static_cast<std::uint32_t>(values_2.at(i)), values_0.at(i));
+  }
+}
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <future>
 
 #include "communication/tcp_transport.h"
@@ -56,5 +58,59 @@ TEST_P(TcpTransportTest, dummy) {
   EXPECT_EQ(ReceivedMessage, message);
 }
 
+TEST_P(TcpTransportTest, ReceiveMessageViews) {
+  auto localhost = GetParam();
+  auto transport_alice_future = std::async(std::launch::async, [localhost] {
+    encrypto::motion::communication::TcpSetupHelper helper(
+        0, {{localhost, 13337}, {localhost, 13338}});
+    auto transports = helper.SetupConnections();
+    return std::move(transports.at(1));
+  });
+  auto transport_bob_future = std::async(std::launch::async, [localhost] {
+    encrypto::motion::communication::TcpSetupHelper helper(
+        1, {{localhost, 13337}, {localhost, 13338}});
+    auto transports = helper.SetupConnections();
+    return std::move(transports.at(0));
+  });
+  auto transport_alice = transport_alice_future.get();
+  auto transport_bob = transport_bob_future.get();
+
+  // enough small messages to fill several receive slabs and some larger than a slab, none of whose
+  // sizes is a multiple of 8
+  std::vector<std::vector<std::uint8_t>> messages;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    std::size_t message_size = i % 100 == 0 ? 100001 : i % 10 == 5 ? 5001 : 1 + (i * 8) % 1000;
+    messages.emplace_back(message_size, static_cast<std::uint8_t>(i));
+  }
+  std::vector<const std::vector<std::uint8_t>*> message_pointers;
+  for (const auto& message : messages) {
+    message_pointers.emplace_back(&message);
+  }
+  auto send_future = std::async(std::launch::async, [&transport_alice, &message_pointers] {
+    transport_alice->SendMessages(message_pointers);
+  });
+
+  // all views have to stay valid while further messages are received
+  std::vector<encrypto::motion::communication::MessageView> received_messages;
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    auto received_message = transport_bob->ReceiveMessageView();
+    ASSERT_TRUE(received_message.has_value());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(received_message->data()) % 8, 0);
+    received_messages.emplace_back(std::move(*received_message));
+  }
+  send_future.get();
+  // small messages are not copied out of the slab, the second one directly follows the first one's
+  // padding and the frame header
+  EXPECT_EQ(received_messages.at(2).data(), received_messages.at(1).data() + 16 + 8);
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_TRUE(std::equal(messages.at(i).begin(), messages.at(i).end(),
+                           received_messages.at(i).data(),
+                           received_messages.at(i).data() + received_messages.at(i).size()));
+    EXPECT_EQ(std::move(received_messages.at(i)).ToVector(), messages.at(i));
+  }
+  EXPECT_EQ(transport_alice->GetStatistics().number_of_write_operations, 1);
+  EXPECT_LT(transport_bob->GetStatistics().number_of_read_operations, messages.size());
+}
+
 INSTANTIATE_TEST_SUITE_P(TcpTransportSuite, TcpTransportTest, testing::Values("127.0.0.1", "::1"),
                          [](auto& info) { return info.param == "::1" ? "ipv6" : "ipv4"; });